@@ -0,0 +1,217 @@
+/**
+ * @file bench.c
+ * @brief Minimal benchmark harness implementation
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifndef BOND_BENCH_BUILD_TYPE
+#define BOND_BENCH_BUILD_TYPE ""
+#endif
+
+#define MAX_REPETITIONS 100
+
+volatile uint64_t bench_sink;
+
+uint64_t bench_now_ns(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// ============================================================================
+// Options
+// ============================================================================
+
+void bench_options_init(bench_options *options)
+{
+    options->filter = NULL;
+    options->min_time = 0.2;
+    options->repetitions = 5;
+    options->json = false;
+    options->list = false;
+}
+
+bool bench_parse_option(const char *arg, bench_options *options)
+{
+    if (strncmp(arg, "--filter=", 9) == 0)
+    {
+        options->filter = arg + 9;
+        return true;
+    }
+    if (strncmp(arg, "--min-time=", 11) == 0)
+    {
+        options->min_time = atof(arg + 11);
+        return options->min_time > 0;
+    }
+    if (strncmp(arg, "--repetitions=", 14) == 0)
+    {
+        long repetitions = atol(arg + 14);
+        options->repetitions = (uint32_t)repetitions;
+        return repetitions > 0 && repetitions <= MAX_REPETITIONS;
+    }
+    if (strcmp(arg, "--json") == 0)
+    {
+        options->json = true;
+        return true;
+    }
+    if (strcmp(arg, "--list") == 0)
+    {
+        options->list = true;
+        return true;
+    }
+    return false;
+}
+
+void bench_print_usage(void)
+{
+    fprintf(stderr,
+            "  --filter=TEXT      Only run benchmarks whose name contains TEXT\n"
+            "  --min-time=SEC     Minimum time per repetition (default 0.2)\n"
+            "  --repetitions=N    Timed repetitions per benchmark (default 5)\n"
+            "  --json             Print results as JSON\n"
+            "  --list             Print benchmark names and exit\n");
+}
+
+// ============================================================================
+// Running
+// ============================================================================
+
+typedef struct {
+    uint64_t iterations;
+    double bytes_per_op;
+    double samples[MAX_REPETITIONS];    // ns/op of each repetition
+    double ns_per_op;                   // Median of samples
+} bench_result;
+
+static double time_batch(const bench_case *c, uint64_t iterations, double *bytes_per_op)
+{
+    if (c->prepare != NULL)
+    {
+        c->prepare(c->ctx);
+    }
+    uint64_t start = bench_now_ns();
+    *bytes_per_op = c->fn(c->ctx, iterations);
+    return (double)(bench_now_ns() - start) * 1e-9;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_case(const bench_case *c, const bench_options *options, bench_result *result)
+{
+    // Grow the batch until it is long enough to time, then scale it to
+    // the requested duration
+    uint64_t iterations = 1;
+    double elapsed = time_batch(c, iterations, &result->bytes_per_op);
+    while (elapsed < options->min_time / 10 && iterations < (UINT64_C(1) << 40))
+    {
+        iterations *= elapsed > 0 && options->min_time / elapsed < 100 ? 2 : 10;
+        elapsed = time_batch(c, iterations, &result->bytes_per_op);
+    }
+    if (elapsed > 0 && elapsed < options->min_time)
+    {
+        iterations = (uint64_t)((double)iterations * options->min_time / elapsed) + 1;
+    }
+
+    double sorted[MAX_REPETITIONS];
+    for (uint32_t i = 0; i < options->repetitions; i++)
+    {
+        elapsed = time_batch(c, iterations, &result->bytes_per_op);
+        result->samples[i] = elapsed * 1e9 / (double)iterations;
+        sorted[i] = result->samples[i];
+    }
+    qsort(sorted, options->repetitions, sizeof(double), compare_double);
+    uint32_t mid = options->repetitions / 2;
+    result->ns_per_op = (options->repetitions % 2)
+        ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+    result->iterations = iterations;
+}
+
+static double mb_per_s(const bench_result *result)
+{
+    // bytes/ns * 1e9 / 1e6
+    return result->ns_per_op > 0 ? result->bytes_per_op * 1e3 / result->ns_per_op : 0;
+}
+
+int bench_run(const char *suite, const bench_case *cases, size_t count,
+              const bench_options *options)
+{
+    if (options->json)
+    {
+        printf("{\"suite\": \"%s\", \"build_type\": \"%s\", \"repetitions\": %u, \"benchmarks\": [",
+               suite, BOND_BENCH_BUILD_TYPE, options->repetitions);
+    }
+
+    bool first = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        const bench_case *c = &cases[i];
+        if (options->filter != NULL && strstr(c->name, options->filter) == NULL)
+        {
+            continue;
+        }
+        if (options->list)
+        {
+            printf("%s\n", c->name);
+            continue;
+        }
+
+        bench_result result;
+        run_case(c, options, &result);
+        if (options->json)
+        {
+            printf("%s\n  {\"name\": \"%s\", \"iterations\": %llu, \"bytes_per_op\": %.1f, "
+                   "\"ns_per_op\": %.3f, \"mb_per_s\": %.1f, \"samples_ns_per_op\": [",
+                   first ? "" : ",", c->name, (unsigned long long)result.iterations,
+                   result.bytes_per_op, result.ns_per_op, mb_per_s(&result));
+            for (uint32_t r = 0; r < options->repetitions; r++)
+            {
+                printf("%s%.3f", r > 0 ? ", " : "", result.samples[r]);
+            }
+            printf("]}");
+        }
+        else if (result.bytes_per_op > 0)
+        {
+            printf("%-44s %12.2f ns/op %10.1f MB/s\n", c->name, result.ns_per_op, mb_per_s(&result));
+        }
+        else
+        {
+            printf("%-44s %12.2f ns/op\n", c->name, result.ns_per_op);
+        }
+        fflush(stdout);
+        first = false;
+    }
+
+    if (options->json)
+    {
+        printf("\n]}\n");
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file bench.h
+ * @brief Minimal benchmark harness shared by the benchmark programs
+ *
+ * Each case runs a batch of operations per call. The harness grows the
+ * batch until one call takes the minimum time, repeats it, and reports the
+ * median as ns/op and MB/s, either as a table or as JSON:
+ *
+ *   {"suite": "bond_bench", "build_type": "Release", "benchmarks": [
+ *     {"name": "varint32/encode/small", "iterations": 16777216,
+ *      "bytes_per_op": 1.0, "ns_per_op": 1.9, "mb_per_s": 502.1,
+ *      "samples_ns_per_op": [1.9, 1.9, 2.0, 1.9, 1.9]}, ...]}
+ */
+
+#ifndef BOND_BENCH_H
+#define BOND_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Run `iterations` operations
+ *
+ * @param ctx  Fixture passed through from the case
+ * @return Bytes processed per operation (0 if throughput does not apply)
+ */
+typedef double (*bench_fn)(void *ctx, uint64_t iterations);
+
+typedef struct {
+    const char *name;       // "group/operation/variant"
+    bench_fn fn;
+    void *ctx;
+    void (*prepare)(void *ctx);     // Untimed, before every batch (optional)
+} bench_case;
+
+typedef struct {
+    const char *filter;     // Only run cases whose name contains this
+    double min_time;        // Seconds per repetition
+    uint32_t repetitions;   // Timed repetitions per case
+    bool json;              // JSON instead of a table
+    bool list;              // Print case names only
+} bench_options;
+
+/**
+ * Sink for results so the compiler cannot drop the measured work
+ */
+extern volatile uint64_t bench_sink;
+
+/**
+ * Monotonic clock in nanoseconds
+ */
+uint64_t bench_now_ns(void);
+
+void bench_options_init(bench_options *options);
+
+/**
+ * Apply one harness option: --filter=, --min-time=, --repetitions=, --json
+ * or --list
+ *
+ * @return false if `arg` is not a harness option or its value is invalid
+ */
+bool bench_parse_option(const char *arg, bench_options *options);
+
+/**
+ * Usage lines for the harness options
+ */
+void bench_print_usage(void);
+
+/**
+ * Run the matching cases and print results to stdout
+ *
+ * @return 0 on success
+ */
+int bench_run(const char *suite, const bench_case *cases, size_t count,
+              const bench_options *options);
+
+#endif // BOND_BENCH_H
@@ -0,0 +1,490 @@
+/**
+ * @file bench_compare.c
+ * @brief Benchmark regression gate
+ *
+ * Usage: bond_bench_compare [options] -- BENCHMARK [ARGS...]
+ *
+ * Runs BENCHMARK --json N times, pools the per-repetition samples of each
+ * case, and reports the median ns/op with a 95% confidence interval. With
+ * --baseline=FILE each case is compared against the checked-in numbers and
+ * the run fails when throughput drops by more than the threshold and the
+ * two confidence intervals do not overlap. --write-baseline=FILE stores the
+ * current numbers as the new baseline:
+ *
+ *   {"suite": "bond_bench", "runs": 5, "benchmarks": [
+ *     {"name": "varint32/encode/small", "bytes_per_op": 1.0,
+ *      "ns_per_op": 1.93, "ci_low_ns": 1.91, "ci_high_ns": 1.95}, ...]}
+ *
+ * Exit status: 0 no regressions, 1 regressions found, 2 usage or run error.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#define MAX_BENCHMARKS 512
+#define MAX_NAME 64
+#define MAX_COMMAND 4096
+
+typedef struct {
+    char name[MAX_NAME];
+    double bytes_per_op;
+    double *samples;            // ns/op, pooled over all runs
+    size_t sample_count;
+    size_t sample_capacity;
+    double ns_per_op;           // Median of samples
+    double ci_low_ns;           // 95% confidence interval of the median
+    double ci_high_ns;
+} bench_stats;
+
+typedef struct {
+    char suite[MAX_NAME];
+    bench_stats entries[MAX_BENCHMARKS];
+    size_t count;
+} bench_table;
+
+// ============================================================================
+// JSON Scanning
+// ============================================================================
+//
+// Only the flat object layout written by the harness and by this tool is
+// understood: one object per benchmark, no nested objects.
+
+static char *read_stream(FILE *file)
+{
+    size_t size = 0;
+    size_t capacity = 1 << 16;
+    char *text = (char *)malloc(capacity);
+    while (text != NULL)
+    {
+        size_t n = fread(text + size, 1, capacity - size - 1, file);
+        size += n;
+        if (n == 0)
+        {
+            text[size] = '\0';
+            return text;
+        }
+        if (size + 1 == capacity)
+        {
+            char *grown = (char *)realloc(text, capacity * 2);
+            if (grown == NULL)
+            {
+                free(text);
+                return NULL;
+            }
+            text = grown;
+            capacity *= 2;
+        }
+    }
+    return NULL;
+}
+
+// Value of "key" within [p, end), or NULL
+static const char *find_key(const char *p, const char *end, const char *key)
+{
+    size_t len = strlen(key);
+    for (; p + len + 2 < end; p++)
+    {
+        if (p[0] == '"' && strncmp(p + 1, key, len) == 0 && p[len + 1] == '"')
+        {
+            p += len + 2;
+            while (p < end && (*p == ' ' || *p == ':'))
+            {
+                p++;
+            }
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static bool scan_string(const char *p, char *out, size_t size)
+{
+    if (p == NULL || *p != '"')
+    {
+        return false;
+    }
+    const char *close = strchr(p + 1, '"');
+    if (close == NULL || (size_t)(close - p - 1) >= size)
+    {
+        return false;
+    }
+    memcpy(out, p + 1, (size_t)(close - p - 1));
+    out[close - p - 1] = '\0';
+    return true;
+}
+
+static bool scan_number(const char *p, double *value)
+{
+    char *end;
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = strtod(p, &end);
+    return end != p;
+}
+
+static bool add_sample(bench_stats *stats, double sample)
+{
+    if (stats->sample_count == stats->sample_capacity)
+    {
+        size_t capacity = stats->sample_capacity ? stats->sample_capacity * 2 : 16;
+        double *grown = (double *)realloc(stats->samples, capacity * sizeof(double));
+        if (grown == NULL)
+        {
+            return false;
+        }
+        stats->samples = grown;
+        stats->sample_capacity = capacity;
+    }
+    stats->samples[stats->sample_count++] = sample;
+    return true;
+}
+
+static bench_stats *find_entry(bench_table *table, const char *name, bool create)
+{
+    for (size_t i = 0; i < table->count; i++)
+    {
+        if (strcmp(table->entries[i].name, name) == 0)
+        {
+            return &table->entries[i];
+        }
+    }
+    if (!create || table->count == MAX_BENCHMARKS)
+    {
+        return NULL;
+    }
+    bench_stats *stats = &table->entries[table->count++];
+    memset(stats, 0, sizeof(*stats));
+    strcpy(stats->name, name);
+    return stats;
+}
+
+/**
+ * Merge one JSON document into the table
+ *
+ * Harness output contributes its samples_ns_per_op; a baseline contributes
+ * its stored median and interval.
+ */
+static bool parse_results(const char *text, bench_table *table)
+{
+    const char *end = text + strlen(text);
+    scan_string(find_key(text, end, "suite"), table->suite, sizeof(table->suite));
+    const char *p = find_key(text, end, "benchmarks");
+    if (p == NULL)
+    {
+        return false;
+    }
+
+    while ((p = strchr(p, '{')) != NULL)
+    {
+        const char *close = strchr(p, '}');
+        if (close == NULL)
+        {
+            return false;
+        }
+        char name[MAX_NAME];
+        if (!scan_string(find_key(p, close, "name"), name, sizeof(name)))
+        {
+            return false;
+        }
+        bench_stats *stats = find_entry(table, name, true);
+        if (stats == NULL)
+        {
+            return false;
+        }
+        scan_number(find_key(p, close, "bytes_per_op"), &stats->bytes_per_op);
+
+        const char *samples = find_key(p, close, "samples_ns_per_op");
+        if (samples != NULL && *samples == '[')
+        {
+            samples++;
+            while (true)
+            {
+                char *next;
+                double sample = strtod(samples, &next);
+                if (next == samples)
+                {
+                    break;
+                }
+                if (!add_sample(stats, sample))
+                {
+                    return false;
+                }
+                samples = next;
+                while (*samples == ',' || *samples == ' ')
+                {
+                    samples++;
+                }
+            }
+        }
+        else if (!scan_number(find_key(p, close, "ns_per_op"), &stats->ns_per_op) ||
+                 !scan_number(find_key(p, close, "ci_low_ns"), &stats->ci_low_ns) ||
+                 !scan_number(find_key(p, close, "ci_high_ns"), &stats->ci_high_ns))
+        {
+            return false;
+        }
+        p = close + 1;
+    }
+    return true;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Median and a distribution-free 95% confidence interval for it
+ *
+ * The interval bounds are the order statistics at n/2 -/+ 0.98*sqrt(n),
+ * the normal approximation to the binomial, which needs no assumption
+ * about the shape of the timing distribution.
+ */
+static void summarize(bench_stats *stats)
+{
+    size_t n = stats->sample_count;
+    if (n == 0)
+    {
+        return;
+    }
+    qsort(stats->samples, n, sizeof(double), compare_double);
+    stats->ns_per_op = (n % 2) ? stats->samples[n / 2]
+                               : (stats->samples[n / 2 - 1] + stats->samples[n / 2]) / 2;
+    double spread = 0.98 * sqrt((double)n);
+    double low = floor((double)n / 2 - spread);
+    double high = ceil((double)n / 2 + spread);
+    stats->ci_low_ns = stats->samples[low < 0 ? 0 : (size_t)low];
+    stats->ci_high_ns = stats->samples[high > (double)(n - 1) ? n - 1 : (size_t)high];
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static bool write_baseline(const char *path, const bench_table *table, unsigned runs)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+    fprintf(file, "{\"suite\": \"%s\", \"runs\": %u, \"benchmarks\": [", table->suite, runs);
+    for (size_t i = 0; i < table->count; i++)
+    {
+        const bench_stats *s = &table->entries[i];
+        fprintf(file, "%s\n  {\"name\": \"%s\", \"bytes_per_op\": %.1f, \"ns_per_op\": %.3f, "
+                "\"ci_low_ns\": %.3f, \"ci_high_ns\": %.3f}",
+                i > 0 ? "," : "", s->name, s->bytes_per_op, s->ns_per_op,
+                s->ci_low_ns, s->ci_high_ns);
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * Print one line per case and count regressions
+ *
+ * Throughput change is baseline/current - 1, so -10% means 10% slower.
+ * A change only counts when it exceeds the threshold and the confidence
+ * intervals are disjoint.
+ */
+static unsigned report(const bench_table *baseline, const bench_table *current, double threshold)
+{
+    unsigned regressions = 0;
+    printf("%-44s %12s %12s %22s %10s  %s\n",
+           "benchmark", "base ns/op", "ns/op", "95% CI", "throughput", "status");
+    for (size_t i = 0; i < current->count; i++)
+    {
+        const bench_stats *cur = &current->entries[i];
+        const bench_stats *base = find_entry((bench_table *)baseline, cur->name, false);
+        if (base == NULL)
+        {
+            printf("%-44s %12s %12.2f [%9.2f, %9.2f] %10s  new\n",
+                   cur->name, "-", cur->ns_per_op, cur->ci_low_ns, cur->ci_high_ns, "-");
+            continue;
+        }
+        double change = cur->ns_per_op > 0 ? base->ns_per_op / cur->ns_per_op - 1 : 0;
+        const char *status = "ok";
+        if (change < -threshold && cur->ci_low_ns > base->ci_high_ns)
+        {
+            status = "REGRESSION";
+            regressions++;
+        }
+        else if (change > threshold && cur->ci_high_ns < base->ci_low_ns)
+        {
+            status = "improved";
+        }
+        printf("%-44s %12.2f %12.2f [%9.2f, %9.2f] %+9.1f%%  %s\n",
+               cur->name, base->ns_per_op, cur->ns_per_op, cur->ci_low_ns, cur->ci_high_ns,
+               change * 100, status);
+    }
+    for (size_t i = 0; i < baseline->count; i++)
+    {
+        if (find_entry((bench_table *)current, baseline->entries[i].name, false) == NULL)
+        {
+            printf("%-44s %12.2f %12s %22s %10s  missing\n",
+                   baseline->entries[i].name, baseline->entries[i].ns_per_op, "-", "-", "-");
+        }
+    }
+    return regressions;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void print_usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [options] -- BENCHMARK [ARGS...]\n"
+            "  --runs=N              Run the benchmark N times (default 5)\n"
+            "  --baseline=FILE       Compare against FILE\n"
+            "  --threshold=PCT       Allowed throughput drop in percent (default 10)\n"
+            "  --write-baseline=FILE Store the results as a new baseline\n",
+            program);
+}
+
+static void free_table(bench_table *table)
+{
+    for (size_t i = 0; i < table->count; i++)
+    {
+        free(table->entries[i].samples);
+    }
+}
+
+static bool append_arg(char *command, const char *arg)
+{
+    size_t len = strlen(command);
+    if (len + strlen(arg) + 4 >= MAX_COMMAND || strchr(arg, '"') != NULL)
+    {
+        return false;
+    }
+    sprintf(command + len, "%s\"%s\"", len > 0 ? " " : "", arg);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned runs = 5;
+    double threshold = 10;
+    const char *baseline_path = NULL;
+    const char *output_path = NULL;
+    char command[MAX_COMMAND] = "";
+
+    int i = 1;
+    for (; i < argc && strcmp(argv[i], "--") != 0; i++)
+    {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--runs=", 7) == 0 && atoi(arg + 7) > 0)
+        {
+            runs = (unsigned)atoi(arg + 7);
+        }
+        else if (strncmp(arg, "--baseline=", 11) == 0)
+        {
+            baseline_path = arg + 11;
+        }
+        else if (strncmp(arg, "--threshold=", 12) == 0 && atof(arg + 12) > 0)
+        {
+            threshold = atof(arg + 12);
+        }
+        else if (strncmp(arg, "--write-baseline=", 17) == 0)
+        {
+            output_path = arg + 17;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    for (i++; i < argc; i++)
+    {
+        if (!append_arg(command, argv[i]))
+        {
+            fprintf(stderr, "benchmark command too long or contains quotes\n");
+            return 2;
+        }
+    }
+    if (command[0] == '\0' || (baseline_path == NULL && output_path == NULL) ||
+        !append_arg(command, "--json"))
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    static bench_table baseline;
+    static bench_table current;
+    if (baseline_path != NULL)
+    {
+        FILE *file = fopen(baseline_path, "r");
+        char *text = file != NULL ? read_stream(file) : NULL;
+        if (file != NULL)
+        {
+            fclose(file);
+        }
+        if (text == NULL || !parse_results(text, &baseline))
+        {
+            fprintf(stderr, "cannot read baseline %s\n", baseline_path);
+            free(text);
+            return 2;
+        }
+        free(text);
+    }
+
+    for (unsigned run = 0; run < runs; run++)
+    {
+        fprintf(stderr, "run %u/%u: %s\n", run + 1, runs, command);
+        FILE *pipe = popen(command, "r");
+        char *text = pipe != NULL ? read_stream(pipe) : NULL;
+        int status = pipe != NULL ? pclose(pipe) : -1;
+        if (text == NULL || status != 0 || !parse_results(text, &current))
+        {
+            fprintf(stderr, "benchmark run failed\n");
+            free(text);
+            free_table(&current);
+            return 2;
+        }
+        free(text);
+    }
+    for (size_t e = 0; e < current.count; e++)
+    {
+        summarize(&current.entries[e]);
+    }
+
+    int result = 0;
+    if (baseline_path != NULL)
+    {
+        unsigned regressions = report(&baseline, &current, threshold / 100);
+        if (regressions > 0)
+        {
+            printf("\n%u benchmark(s) regressed by more than %.1f%%\n", regressions, threshold);
+            result = 1;
+        }
+    }
+    if (output_path != NULL && !write_baseline(output_path, &current, runs))
+    {
+        fprintf(stderr, "cannot write baseline %s\n", output_path);
+        result = 2;
+    }
+    free_table(&current);
+    return result;
+}
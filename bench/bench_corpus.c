@@ -0,0 +1,859 @@
+/**
+ * @file bench_corpus.c
+ * @brief Deterministic macro-benchmark corpus generator
+ */
+
+#include "bench_corpus.h"
+#include "bond_types.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Models
+// ============================================================================
+//
+// Records refer to strings by offset into the string pool and to element
+// arrays by index into the typed pools, so a whole corpus is a handful of
+// large allocations.
+
+typedef struct {
+    uint32_t street;            // String offset
+    uint32_t city;              // String offset
+    uint32_t zip;
+} corpus_address;
+
+// struct TelemetryEvent {
+//     0: uint64 timestamp; 1: string device_id; 2: EventType event_type;
+//     3: double value; 4: map<string, string> tags; 5: list<float> samples; }
+typedef struct {
+    uint64_t timestamp;
+    uint32_t device_id;         // String offset
+    int32_t event_type;
+    double value;
+    uint32_t tags;              // First key of tag_count key/value string refs
+    uint32_t tag_count;
+    uint32_t samples;           // First float
+    uint32_t sample_count;
+} corpus_telemetry;
+
+// struct Company {
+//     1: string name; 2: Address headquarters; 3: list<string> departments;
+//     4: list<Address> offices; 5: uint16 founded; }
+typedef struct {
+    uint32_t name;              // String offset
+    corpus_address headquarters;
+    uint32_t departments;       // First string ref
+    uint32_t department_count;
+    uint32_t offices;           // First address
+    uint32_t office_count;
+    uint16_t founded;
+} corpus_company;
+
+// 240 fields cycling through six types; zero-valued fields are omitted
+#define WIDE_FIELDS 240
+
+typedef struct {
+    uint64_t values[WIDE_FIELDS];   // Integers, double bits or string offsets
+} corpus_wide;
+
+// struct NumericSeries { 0: list<int64> counters; 1: list<double> gauges; }
+typedef struct {
+    uint32_t ints;
+    uint32_t int_count;
+    uint32_t doubles;
+    uint32_t double_count;
+} corpus_numeric;
+
+// struct StringMap { 0: string name; 1: map<string, string> entries; }
+typedef struct {
+    uint32_t name;              // String offset
+    uint32_t entries;           // First key of count key/value string refs
+    uint32_t count;
+} corpus_string_map;
+
+typedef struct {
+    bond_buffer strings;        // NUL-terminated strings
+    uint32_t *string_refs;      // Offsets into strings, for lists and maps
+    size_t string_ref_count;
+    size_t string_ref_capacity;
+    float *floats;
+    size_t float_count;
+    size_t float_capacity;
+    int64_t *ints;
+    size_t int_count;
+    size_t int_capacity;
+    double *doubles;
+    size_t double_count;
+    size_t double_capacity;
+    corpus_address *addresses;
+    size_t address_count;
+    size_t address_capacity;
+    double *scratch;            // Decode target for the largest double list
+    size_t scratch_capacity;
+} corpus_pools;
+
+// ============================================================================
+// Generation Helpers
+// ============================================================================
+
+typedef struct {
+    uint64_t rng;
+    const bench_corpus_config *config;
+    corpus_pools *pools;
+    bool failed;
+} generator;
+
+static uint64_t next_random(generator *g)
+{
+    // xorshift64*
+    g->rng ^= g->rng >> 12;
+    g->rng ^= g->rng << 25;
+    g->rng ^= g->rng >> 27;
+    return g->rng * 0x2545F4914F6CDD1Dull;
+}
+
+static uint32_t random_size(generator *g, const bench_size_dist *dist)
+{
+    if (dist->max <= dist->min)
+    {
+        return dist->min;
+    }
+    if (dist->log_uniform)
+    {
+        double lo = log((double)dist->min + 1);
+        double hi = log((double)dist->max + 1);
+        double unit = (double)(next_random(g) >> 11) / 9007199254740992.0;
+        uint32_t size = (uint32_t)(exp(lo + (hi - lo) * unit) - 1);
+        return size < dist->min ? dist->min : (size > dist->max ? dist->max : size);
+    }
+    return dist->min + (uint32_t)(next_random(g) % ((uint64_t)dist->max - dist->min + 1));
+}
+
+// Grow a pool array to hold `needed` elements
+static bool pool_reserve(generator *g, void **data, size_t *capacity, size_t needed,
+                         size_t element_size)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+    size_t new_capacity = *capacity ? *capacity : 1024;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2;
+    }
+    void *grown = realloc(*data, new_capacity * element_size);
+    if (grown == NULL)
+    {
+        g->failed = true;
+        return false;
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+// Random lowercase text with a length drawn from the string distribution
+static uint32_t add_string(generator *g)
+{
+    bond_buffer *strings = &g->pools->strings;
+    uint32_t len = random_size(g, &g->config->string_length);
+    size_t offset = strings->size;
+    if (offset + len + 1 > UINT32_MAX || bond_buffer_reserve(strings, len + 1) != 0)
+    {
+        g->failed = true;
+        return 0;
+    }
+    for (uint32_t i = 0; i < len; i++)
+    {
+        strings->data[offset + i] = (uint8_t)('a' + next_random(g) % 26);
+    }
+    strings->data[offset + len] = '\0';
+    strings->size += len + 1;
+    return (uint32_t)offset;
+}
+
+// `count` string refs in a row (map entries are key, value pairs)
+static uint32_t add_string_refs(generator *g, uint32_t count)
+{
+    corpus_pools *p = g->pools;
+    size_t first = p->string_ref_count;
+    if (!pool_reserve(g, (void **)&p->string_refs, &p->string_ref_capacity,
+                      first + count, sizeof(uint32_t)))
+    {
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p->string_refs[first + i] = add_string(g);
+    }
+    p->string_ref_count += count;
+    return (uint32_t)first;
+}
+
+static void random_address(generator *g, corpus_address *address)
+{
+    address->street = add_string(g);
+    address->city = add_string(g);
+    address->zip = (uint32_t)(10000 + next_random(g) % 90000);
+}
+
+static const char *pool_string(const corpus_pools *pools, uint32_t offset)
+{
+    return (const char *)pools->strings.data + offset;
+}
+
+// ============================================================================
+// Record Generators
+// ============================================================================
+
+static void generate_telemetry(generator *g, corpus_telemetry *event, uint32_t index)
+{
+    corpus_pools *p = g->pools;
+    event->timestamp = UINT64_C(1700000000000) + (uint64_t)index * 17 + next_random(g) % 17;
+    event->device_id = add_string(g);
+    event->event_type = (int32_t)(next_random(g) % 8);
+    event->value = (double)(int64_t)(next_random(g) % 2000000 - 1000000) / 1000.0;
+    event->tag_count = random_size(g, &g->config->list_length) / 2;
+    event->tags = add_string_refs(g, event->tag_count * 2);
+
+    event->sample_count = random_size(g, &g->config->list_length);
+    event->samples = (uint32_t)p->float_count;
+    if (pool_reserve(g, (void **)&p->floats, &p->float_capacity,
+                     p->float_count + event->sample_count, sizeof(float)))
+    {
+        for (uint32_t i = 0; i < event->sample_count; i++)
+        {
+            p->floats[p->float_count++] = (float)(next_random(g) % 100000) / 100.0f;
+        }
+    }
+}
+
+static void generate_company(generator *g, corpus_company *company)
+{
+    corpus_pools *p = g->pools;
+    company->name = add_string(g);
+    random_address(g, &company->headquarters);
+    company->department_count = random_size(g, &g->config->list_length);
+    company->departments = add_string_refs(g, company->department_count);
+
+    company->office_count = random_size(g, &g->config->list_length);
+    company->offices = (uint32_t)p->address_count;
+    if (pool_reserve(g, (void **)&p->addresses, &p->address_capacity,
+                     p->address_count + company->office_count, sizeof(corpus_address)))
+    {
+        for (uint32_t i = 0; i < company->office_count; i++)
+        {
+            random_address(g, &p->addresses[p->address_count++]);
+        }
+    }
+    company->founded = (uint16_t)(1850 + next_random(g) % 175);
+}
+
+static uint16_t wide_field_id(uint32_t i)
+{
+    // Inline ids, then 1-byte escapes, then a tail of 2-byte escapes
+    return (uint16_t)(i < 200 ? i : 300 + i * 50);
+}
+
+static void generate_wide(generator *g, corpus_wide *wide)
+{
+    for (uint32_t i = 0; i < WIDE_FIELDS; i++)
+    {
+        uint64_t r = next_random(g);
+        if (r % 3 == 0)
+        {
+            wide->values[i] = 0;
+            continue;
+        }
+        switch (i % 6)
+        {
+            case 0: wide->values[i] = r % 1000; break;                      // uint32
+            case 1: wide->values[i] = (uint64_t)((int64_t)(r >> 20) - (INT64_C(1) << 42)); break;  // int64
+            case 2:                                                         // double
+            {
+                double d = (double)(r % 1000000) / 7.0;
+                memcpy(&wide->values[i], &d, sizeof(d));
+                break;
+            }
+            case 3: wide->values[i] = add_string(g) + 1; break;             // string (offset + 1)
+            case 4: wide->values[i] = 1; break;                             // bool
+            default: wide->values[i] = r % 65536; break;                    // uint16
+        }
+    }
+}
+
+static void generate_numeric(generator *g, corpus_numeric *numeric)
+{
+    corpus_pools *p = g->pools;
+    numeric->int_count = random_size(g, &g->config->big_list_length);
+    numeric->double_count = random_size(g, &g->config->big_list_length);
+    numeric->ints = (uint32_t)p->int_count;
+    numeric->doubles = (uint32_t)p->double_count;
+    if (!pool_reserve(g, (void **)&p->ints, &p->int_capacity,
+                      p->int_count + numeric->int_count, sizeof(int64_t)) ||
+        !pool_reserve(g, (void **)&p->doubles, &p->double_capacity,
+                      p->double_count + numeric->double_count, sizeof(double)) ||
+        !pool_reserve(g, (void **)&p->scratch, &p->scratch_capacity,
+                      numeric->double_count, sizeof(double)))
+    {
+        return;
+    }
+
+    // Monotonic counters (small deltas) and noisy gauges
+    int64_t counter = (int64_t)(next_random(g) % 1000000);
+    for (uint32_t i = 0; i < numeric->int_count; i++)
+    {
+        counter += (int64_t)(next_random(g) % 100);
+        p->ints[p->int_count++] = counter;
+    }
+    for (uint32_t i = 0; i < numeric->double_count; i++)
+    {
+        p->doubles[p->double_count++] = (double)(next_random(g) % 1000000) * 0.001;
+    }
+}
+
+static void generate_string_map(generator *g, corpus_string_map *map)
+{
+    map->name = add_string(g);
+    map->count = random_size(g, &g->config->map_size);
+    map->entries = add_string_refs(g, map->count * 2);
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static void encode_address(const corpus_pools *p, const corpus_address *address,
+                           bond_writer *writer)
+{
+    bond_writer_write_string(writer, 1, pool_string(p, address->street));
+    bond_writer_write_string(writer, 2, pool_string(p, address->city));
+    bond_writer_write_uint32(writer, 3, address->zip);
+    bond_writer_struct_end(writer);
+}
+
+void bench_corpus_encode(const bench_corpus_set *set, uint32_t index, bond_writer *writer)
+{
+    const corpus_pools *p = (const corpus_pools *)set->pools;
+    switch (set->kind)
+    {
+        case BENCH_CORPUS_TELEMETRY:
+        {
+            const corpus_telemetry *e = (const corpus_telemetry *)set->records + index;
+            bond_writer_write_uint64(writer, 0, e->timestamp);
+            bond_writer_write_string(writer, 1, pool_string(p, e->device_id));
+            bond_writer_write_int32(writer, 2, e->event_type);
+            bond_writer_write_double(writer, 3, e->value);
+            bond_writer_write_map_begin(writer, 4, BOND_TYPE_STRING, BOND_TYPE_STRING, e->tag_count);
+            for (uint32_t i = 0; i < e->tag_count * 2; i++)
+            {
+                bond_writer_write_string_value(writer, pool_string(p, p->string_refs[e->tags + i]));
+            }
+            bond_writer_write_float_list(writer, 5, p->floats + e->samples, e->sample_count);
+            break;
+        }
+
+        case BENCH_CORPUS_COMPANY:
+        {
+            const corpus_company *c = (const corpus_company *)set->records + index;
+            bond_writer_write_string(writer, 1, pool_string(p, c->name));
+            bond_writer_write_field_header(writer, 2, BOND_TYPE_STRUCT);
+            encode_address(p, &c->headquarters, writer);
+            bond_writer_write_list_begin(writer, 3, BOND_TYPE_STRING, c->department_count);
+            for (uint32_t i = 0; i < c->department_count; i++)
+            {
+                bond_writer_write_string_value(writer, pool_string(p, p->string_refs[c->departments + i]));
+            }
+            bond_writer_write_list_begin(writer, 4, BOND_TYPE_STRUCT, c->office_count);
+            for (uint32_t i = 0; i < c->office_count; i++)
+            {
+                encode_address(p, &p->addresses[c->offices + i], writer);
+            }
+            bond_writer_write_uint16(writer, 5, c->founded);
+            break;
+        }
+
+        case BENCH_CORPUS_WIDE:
+        {
+            const corpus_wide *w = (const corpus_wide *)set->records + index;
+            for (uint32_t i = 0; i < WIDE_FIELDS; i++)
+            {
+                uint64_t v = w->values[i];
+                uint16_t id = wide_field_id(i);
+                if (v == 0)
+                {
+                    continue;
+                }
+                switch (i % 6)
+                {
+                    case 0: bond_writer_write_uint32(writer, id, (uint32_t)v); break;
+                    case 1: bond_writer_write_int64(writer, id, (int64_t)v); break;
+                    case 2:
+                    {
+                        double d;
+                        memcpy(&d, &v, sizeof(d));
+                        bond_writer_write_double(writer, id, d);
+                        break;
+                    }
+                    case 3: bond_writer_write_string(writer, id, pool_string(p, (uint32_t)(v - 1))); break;
+                    case 4: bond_writer_write_bool(writer, id, true); break;
+                    default: bond_writer_write_uint16(writer, id, (uint16_t)v); break;
+                }
+            }
+            break;
+        }
+
+        case BENCH_CORPUS_NUMERIC:
+        {
+            const corpus_numeric *n = (const corpus_numeric *)set->records + index;
+            bond_writer_write_list_begin(writer, 0, BOND_TYPE_INT64, n->int_count);
+            for (uint32_t i = 0; i < n->int_count; i++)
+            {
+                bond_writer_write_int64_value(writer, p->ints[n->ints + i]);
+            }
+            bond_writer_write_double_list(writer, 1, p->doubles + n->doubles, n->double_count);
+            break;
+        }
+
+        default:
+        {
+            const corpus_string_map *m = (const corpus_string_map *)set->records + index;
+            bond_writer_write_string(writer, 0, pool_string(p, m->name));
+            bond_writer_write_map_begin(writer, 1, BOND_TYPE_STRING, BOND_TYPE_STRING, m->count);
+            for (uint32_t i = 0; i < m->count * 2; i++)
+            {
+                bond_writer_write_string_value(writer, pool_string(p, p->string_refs[m->entries + i]));
+            }
+            break;
+        }
+    }
+    bond_writer_struct_end(writer);
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+static bool decode_string(BondReader *reader, uint64_t *checksum)
+{
+    const char *str;
+    uint32_t len;
+    if (!bond_reader_read_string_value(reader, &str, &len))
+    {
+        return false;
+    }
+    *checksum += len + (len > 0 ? (uint8_t)str[0] : 0);
+    return true;
+}
+
+static bool decode_string_map(BondReader *reader, uint64_t *checksum)
+{
+    uint8_t key_type;
+    uint8_t value_type;
+    uint32_t count;
+    if (!bond_reader_read_map_begin(reader, &key_type, &value_type, &count))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < count * 2; i++)
+    {
+        if (!decode_string(reader, checksum))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool decode_address(BondReader *reader, corpus_address *address, uint64_t *checksum)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(reader, &id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        bool ok;
+        switch (id)
+        {
+            case 1:
+            case 2:
+                ok = decode_string(reader, checksum);
+                break;
+            case 3:
+                ok = bond_reader_read_uint32_value(reader, &address->zip);
+                *checksum += address->zip;
+                break;
+            default:
+                ok = bond_reader_skip(reader, type);
+                break;
+        }
+        if (!ok)
+        {
+            return false;
+        }
+    }
+}
+
+static bool decode_field(const bench_corpus_set *set, BondReader *reader, uint16_t id,
+                         uint8_t type, uint64_t *checksum)
+{
+    corpus_pools *p = (corpus_pools *)set->pools;
+    uint8_t element_type;
+    uint32_t count;
+
+    switch (set->kind)
+    {
+        case BENCH_CORPUS_TELEMETRY:
+        {
+            corpus_telemetry e;
+            switch (id)
+            {
+                case 0:
+                    if (!bond_reader_read_uint64_value(reader, &e.timestamp))
+                    {
+                        return false;
+                    }
+                    *checksum += e.timestamp;
+                    return true;
+                case 1:
+                    return decode_string(reader, checksum);
+                case 2:
+                    if (!bond_reader_read_int32_value(reader, &e.event_type))
+                    {
+                        return false;
+                    }
+                    *checksum += (uint64_t)e.event_type;
+                    return true;
+                case 3:
+                    if (!bond_reader_read_double_value(reader, &e.value))
+                    {
+                        return false;
+                    }
+                    *checksum += (uint64_t)(int64_t)e.value;
+                    return true;
+                case 4:
+                    return decode_string_map(reader, checksum);
+                case 5:
+                {
+                    float samples[64];
+                    if (!bond_reader_read_list_begin(reader, &element_type, &count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        if (!bond_reader_read_float_value(reader, &samples[i & 63]))
+                        {
+                            return false;
+                        }
+                    }
+                    *checksum += count ? (uint64_t)samples[(count - 1) & 63] : 0;
+                    return true;
+                }
+                default:
+                    return bond_reader_skip(reader, type);
+            }
+        }
+
+        case BENCH_CORPUS_COMPANY:
+        {
+            corpus_address address;
+            uint16_t founded;
+            switch (id)
+            {
+                case 1:
+                    return decode_string(reader, checksum);
+                case 2:
+                    return decode_address(reader, &address, checksum);
+                case 3:
+                case 4:
+                    if (!bond_reader_read_list_begin(reader, &element_type, &count))
+                    {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        bool ok = id == 3 ? decode_string(reader, checksum)
+                                          : decode_address(reader, &address, checksum);
+                        if (!ok)
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                case 5:
+                    if (!bond_reader_read_uint16_value(reader, &founded))
+                    {
+                        return false;
+                    }
+                    *checksum += founded;
+                    return true;
+                default:
+                    return bond_reader_skip(reader, type);
+            }
+        }
+
+        case BENCH_CORPUS_WIDE:
+        {
+            // Decode by wire type, as generated code would by field id
+            switch (type)
+            {
+                case BOND_TYPE_UINT32:
+                {
+                    uint32_t v;
+                    if (!bond_reader_read_uint32_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *checksum += v;
+                    return true;
+                }
+                case BOND_TYPE_INT64:
+                {
+                    int64_t v;
+                    if (!bond_reader_read_int64_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *checksum += (uint64_t)v;
+                    return true;
+                }
+                case BOND_TYPE_DOUBLE:
+                {
+                    double v;
+                    if (!bond_reader_read_double_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *checksum += (uint64_t)v;
+                    return true;
+                }
+                case BOND_TYPE_STRING:
+                    return decode_string(reader, checksum);
+                case BOND_TYPE_BOOL:
+                {
+                    bool v;
+                    if (!bond_reader_read_bool_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *checksum += v;
+                    return true;
+                }
+                case BOND_TYPE_UINT16:
+                {
+                    uint16_t v;
+                    if (!bond_reader_read_uint16_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *checksum += v;
+                    return true;
+                }
+                default:
+                    return bond_reader_skip(reader, type);
+            }
+        }
+
+        case BENCH_CORPUS_NUMERIC:
+            if (id == 0)
+            {
+                if (!bond_reader_read_list_begin(reader, &element_type, &count))
+                {
+                    return false;
+                }
+                int64_t v = 0;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (!bond_reader_read_int64_value(reader, &v))
+                    {
+                        return false;
+                    }
+                }
+                *checksum += (uint64_t)v;
+                return true;
+            }
+            if (id == 1)
+            {
+                if (!bond_reader_read_double_list(reader, p->scratch, p->scratch_capacity, &count))
+                {
+                    return false;
+                }
+                *checksum += count ? (uint64_t)p->scratch[count - 1] : 0;
+                return true;
+            }
+            return bond_reader_skip(reader, type);
+
+        default:
+            if (id == 0)
+            {
+                return decode_string(reader, checksum);
+            }
+            if (id == 1)
+            {
+                return decode_string_map(reader, checksum);
+            }
+            return bond_reader_skip(reader, type);
+    }
+}
+
+bool bench_corpus_decode(const bench_corpus_set *set, BondReader *reader, uint64_t *checksum)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(reader, &id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        if (!decode_field(set, reader, id, type, checksum))
+        {
+            return false;
+        }
+    }
+}
+
+// ============================================================================
+// Corpus Sets
+// ============================================================================
+
+static const size_t record_sizes[BENCH_CORPUS_KIND_COUNT] = {
+    sizeof(corpus_telemetry),
+    sizeof(corpus_company),
+    sizeof(corpus_wide),
+    sizeof(corpus_numeric),
+    sizeof(corpus_string_map),
+};
+
+void bench_corpus_config_init(bench_corpus_config *config)
+{
+    config->seed = 0x5EEDB0D5ull;
+    config->counts[BENCH_CORPUS_TELEMETRY] = 1000000;
+    config->counts[BENCH_CORPUS_COMPANY] = 10000;
+    config->counts[BENCH_CORPUS_WIDE] = 10000;
+    config->counts[BENCH_CORPUS_NUMERIC] = 200;
+    config->counts[BENCH_CORPUS_STRING_MAP] = 2000;
+    config->string_length = (bench_size_dist){ 4, 64, true };
+    config->list_length = (bench_size_dist){ 0, 16, true };
+    config->big_list_length = (bench_size_dist){ 1024, 65536, true };
+    config->map_size = (bench_size_dist){ 8, 256, true };
+}
+
+bool bench_size_dist_parse(const char *text, bench_size_dist *dist)
+{
+    char *end;
+    unsigned long min = strtoul(text, &end, 10);
+    if (*end != ':')
+    {
+        return false;
+    }
+    unsigned long max = strtoul(end + 1, &end, 10);
+    if (max < min || max > UINT32_MAX / 2)
+    {
+        return false;
+    }
+    dist->min = (uint32_t)min;
+    dist->max = (uint32_t)max;
+    dist->log_uniform = strcmp(end, ":log") == 0;
+    return *end == '\0' || dist->log_uniform;
+}
+
+const char *bench_corpus_kind_name(bench_corpus_kind kind)
+{
+    static const char *names[BENCH_CORPUS_KIND_COUNT] = {
+        "telemetry", "company", "wide", "numeric", "string_map"
+    };
+    return kind < BENCH_CORPUS_KIND_COUNT ? names[kind] : "unknown";
+}
+
+bool bench_corpus_generate(bench_corpus_set *set, bench_corpus_kind kind,
+                           const bench_corpus_config *config)
+{
+    memset(set, 0, sizeof(*set));
+    set->kind = kind;
+    set->count = config->counts[kind];
+    set->records = calloc(set->count ? set->count : 1, record_sizes[kind]);
+    set->pools = calloc(1, sizeof(corpus_pools));
+    set->offsets = (size_t *)malloc(((size_t)set->count + 1) * sizeof(size_t));
+    corpus_pools *pools = (corpus_pools *)set->pools;
+    if (set->records == NULL || pools == NULL || set->offsets == NULL ||
+        bond_buffer_init(&pools->strings, 1 << 20) != 0 ||
+        bond_buffer_init(&set->encoded, 1 << 20) != 0)
+    {
+        bench_corpus_destroy(set);
+        return false;
+    }
+
+    // Each kind gets its own stream so changing one count leaves the others
+    generator g = { config->seed * 0x9E3779B97F4A7C15ull + (uint64_t)kind + 1, config, pools, false };
+    for (uint32_t i = 0; i < set->count && !g.failed; i++)
+    {
+        switch (kind)
+        {
+            case BENCH_CORPUS_TELEMETRY:
+                generate_telemetry(&g, (corpus_telemetry *)set->records + i, i);
+                break;
+            case BENCH_CORPUS_COMPANY:
+                generate_company(&g, (corpus_company *)set->records + i);
+                break;
+            case BENCH_CORPUS_WIDE:
+                generate_wide(&g, (corpus_wide *)set->records + i);
+                break;
+            case BENCH_CORPUS_NUMERIC:
+                generate_numeric(&g, (corpus_numeric *)set->records + i);
+                break;
+            default:
+                generate_string_map(&g, (corpus_string_map *)set->records + i);
+                break;
+        }
+    }
+    if (g.failed)
+    {
+        bench_corpus_destroy(set);
+        return false;
+    }
+
+    bond_writer writer;
+    bond_writer_init(&writer, &set->encoded);
+    for (uint32_t i = 0; i < set->count; i++)
+    {
+        set->offsets[i] = set->encoded.size;
+        bench_corpus_encode(set, i, &writer);
+    }
+    set->offsets[set->count] = set->encoded.size;
+    return true;
+}
+
+void bench_corpus_destroy(bench_corpus_set *set)
+{
+    corpus_pools *pools = (corpus_pools *)set->pools;
+    if (pools != NULL)
+    {
+        bond_buffer_destroy(&pools->strings);
+        free(pools->string_refs);
+        free(pools->floats);
+        free(pools->ints);
+        free(pools->doubles);
+        free(pools->addresses);
+        free(pools->scratch);
+        free(pools);
+    }
+    bond_buffer_destroy(&set->encoded);
+    free(set->records);
+    free(set->offsets);
+    memset(set, 0, sizeof(*set));
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_corpus.h
+ * @brief Deterministic corpus of production-like records for macro-benchmarks
+ *
+ * Each corpus set holds one record kind both as C model structs (input to
+ * encoding) and as CompactBinary bytes (input to decoding). Generation is
+ * seeded, so the same config always yields the same bytes.
+ *
+ * Record kinds:
+ *   telemetry  timestamp, device id, event type, value, string tags, samples
+ *   company    Company/Address from examples/nested_struct.c plus offices
+ *   wide       240 fields of mixed types, ids spanning every header width
+ *   numeric    big list<int64> and list<double>
+ *   string_map map<string, string>
+ */
+
+#ifndef BOND_BENCH_CORPUS_H
+#define BOND_BENCH_CORPUS_H
+
+#include "bond_buffer.h"
+#include "bond_reader.h"
+#include "bond_writer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    BENCH_CORPUS_TELEMETRY,
+    BENCH_CORPUS_COMPANY,
+    BENCH_CORPUS_WIDE,
+    BENCH_CORPUS_NUMERIC,
+    BENCH_CORPUS_STRING_MAP,
+    BENCH_CORPUS_KIND_COUNT
+} bench_corpus_kind;
+
+/**
+ * Size distribution for string lengths, list lengths and map sizes
+ */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    bool log_uniform;       // Skew towards min, like most production data
+} bench_size_dist;
+
+typedef struct {
+    uint64_t seed;
+    uint32_t counts[BENCH_CORPUS_KIND_COUNT];   // Records per kind
+    bench_size_dist string_length;              // Bytes per string
+    bench_size_dist list_length;                // Elements in small lists
+    bench_size_dist big_list_length;            // Elements in numeric lists
+    bench_size_dist map_size;                   // Entries per string map
+} bench_corpus_config;
+
+/**
+ * Records of one kind
+ */
+typedef struct {
+    bench_corpus_kind kind;
+    uint32_t count;
+    void *records;          // Model structs (private to bench_corpus.c)
+    void *pools;            // Strings and element arrays the records point into
+    bond_buffer encoded;    // All records back to back
+    size_t *offsets;        // count + 1 record offsets into encoded
+} bench_corpus_set;
+
+/**
+ * Defaults: 1M telemetry events, 10k companies, 10k wide structs, 200
+ * numeric lists and 2k string maps
+ */
+void bench_corpus_config_init(bench_corpus_config *config);
+
+/**
+ * Parse "MIN:MAX" or "MIN:MAX:log"
+ */
+bool bench_size_dist_parse(const char *text, bench_size_dist *dist);
+
+const char *bench_corpus_kind_name(bench_corpus_kind kind);
+
+/**
+ * Generate the records of one kind and encode them
+ *
+ * @return false on allocation failure
+ */
+bool bench_corpus_generate(bench_corpus_set *set, bench_corpus_kind kind,
+                           const bench_corpus_config *config);
+
+void bench_corpus_destroy(bench_corpus_set *set);
+
+/**
+ * Encode record `index` as a top-level struct
+ */
+void bench_corpus_encode(const bench_corpus_set *set, uint32_t index, bond_writer *writer);
+
+/**
+ * Decode one record into a scratch model, touching every field
+ *
+ * @param checksum  Accumulates decoded values so the work is not elided
+ * @return false on malformed input
+ */
+bool bench_corpus_decode(const bench_corpus_set *set, BondReader *reader, uint64_t *checksum);
+
+#endif // BOND_BENCH_CORPUS_H
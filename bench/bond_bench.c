@@ -0,0 +1,978 @@
+/**
+ * @file bond_bench.c
+ * @brief Microbenchmarks for encoding primitives and reader/writer hot paths
+ *
+ * Usage: bond_bench [--filter=TEXT] [--json] [--min-time=SEC] [--repetitions=N]
+ *
+ * Fixtures are generated from a fixed seed so every run measures the same
+ * bytes. Throughput counts encoded bytes.
+ */
+
+#include "bench.h"
+#include "bond_lite.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Fixtures
+// ============================================================================
+
+#define SAMPLE_COUNT 4096           // Values per fixture (power of two)
+#define SAMPLE_MASK (SAMPLE_COUNT - 1)
+#define LIST_LENGTH 256             // Elements per list benchmark
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next_random(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1Dull;
+}
+
+// Value size distributions for integer fixtures
+typedef enum {
+    DIST_SMALL,     // Fits one varint byte
+    DIST_MEDIUM,    // Two varint bytes
+    DIST_LARGE,     // Full width
+    DIST_MIXED      // Uniform over byte lengths
+} value_dist;
+
+static uint64_t random_value(value_dist dist, int bits)
+{
+    uint64_t mask = bits == 64 ? UINT64_MAX : ((UINT64_C(1) << bits) - 1);
+    uint64_t r = next_random();
+    switch (dist)
+    {
+        case DIST_SMALL:
+            return r & 0x7F;
+        case DIST_MEDIUM:
+            return 0x80 + r % (0x4000 - 0x80);
+        case DIST_LARGE:
+            return (r | (UINT64_C(1) << (bits - 1))) & mask;
+        default:
+        {
+            int width = 1 + (int)(next_random() % (uint64_t)bits);
+            return width == 64 ? r : r & ((UINT64_C(1) << width) - 1);
+        }
+    }
+}
+
+typedef struct {
+    int bits;                               // 16, 32 or 64
+    uint64_t values[SAMPLE_COUNT];
+    int64_t signed_values[SAMPLE_COUNT];    // Same magnitudes, random signs
+    uint8_t encoded[SAMPLE_COUNT * 10];     // values back to back as varints
+    size_t encoded_size;
+} varint_fixture;
+
+static void varint_fixture_init(varint_fixture *f, int bits, value_dist dist)
+{
+    f->bits = bits;
+    f->encoded_size = 0;
+    for (size_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        uint64_t v = random_value(dist, bits);
+        f->values[i] = v;
+        int64_t magnitude = (int64_t)(v >> 1);
+        f->signed_values[i] = (next_random() & 1) ? -magnitude : magnitude;
+        f->encoded_size += bond_encode_varint64(f->encoded + f->encoded_size, v);
+    }
+}
+
+typedef struct {
+    BondDataType type;
+    bond_buffer encoded;        // One list<type> value (no field header)
+} list_fixture;
+
+typedef struct {
+    uint16_t ids[SAMPLE_COUNT];
+    bond_buffer encoded;        // SAMPLE_COUNT uint8 fields back to back
+} header_fixture;
+
+typedef struct {
+    char *text;
+    size_t len;
+    bond_buffer encoded;        // One string value
+} string_fixture;
+
+// ============================================================================
+// Varint and ZigZag
+// ============================================================================
+
+static double bench_varint_encode(void *ctx, uint64_t iterations)
+{
+    const varint_fixture *f = (const varint_fixture *)ctx;
+    uint8_t out[10];
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        uint64_t v = f->values[i & SAMPLE_MASK];
+        if (f->bits == 16)
+        {
+            acc += bond_encode_varint16(out, (uint16_t)v);
+        }
+        else if (f->bits == 32)
+        {
+            acc += bond_encode_varint32(out, (uint32_t)v);
+        }
+        else
+        {
+            acc += bond_encode_varint64(out, v);
+        }
+        acc += out[0];
+    }
+    bench_sink += acc;
+    return (double)f->encoded_size / SAMPLE_COUNT;
+}
+
+static double bench_varint_decode(void *ctx, uint64_t iterations)
+{
+    const varint_fixture *f = (const varint_fixture *)ctx;
+    size_t pos = 0;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if (f->bits == 16)
+        {
+            uint16_t v;
+            pos += bond_decode_varint16(f->encoded + pos, &v);
+            acc += v;
+        }
+        else if (f->bits == 32)
+        {
+            uint32_t v;
+            pos += bond_decode_varint32(f->encoded + pos, &v);
+            acc += v;
+        }
+        else
+        {
+            uint64_t v;
+            pos += bond_decode_varint64(f->encoded + pos, &v);
+            acc += v;
+        }
+        if (pos >= f->encoded_size)
+        {
+            pos = 0;
+        }
+    }
+    bench_sink += acc;
+    return (double)f->encoded_size / SAMPLE_COUNT;
+}
+
+static double bench_zigzag(void *ctx, uint64_t iterations)
+{
+    const varint_fixture *f = (const varint_fixture *)ctx;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        int64_t v = f->signed_values[i & SAMPLE_MASK];
+        if (f->bits == 32)
+        {
+            acc += (uint64_t)bond_zigzag_decode32(bond_zigzag_encode32((int32_t)v));
+        }
+        else
+        {
+            acc += (uint64_t)bond_zigzag_decode64(bond_zigzag_encode64(v));
+        }
+    }
+    bench_sink += acc;
+    return 0;
+}
+
+// ============================================================================
+// Field Headers
+// ============================================================================
+
+static void header_fixture_init(header_fixture *f, uint16_t min_id, uint16_t max_id)
+{
+    bond_buffer_init(&f->encoded, SAMPLE_COUNT * 4);
+    bond_writer writer;
+    bond_writer_init(&writer, &f->encoded);
+    for (size_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        f->ids[i] = (uint16_t)(min_id + next_random() % (uint64_t)(max_id - min_id + 1));
+        bond_writer_write_uint8(&writer, f->ids[i], 1);
+    }
+}
+
+static double bench_header_write(void *ctx, uint64_t iterations)
+{
+    header_fixture *f = (header_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, SAMPLE_COUNT * 3);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if ((i & SAMPLE_MASK) == 0)
+        {
+            out.size = 0;
+        }
+        bond_writer_write_field_header(&writer, f->ids[i & SAMPLE_MASK], BOND_TYPE_UINT8);
+    }
+    bench_sink += out.size;
+    bond_buffer_destroy(&out);
+    // Encoded headers only, without the uint8 values
+    return (double)(f->encoded.size - SAMPLE_COUNT) / SAMPLE_COUNT;
+}
+
+static double bench_header_read(void *ctx, uint64_t iterations)
+{
+    header_fixture *f = (header_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        if ((i & SAMPLE_MASK) == 0)
+        {
+            f->encoded.read_pos = 0;
+        }
+        uint16_t id;
+        uint8_t type;
+        bond_reader_read_field_header(&reader, &id, &type);
+        f->encoded.read_pos++;  // uint8 value
+        acc += id;
+    }
+    bench_sink += acc;
+    return (double)(f->encoded.size - SAMPLE_COUNT) / SAMPLE_COUNT;
+}
+
+// ============================================================================
+// Strings
+// ============================================================================
+
+static void string_fixture_init(string_fixture *f, size_t len)
+{
+    f->len = len;
+    f->text = (char *)malloc(len + 1);
+    for (size_t i = 0; i < len; i++)
+    {
+        f->text[i] = (char)('a' + next_random() % 26);
+    }
+    f->text[len] = '\0';
+    bond_buffer_init(&f->encoded, len + 8);
+    bond_writer writer;
+    bond_writer_init(&writer, &f->encoded);
+    bond_writer_write_string_value(&writer, f->text);
+}
+
+static double bench_string_write(void *ctx, uint64_t iterations)
+{
+    const string_fixture *f = (const string_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, f->encoded.size);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        out.size = 0;
+        bond_writer_write_string_value(&writer, f->text);
+    }
+    bench_sink += out.size;
+    bond_buffer_destroy(&out);
+    return (double)f->encoded.size;
+}
+
+static double bench_string_read(void *ctx, uint64_t iterations)
+{
+    string_fixture *f = (string_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        f->encoded.read_pos = 0;
+        const char *str;
+        uint32_t len;
+        bond_reader_read_string_value(&reader, &str, &len);
+        acc += len + (uint8_t)str[len - 1];
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// ============================================================================
+// Lists
+// ============================================================================
+
+// Write one list of LIST_LENGTH elements drawn from the fixture values
+static void write_list(bond_writer *writer, BondDataType type, const varint_fixture *values,
+                       const char *const *strings)
+{
+    bond_buffer_write_byte(writer->buffer, (uint8_t)type);
+    bond_writer_write_uint32_value(writer, LIST_LENGTH);
+    for (uint32_t i = 0; i < LIST_LENGTH; i++)
+    {
+        uint64_t v = values->values[i];
+        int64_t s = values->signed_values[i];
+        switch (type)
+        {
+            case BOND_TYPE_BOOL:    bond_writer_write_bool_value(writer, v & 1); break;
+            case BOND_TYPE_UINT8:   bond_writer_write_uint8_value(writer, (uint8_t)v); break;
+            case BOND_TYPE_UINT16:  bond_writer_write_uint16_value(writer, (uint16_t)v); break;
+            case BOND_TYPE_UINT32:  bond_writer_write_uint32_value(writer, (uint32_t)v); break;
+            case BOND_TYPE_UINT64:  bond_writer_write_uint64_value(writer, v); break;
+            case BOND_TYPE_INT8:    bond_writer_write_int8_value(writer, (int8_t)s); break;
+            case BOND_TYPE_INT16:   bond_writer_write_int16_value(writer, (int16_t)s); break;
+            case BOND_TYPE_INT32:   bond_writer_write_int32_value(writer, (int32_t)s); break;
+            case BOND_TYPE_INT64:   bond_writer_write_int64_value(writer, s); break;
+            case BOND_TYPE_FLOAT:   bond_writer_write_float_value(writer, (float)s); break;
+            case BOND_TYPE_DOUBLE:  bond_writer_write_double_value(writer, (double)s); break;
+            case BOND_TYPE_STRING:  bond_writer_write_string_value(writer, strings[i & 7]); break;
+            default: break;
+        }
+    }
+}
+
+static const varint_fixture *list_values;
+static const char *const list_strings[8] = {
+    "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"
+};
+
+static void list_fixture_init(list_fixture *f, BondDataType type)
+{
+    f->type = type;
+    bond_buffer_init(&f->encoded, LIST_LENGTH * 10);
+    bond_writer writer;
+    bond_writer_init(&writer, &f->encoded);
+    write_list(&writer, type, list_values, list_strings);
+}
+
+static double bench_list_write(void *ctx, uint64_t iterations)
+{
+    const list_fixture *f = (const list_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, f->encoded.size);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        out.size = 0;
+        write_list(&writer, f->type, list_values, list_strings);
+    }
+    bench_sink += out.size;
+    bond_buffer_destroy(&out);
+    return (double)f->encoded.size;
+}
+
+static double bench_list_read(void *ctx, uint64_t iterations)
+{
+    list_fixture *f = (list_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        f->encoded.read_pos = 0;
+        uint8_t type;
+        uint32_t count;
+        bond_reader_read_list_begin(&reader, &type, &count);
+        for (uint32_t j = 0; j < count; j++)
+        {
+            switch (type)
+            {
+                case BOND_TYPE_BOOL:   { bool v; bond_reader_read_bool_value(&reader, &v); acc += v; break; }
+                case BOND_TYPE_UINT8:  { uint8_t v; bond_reader_read_uint8_value(&reader, &v); acc += v; break; }
+                case BOND_TYPE_UINT16: { uint16_t v; bond_reader_read_uint16_value(&reader, &v); acc += v; break; }
+                case BOND_TYPE_UINT32: { uint32_t v; bond_reader_read_uint32_value(&reader, &v); acc += v; break; }
+                case BOND_TYPE_UINT64: { uint64_t v; bond_reader_read_uint64_value(&reader, &v); acc += v; break; }
+                case BOND_TYPE_INT8:   { int8_t v; bond_reader_read_int8_value(&reader, &v); acc += (uint64_t)v; break; }
+                case BOND_TYPE_INT16:  { int16_t v; bond_reader_read_int16_value(&reader, &v); acc += (uint64_t)v; break; }
+                case BOND_TYPE_INT32:  { int32_t v; bond_reader_read_int32_value(&reader, &v); acc += (uint64_t)v; break; }
+                case BOND_TYPE_INT64:  { int64_t v; bond_reader_read_int64_value(&reader, &v); acc += (uint64_t)v; break; }
+                case BOND_TYPE_FLOAT:  { float v; bond_reader_read_float_value(&reader, &v); acc += (uint64_t)(int64_t)v; break; }
+                case BOND_TYPE_DOUBLE: { double v; bond_reader_read_double_value(&reader, &v); acc += (uint64_t)(int64_t)v; break; }
+                case BOND_TYPE_STRING:
+                {
+                    const char *str;
+                    uint32_t len;
+                    bond_reader_read_string_value(&reader, &str, &len);
+                    acc += len;
+                    break;
+                }
+                default: break;
+            }
+        }
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// Bulk float/double list paths
+typedef struct {
+    double doubles[LIST_LENGTH];
+    bond_buffer encoded;        // One double list field
+} bulk_fixture;
+
+static double bench_double_list_write(void *ctx, uint64_t iterations)
+{
+    const bulk_fixture *f = (const bulk_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, f->encoded.size);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        out.size = 0;
+        bond_writer_write_double_list(&writer, 0, f->doubles, LIST_LENGTH);
+    }
+    bench_sink += out.size;
+    bond_buffer_destroy(&out);
+    return (double)f->encoded.size;
+}
+
+static double bench_double_list_read(void *ctx, uint64_t iterations)
+{
+    bulk_fixture *f = (bulk_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    double out[LIST_LENGTH];
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        f->encoded.read_pos = 0;
+        uint16_t id;
+        uint8_t type;
+        uint32_t count;
+        bond_reader_read_field_header(&reader, &id, &type);
+        bond_reader_read_double_list(&reader, out, LIST_LENGTH, &count);
+        acc += count + (uint64_t)(int64_t)out[count - 1];
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// ============================================================================
+// Structs
+// ============================================================================
+
+// Company { name, headquarters: Address, departments: list<string>,
+//           offices: list<Address>, revenue: map<string, double> }
+static void write_company(bond_writer *writer)
+{
+    static const char *departments[] = { "Engineering", "Sales", "Support", "Finance" };
+    static const char *cities[] = { "Seattle", "Dublin", "Singapore", "Sydney", "Austin" };
+
+    bond_writer_struct_begin(writer);
+    bond_writer_write_string(writer, 1, "Contoso Ltd");
+    bond_writer_write_field_header(writer, 2, BOND_TYPE_STRUCT);
+    bond_writer_write_string(writer, 1, "1 Microsoft Way");
+    bond_writer_write_string(writer, 2, "Redmond");
+    bond_writer_write_uint32(writer, 3, 98052);
+    bond_writer_struct_end(writer);
+
+    bond_writer_write_list_begin(writer, 3, BOND_TYPE_STRING, 4);
+    for (int i = 0; i < 4; i++)
+    {
+        bond_writer_write_string_value(writer, departments[i]);
+    }
+
+    bond_writer_write_list_begin(writer, 4, BOND_TYPE_STRUCT, 5);
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        bond_writer_write_string(writer, 1, "Main Street");
+        bond_writer_write_string(writer, 2, cities[i]);
+        bond_writer_write_uint32(writer, 3, 10000 + i * 1111);
+        bond_writer_struct_end(writer);
+    }
+
+    bond_writer_write_map_begin(writer, 5, BOND_TYPE_STRING, BOND_TYPE_DOUBLE, 5);
+    for (int i = 0; i < 5; i++)
+    {
+        bond_writer_write_string_value(writer, cities[i]);
+        bond_writer_write_double_value(writer, 1.5e6 * (i + 1));
+    }
+    bond_writer_struct_end(writer);
+}
+
+// Read every field of an Address, returning a checksum
+static bool read_address(BondReader *reader, uint64_t *acc)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(reader, &id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        if (type == BOND_TYPE_STRING)
+        {
+            const char *str;
+            uint32_t len;
+            if (!bond_reader_read_string_value(reader, &str, &len))
+            {
+                return false;
+            }
+            *acc += len;
+        }
+        else if (type == BOND_TYPE_UINT32)
+        {
+            uint32_t v;
+            if (!bond_reader_read_uint32_value(reader, &v))
+            {
+                return false;
+            }
+            *acc += v;
+        }
+        else if (!bond_reader_skip(reader, type))
+        {
+            return false;
+        }
+    }
+}
+
+static bool read_company(BondReader *reader, uint64_t *acc)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        uint8_t element_type;
+        uint8_t value_type;
+        uint32_t count;
+        const char *str;
+        uint32_t len;
+        if (!bond_reader_read_field_header(reader, &id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        switch (id)
+        {
+            case 1:
+                if (!bond_reader_read_string_value(reader, &str, &len))
+                {
+                    return false;
+                }
+                *acc += len;
+                break;
+            case 2:
+                if (!read_address(reader, acc))
+                {
+                    return false;
+                }
+                break;
+            case 3:
+                if (!bond_reader_read_list_begin(reader, &element_type, &count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (!bond_reader_read_string_value(reader, &str, &len))
+                    {
+                        return false;
+                    }
+                    *acc += len;
+                }
+                break;
+            case 4:
+                if (!bond_reader_read_list_begin(reader, &element_type, &count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (!read_address(reader, acc))
+                    {
+                        return false;
+                    }
+                }
+                break;
+            case 5:
+                if (!bond_reader_read_map_begin(reader, &element_type, &value_type, &count))
+                {
+                    return false;
+                }
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    double v;
+                    if (!bond_reader_read_string_value(reader, &str, &len) ||
+                        !bond_reader_read_double_value(reader, &v))
+                    {
+                        return false;
+                    }
+                    *acc += len + (uint64_t)v;
+                }
+                break;
+            default:
+                if (!bond_reader_skip(reader, type))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+}
+
+// Same walk over validated bytes, with no checks left to fail
+static void read_address_unchecked(BondUncheckedReader *reader, uint64_t *acc)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        bond_unchecked_read_field_header(reader, &id, &type);
+        if (type == BOND_TYPE_STOP)
+        {
+            return;
+        }
+        if (type == BOND_TYPE_STRING)
+        {
+            const char *str;
+            uint32_t len;
+            bond_unchecked_read_string_value(reader, &str, &len);
+            *acc += len;
+        }
+        else if (type == BOND_TYPE_UINT32)
+        {
+            *acc += bond_unchecked_read_uint32_value(reader);
+        }
+        else
+        {
+            bond_unchecked_skip(reader, type);
+        }
+    }
+}
+
+static void read_company_unchecked(BondUncheckedReader *reader, uint64_t *acc)
+{
+    while (true)
+    {
+        uint16_t id;
+        uint8_t type;
+        uint8_t element_type;
+        uint8_t value_type;
+        uint32_t count;
+        const char *str;
+        uint32_t len;
+        bond_unchecked_read_field_header(reader, &id, &type);
+        if (type == BOND_TYPE_STOP)
+        {
+            return;
+        }
+        switch (id)
+        {
+            case 1:
+                bond_unchecked_read_string_value(reader, &str, &len);
+                *acc += len;
+                break;
+            case 2:
+                read_address_unchecked(reader, acc);
+                break;
+            case 3:
+                bond_unchecked_read_list_begin(reader, &element_type, &count);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    bond_unchecked_read_string_value(reader, &str, &len);
+                    *acc += len;
+                }
+                break;
+            case 4:
+                bond_unchecked_read_list_begin(reader, &element_type, &count);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    read_address_unchecked(reader, acc);
+                }
+                break;
+            case 5:
+                bond_unchecked_read_map_begin(reader, &element_type, &value_type, &count);
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    bond_unchecked_read_string_value(reader, &str, &len);
+                    *acc += len + (uint64_t)bond_unchecked_read_double_value(reader);
+                }
+                break;
+            default:
+                bond_unchecked_skip(reader, type);
+                break;
+        }
+    }
+}
+
+typedef struct {
+    bond_buffer encoded;        // One Company struct
+    BondValidationToken token;  // Validated once at setup
+} struct_fixture;
+
+static double bench_struct_write(void *ctx, uint64_t iterations)
+{
+    const struct_fixture *f = (const struct_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, f->encoded.size);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        out.size = 0;
+        write_company(&writer);
+    }
+    bench_sink += out.size;
+    bond_buffer_destroy(&out);
+    return (double)f->encoded.size;
+}
+
+static double bench_struct_read(void *ctx, uint64_t iterations)
+{
+    struct_fixture *f = (struct_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        f->encoded.read_pos = 0;
+        read_company(&reader, &acc);
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// Decode bytes validated earlier (e.g. on receipt), with no checks
+static double bench_struct_read_unchecked(void *ctx, uint64_t iterations)
+{
+    const struct_fixture *f = (const struct_fixture *)ctx;
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        BondUncheckedReader reader;
+        bond_unchecked_reader_init(&reader, &f->token);
+        read_company_unchecked(&reader, &acc);
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// Validate then decode unchecked: the full cost against struct/read
+static double bench_struct_validate_read_unchecked(void *ctx, uint64_t iterations)
+{
+    struct_fixture *f = (struct_fixture *)ctx;
+    uint64_t acc = 0;
+    f->encoded.read_pos = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        BondValidationToken token;
+        BondUncheckedReader reader;
+        if (bond_validate(&f->encoded, NULL, &token) &&
+            bond_unchecked_reader_init(&reader, &token))
+        {
+            read_company_unchecked(&reader, &acc);
+        }
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+static double bench_struct_skip(void *ctx, uint64_t iterations)
+{
+    struct_fixture *f = (struct_fixture *)ctx;
+    BondReader reader;
+    bond_reader_init(&reader, &f->encoded);
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        f->encoded.read_pos = 0;
+        bond_reader_skip(&reader, BOND_TYPE_STRUCT);
+    }
+    bench_sink += f->encoded.read_pos;
+    return (double)f->encoded.size;
+}
+
+static double bench_struct_roundtrip(void *ctx, uint64_t iterations)
+{
+    const struct_fixture *f = (const struct_fixture *)ctx;
+    bond_buffer out;
+    bond_buffer_init(&out, f->encoded.size);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    BondReader reader;
+    bond_reader_init(&reader, &out);
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        out.size = 0;
+        out.read_pos = 0;
+        write_company(&writer);
+        read_company(&reader, &acc);
+    }
+    bench_sink += acc;
+    bond_buffer_destroy(&out);
+    return (double)f->encoded.size;
+}
+
+static double bench_validate(void *ctx, uint64_t iterations)
+{
+    struct_fixture *f = (struct_fixture *)ctx;
+    BondValidationToken token;
+    uint64_t acc = 0;
+    f->encoded.read_pos = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        acc += bond_validate(&f->encoded, NULL, &token);
+    }
+    bench_sink += acc;
+    return (double)f->encoded.size;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+#define MAX_CASES 128
+
+static bench_case cases[MAX_CASES];
+static size_t case_count;
+
+static void add_case(const char *name, bench_fn fn, void *ctx)
+{
+    if (case_count < MAX_CASES)
+    {
+        cases[case_count].name = name;
+        cases[case_count].fn = fn;
+        cases[case_count].ctx = ctx;
+        cases[case_count].prepare = NULL;
+        case_count++;
+    }
+}
+
+static varint_fixture varints[3][4];
+static header_fixture headers[3];
+static string_fixture strings[2];
+static list_fixture lists[12];
+static bulk_fixture doubles;
+static struct_fixture company;
+
+static void setup_cases(void)
+{
+    static const int widths[3] = { 16, 32, 64 };
+    static const char *names[3][4][2] = {
+        {
+            { "varint16/encode/small", "varint16/decode/small" },
+            { "varint16/encode/medium", "varint16/decode/medium" },
+            { "varint16/encode/large", "varint16/decode/large" },
+            { "varint16/encode/mixed", "varint16/decode/mixed" },
+        },
+        {
+            { "varint32/encode/small", "varint32/decode/small" },
+            { "varint32/encode/medium", "varint32/decode/medium" },
+            { "varint32/encode/large", "varint32/decode/large" },
+            { "varint32/encode/mixed", "varint32/decode/mixed" },
+        },
+        {
+            { "varint64/encode/small", "varint64/decode/small" },
+            { "varint64/encode/medium", "varint64/decode/medium" },
+            { "varint64/encode/large", "varint64/decode/large" },
+            { "varint64/encode/mixed", "varint64/decode/mixed" },
+        },
+    };
+    for (int w = 0; w < 3; w++)
+    {
+        for (int d = 0; d < 4; d++)
+        {
+            varint_fixture_init(&varints[w][d], widths[w], (value_dist)d);
+            add_case(names[w][d][0], bench_varint_encode, &varints[w][d]);
+            add_case(names[w][d][1], bench_varint_decode, &varints[w][d]);
+        }
+    }
+    add_case("zigzag32/roundtrip/mixed", bench_zigzag, &varints[1][DIST_MIXED]);
+    add_case("zigzag64/roundtrip/mixed", bench_zigzag, &varints[2][DIST_MIXED]);
+
+    header_fixture_init(&headers[0], 0, 5);
+    header_fixture_init(&headers[1], 6, 255);
+    header_fixture_init(&headers[2], 256, 65535);
+    add_case("field_header/write/id_0_5", bench_header_write, &headers[0]);
+    add_case("field_header/read/id_0_5", bench_header_read, &headers[0]);
+    add_case("field_header/write/id_6_255", bench_header_write, &headers[1]);
+    add_case("field_header/read/id_6_255", bench_header_read, &headers[1]);
+    add_case("field_header/write/id_256_65535", bench_header_write, &headers[2]);
+    add_case("field_header/read/id_256_65535", bench_header_read, &headers[2]);
+
+    string_fixture_init(&strings[0], 12);
+    string_fixture_init(&strings[1], 4096);
+    add_case("string/write/short", bench_string_write, &strings[0]);
+    add_case("string/read/short", bench_string_read, &strings[0]);
+    add_case("string/write/long", bench_string_write, &strings[1]);
+    add_case("string/read/long", bench_string_read, &strings[1]);
+
+    static const struct {
+        BondDataType type;
+        const char *write;
+        const char *read;
+    } list_types[12] = {
+        { BOND_TYPE_BOOL, "list/write/bool", "list/read/bool" },
+        { BOND_TYPE_UINT8, "list/write/uint8", "list/read/uint8" },
+        { BOND_TYPE_UINT16, "list/write/uint16", "list/read/uint16" },
+        { BOND_TYPE_UINT32, "list/write/uint32", "list/read/uint32" },
+        { BOND_TYPE_UINT64, "list/write/uint64", "list/read/uint64" },
+        { BOND_TYPE_INT8, "list/write/int8", "list/read/int8" },
+        { BOND_TYPE_INT16, "list/write/int16", "list/read/int16" },
+        { BOND_TYPE_INT32, "list/write/int32", "list/read/int32" },
+        { BOND_TYPE_INT64, "list/write/int64", "list/read/int64" },
+        { BOND_TYPE_FLOAT, "list/write/float", "list/read/float" },
+        { BOND_TYPE_DOUBLE, "list/write/double", "list/read/double" },
+        { BOND_TYPE_STRING, "list/write/string", "list/read/string" },
+    };
+    list_values = &varints[2][DIST_MIXED];
+    for (int i = 0; i < 12; i++)
+    {
+        list_fixture_init(&lists[i], list_types[i].type);
+        add_case(list_types[i].write, bench_list_write, &lists[i]);
+        add_case(list_types[i].read, bench_list_read, &lists[i]);
+    }
+
+    for (int i = 0; i < LIST_LENGTH; i++)
+    {
+        doubles.doubles[i] = (double)varints[2][DIST_MIXED].signed_values[i] / 3.0;
+    }
+    bond_buffer_init(&doubles.encoded, LIST_LENGTH * 8 + 8);
+    bond_writer writer;
+    bond_writer_init(&writer, &doubles.encoded);
+    bond_writer_write_double_list(&writer, 0, doubles.doubles, LIST_LENGTH);
+    add_case("list/write/double_bulk", bench_double_list_write, &doubles);
+    add_case("list/read/double_bulk", bench_double_list_read, &doubles);
+
+    bond_buffer_init(&company.encoded, 512);
+    bond_writer_init(&writer, &company.encoded);
+    write_company(&writer);
+    if (!bond_validate(&company.encoded, NULL, &company.token))
+    {
+        fprintf(stderr, "company fixture does not validate\n");
+        exit(1);
+    }
+    add_case("struct/write/company", bench_struct_write, &company);
+    add_case("struct/read/company", bench_struct_read, &company);
+    add_case("struct/read_unchecked/company", bench_struct_read_unchecked, &company);
+    add_case("struct/validate_read_unchecked/company", bench_struct_validate_read_unchecked, &company);
+    add_case("struct/skip/company", bench_struct_skip, &company);
+    add_case("struct/roundtrip/company", bench_struct_roundtrip, &company);
+    add_case("struct/validate/company", bench_validate, &company);
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options;
+    bench_options_init(&options);
+    for (int i = 1; i < argc; i++)
+    {
+        if (!bench_parse_option(argv[i], &options))
+        {
+            fprintf(stderr, "usage: %s [options]\n", argv[0]);
+            bench_print_usage();
+            return 2;
+        }
+    }
+
+    setup_cases();
+    return bench_run("bond_bench", cases, case_count, &options);
+}
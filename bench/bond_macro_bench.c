@@ -0,0 +1,356 @@
+/**
+ * @file bond_macro_bench.c
+ * @brief End-to-end encode/decode benchmarks over a generated corpus
+ *
+ * Usage: bond_macro_bench [corpus options] [--filter=TEXT] [--json] ...
+ *
+ * Each record kind is measured four ways:
+ *   macro/<kind>/encode/cold   every record in shuffled order, caches evicted
+ *   macro/<kind>/decode/cold   before each batch
+ *   macro/<kind>/encode/warm   a cache-sized window of records, pre-touched
+ *   macro/<kind>/decode/warm   before each batch
+ *
+ * Throughput counts encoded bytes. Use --write-corpus=PREFIX to dump each
+ * corpus as PREFIX<kind>.bin (records back to back) for offline inspection.
+ */
+
+#include "bench.h"
+#include "bench_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WARM_WINDOW_BYTES (256 * 1024)      // Encoded bytes cycled by warm cases
+#define EVICT_BYTES (64 * 1024 * 1024)      // Larger than any last-level cache
+
+typedef struct {
+    bench_corpus_set *set;
+    uint32_t *order;            // Record visiting order
+    uint32_t order_count;       // All records (cold) or the warm window
+    uint32_t cursor;            // Persists across batches
+    bond_buffer out;            // Encode target, reused
+} macro_ctx;
+
+static bench_corpus_set sets[BENCH_CORPUS_KIND_COUNT];
+static macro_ctx contexts[BENCH_CORPUS_KIND_COUNT][2][2];     // [kind][decode][warm]
+static uint8_t *evict_buffer;
+
+#define MAX_CASES (BENCH_CORPUS_KIND_COUNT * 4)
+static bench_case cases[MAX_CASES];
+static char case_names[MAX_CASES][48];
+static size_t case_count;
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static double macro_encode(void *ctx, uint64_t iterations)
+{
+    macro_ctx *m = (macro_ctx *)ctx;
+    bond_writer writer;
+    bond_writer_init(&writer, &m->out);
+    uint64_t bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        m->out.size = 0;
+        bench_corpus_encode(m->set, m->order[m->cursor], &writer);
+        bytes += m->out.size;
+        if (++m->cursor == m->order_count)
+        {
+            m->cursor = 0;
+        }
+    }
+    bench_sink = m->out.size;
+    return (double)bytes / (double)iterations;
+}
+
+static double macro_decode(void *ctx, uint64_t iterations)
+{
+    macro_ctx *m = (macro_ctx *)ctx;
+    const bench_corpus_set *set = m->set;
+    bond_buffer view = set->encoded;
+    BondReader reader;
+    bond_reader_init(&reader, &view);
+    uint64_t checksum = 0;
+    uint64_t bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        uint32_t index = m->order[m->cursor];
+        view.read_pos = set->offsets[index];
+        if (!bench_corpus_decode(set, &reader, &checksum))
+        {
+            fprintf(stderr, "decode failed at %s record %u\n",
+                    bench_corpus_kind_name(set->kind), index);
+            exit(1);
+        }
+        bytes += set->offsets[index + 1] - set->offsets[index];
+        if (++m->cursor == m->order_count)
+        {
+            m->cursor = 0;
+        }
+    }
+    bench_sink = checksum;
+    return (double)bytes / (double)iterations;
+}
+
+static void evict_caches(void *ctx)
+{
+    (void)ctx;
+    // Write every line so both clean and dirty corpus lines are displaced
+    for (size_t i = 0; i < EVICT_BYTES; i += 64)
+    {
+        evict_buffer[i]++;
+    }
+    bench_sink = evict_buffer[0];
+}
+
+static void warm_window(void *ctx)
+{
+    macro_ctx *m = (macro_ctx *)ctx;
+    uint32_t cursor = m->cursor;
+    if (m == &contexts[m->set->kind][0][1])
+    {
+        macro_encode(ctx, m->order_count);
+    }
+    else
+    {
+        macro_decode(ctx, m->order_count);
+    }
+    m->cursor = cursor;
+}
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+static bool setup_kind(bench_corpus_kind kind, uint64_t seed)
+{
+    bench_corpus_set *set = &sets[kind];
+
+    // Cold cases visit every record in a seeded shuffle; warm cases cycle
+    // over the first records up to a cache-sized window
+    uint32_t *shuffled = (uint32_t *)malloc((size_t)set->count * sizeof(uint32_t));
+    uint32_t *sequential = (uint32_t *)malloc((size_t)set->count * sizeof(uint32_t));
+    if (shuffled == NULL || sequential == NULL)
+    {
+        free(shuffled);
+        free(sequential);
+        return false;
+    }
+    uint64_t rng = seed | 1;
+    for (uint32_t i = 0; i < set->count; i++)
+    {
+        shuffled[i] = i;
+        sequential[i] = i;
+    }
+    for (uint32_t i = set->count - 1; i > 0; i--)
+    {
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        uint32_t j = (uint32_t)((rng * 0x2545F4914F6CDD1Dull) % ((uint64_t)i + 1));
+        uint32_t tmp = shuffled[i];
+        shuffled[i] = shuffled[j];
+        shuffled[j] = tmp;
+    }
+    uint32_t window = 1;
+    while (window < set->count && set->offsets[window + 1] <= WARM_WINDOW_BYTES)
+    {
+        window++;
+    }
+
+    size_t largest = 0;
+    for (uint32_t i = 0; i < set->count; i++)
+    {
+        size_t size = set->offsets[i + 1] - set->offsets[i];
+        largest = size > largest ? size : largest;
+    }
+
+    static const char *ops[2] = { "encode", "decode" };
+    static const char *temps[2] = { "cold", "warm" };
+    for (int decode = 0; decode < 2; decode++)
+    {
+        for (int warm = 0; warm < 2; warm++)
+        {
+            macro_ctx *m = &contexts[kind][decode][warm];
+            m->set = set;
+            m->order = warm ? sequential : shuffled;
+            m->order_count = warm ? window : set->count;
+            m->cursor = 0;
+            if (!decode && bond_buffer_init(&m->out, largest + 64) != 0)
+            {
+                return false;
+            }
+
+            bench_case *c = &cases[case_count];
+            snprintf(case_names[case_count], sizeof(case_names[0]), "macro/%s/%s/%s",
+                     bench_corpus_kind_name(kind), ops[decode], temps[warm]);
+            c->name = case_names[case_count];
+            c->fn = decode ? macro_decode : macro_encode;
+            c->ctx = m;
+            c->prepare = warm ? warm_window : evict_caches;
+            case_count++;
+        }
+    }
+    return true;
+}
+
+static bool write_corpus(const char *prefix, const bench_corpus_set *set)
+{
+    char path[1024];
+    snprintf(path, sizeof(path), "%s%s.bin", prefix, bench_corpus_kind_name(set->kind));
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    bool ok = fwrite(set->encoded.data, 1, set->encoded.size, file) == set->encoded.size;
+    return fclose(file) == 0 && ok;
+}
+
+static void print_usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --telemetry=N      Telemetry events (default 1000000)\n"
+            "  --companies=N      Company records (default 10000)\n"
+            "  --wide=N           Wide records (default 10000)\n"
+            "  --numeric=N        Numeric series (default 200)\n"
+            "  --maps=N           String maps (default 2000)\n"
+            "  --seed=S           Corpus seed\n"
+            "  --string-len=D     String length distribution, MIN:MAX[:log] (default 4:64:log)\n"
+            "  --list-len=D       Small list length distribution (default 0:16:log)\n"
+            "  --big-list-len=D   Numeric list length distribution (default 1024:65536:log)\n"
+            "  --map-size=D       String map size distribution (default 8:256:log)\n"
+            "  --write-corpus=P   Also write each corpus to P<kind>.bin\n",
+            program);
+    bench_print_usage();
+}
+
+static bool parse_count(const char *arg, const char *name, uint32_t *count)
+{
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0)
+    {
+        return false;
+    }
+    char *end;
+    unsigned long value = strtoul(arg + len, &end, 10);
+    *count = (uint32_t)value;
+    return *end == '\0' && value <= UINT32_MAX / 2;
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options;
+    bench_corpus_config config;
+    const char *corpus_prefix = NULL;
+    bench_options_init(&options);
+    bench_corpus_config_init(&config);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool ok;
+        if (strncmp(arg, "--telemetry=", 12) == 0)
+        {
+            ok = parse_count(arg, "--telemetry=", &config.counts[BENCH_CORPUS_TELEMETRY]);
+        }
+        else if (strncmp(arg, "--companies=", 12) == 0)
+        {
+            ok = parse_count(arg, "--companies=", &config.counts[BENCH_CORPUS_COMPANY]);
+        }
+        else if (strncmp(arg, "--wide=", 7) == 0)
+        {
+            ok = parse_count(arg, "--wide=", &config.counts[BENCH_CORPUS_WIDE]);
+        }
+        else if (strncmp(arg, "--numeric=", 10) == 0)
+        {
+            ok = parse_count(arg, "--numeric=", &config.counts[BENCH_CORPUS_NUMERIC]);
+        }
+        else if (strncmp(arg, "--maps=", 7) == 0)
+        {
+            ok = parse_count(arg, "--maps=", &config.counts[BENCH_CORPUS_STRING_MAP]);
+        }
+        else if (strncmp(arg, "--seed=", 7) == 0)
+        {
+            config.seed = strtoull(arg + 7, NULL, 0);
+            ok = true;
+        }
+        else if (strncmp(arg, "--string-len=", 13) == 0)
+        {
+            ok = bench_size_dist_parse(arg + 13, &config.string_length);
+        }
+        else if (strncmp(arg, "--list-len=", 11) == 0)
+        {
+            ok = bench_size_dist_parse(arg + 11, &config.list_length);
+        }
+        else if (strncmp(arg, "--big-list-len=", 15) == 0)
+        {
+            ok = bench_size_dist_parse(arg + 15, &config.big_list_length);
+        }
+        else if (strncmp(arg, "--map-size=", 11) == 0)
+        {
+            ok = bench_size_dist_parse(arg + 11, &config.map_size);
+        }
+        else if (strncmp(arg, "--write-corpus=", 15) == 0)
+        {
+            corpus_prefix = arg + 15;
+            ok = true;
+        }
+        else
+        {
+            ok = bench_parse_option(arg, &options);
+        }
+        if (!ok)
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    evict_buffer = (uint8_t *)calloc(EVICT_BYTES, 1);
+    if (evict_buffer == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // Kinds with a zero count are left out entirely
+    for (int kind = 0; kind < BENCH_CORPUS_KIND_COUNT; kind++)
+    {
+        if (config.counts[kind] == 0)
+        {
+            continue;
+        }
+        if (!bench_corpus_generate(&sets[kind], (bench_corpus_kind)kind, &config) ||
+            !setup_kind((bench_corpus_kind)kind, config.seed + (uint64_t)kind))
+        {
+            fprintf(stderr, "failed to generate %s corpus\n",
+                    bench_corpus_kind_name((bench_corpus_kind)kind));
+            return 1;
+        }
+        if (corpus_prefix != NULL && !write_corpus(corpus_prefix, &sets[kind]))
+        {
+            fprintf(stderr, "failed to write %s corpus\n",
+                    bench_corpus_kind_name((bench_corpus_kind)kind));
+            return 1;
+        }
+    }
+
+    int result = bench_run("bond_macro_bench", cases, case_count, &options);
+
+    for (int kind = 0; kind < BENCH_CORPUS_KIND_COUNT; kind++)
+    {
+        if (sets[kind].count > 0)
+        {
+            free(contexts[kind][0][0].order);
+            free(contexts[kind][0][1].order);
+            bond_buffer_destroy(&contexts[kind][0][0].out);
+            bond_buffer_destroy(&contexts[kind][0][1].out);
+        }
+        bench_corpus_destroy(&sets[kind]);
+    }
+    free(evict_buffer);
+    return result;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file bond_pool_bench.c
+ * @brief Buffer pool benchmarks, including producer/consumer handoff
+ *
+ * Usage: bond_pool_bench [--filter=TEXT] [--json] ...
+ *
+ *   pool/local/<alloc>                  acquire, serialize, release on one
+ *                                       thread
+ *   pool/handoff/<alloc>/<N>consumers   one producer serializes and hands
+ *                                       each buffer to one of N consumer
+ *                                       threads, which release it
+ *
+ * <alloc> is `malloc` (bond_buffer_init / bond_buffer_destroy, so consumers
+ * free memory malloc'd by the producer) or `pool` (bond_buffer_acquire /
+ * bond_buffer_release_to, so consumers push buffers back to the producer's
+ * inbox and contend on it). Consumer threads are started per batch.
+ */
+
+#include "bench.h"
+#include "bond_pool.h"
+#include "bond_writer.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MESSAGE_HINT 512
+#define RING_SLOTS 256              // Per consumer, power of two
+#define MAX_CONSUMERS 4
+
+typedef enum {
+    ALLOC_MALLOC,
+    ALLOC_POOL
+} alloc_mode;
+
+// Single-producer single-consumer ring
+typedef struct {
+    bond_buffer slots[RING_SLOTS];
+    _Atomic size_t head;            // Next slot to consume
+    _Atomic size_t tail;            // Next slot to fill
+    _Atomic bool done;              // Producer finished the batch
+    alloc_mode mode;
+    bond_buffer_pool *owner;
+    uint64_t sink;                  // Consumer's checksum, read after join
+} handoff_ring;
+
+typedef struct {
+    alloc_mode mode;
+    uint32_t consumers;
+} pool_ctx;
+
+static handoff_ring rings[MAX_CONSUMERS];
+static char payload[200];
+
+static pool_ctx contexts[] = {
+    { ALLOC_MALLOC, 0 },
+    { ALLOC_POOL, 0 },
+    { ALLOC_MALLOC, 1 },
+    { ALLOC_POOL, 1 },
+    { ALLOC_MALLOC, MAX_CONSUMERS },
+    { ALLOC_POOL, MAX_CONSUMERS },
+};
+
+#define CASE_COUNT (sizeof(contexts) / sizeof(contexts[0]))
+static bench_case cases[CASE_COUNT];
+static char case_names[CASE_COUNT][48];
+
+// ============================================================================
+// Message
+// ============================================================================
+
+static int open_buffer(bond_buffer *buf, alloc_mode mode)
+{
+    if (mode == ALLOC_POOL)
+    {
+        return bond_buffer_acquire(buf, MESSAGE_HINT);
+    }
+    return bond_buffer_init(buf, MESSAGE_HINT);
+}
+
+static void serialize_message(bond_buffer *buf, uint64_t sequence)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buf);
+    bond_writer_write_uint64(&writer, 0, sequence);
+    bond_writer_write_int32(&writer, 1, -42);
+    bond_writer_write_string(&writer, 2, payload);
+    bond_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// Handoff
+// ============================================================================
+
+static void *consume(void *arg)
+{
+    handoff_ring *ring = (handoff_ring *)arg;
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t sink = 0;
+    while (true)
+    {
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (head == tail)
+        {
+            if (atomic_load_explicit(&ring->done, memory_order_acquire) &&
+                head == atomic_load_explicit(&ring->tail, memory_order_acquire))
+            {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+        bond_buffer *buf = &ring->slots[head % RING_SLOTS];
+        sink += buf->data[buf->size - 1];
+        if (ring->mode == ALLOC_POOL)
+        {
+            bond_buffer_release_to(buf, ring->owner);
+        }
+        else
+        {
+            bond_buffer_destroy(buf);
+        }
+        atomic_store_explicit(&ring->head, ++head, memory_order_release);
+    }
+    ring->sink = sink;
+    return NULL;
+}
+
+static void produce(handoff_ring *ring, const bond_buffer *buf)
+{
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) == RING_SLOTS)
+    {
+        sched_yield();
+    }
+    ring->slots[tail % RING_SLOTS] = *buf;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static double bench_local(void *ctx, uint64_t iterations)
+{
+    pool_ctx *p = (pool_ctx *)ctx;
+    double bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        bond_buffer buf;
+        open_buffer(&buf, p->mode);
+        serialize_message(&buf, i);
+        bytes = (double)buf.size;
+        bench_sink += buf.data[0];
+        if (p->mode == ALLOC_POOL)
+        {
+            bond_buffer_release(&buf);
+        }
+        else
+        {
+            bond_buffer_destroy(&buf);
+        }
+    }
+    return bytes;
+}
+
+static double bench_handoff(void *ctx, uint64_t iterations)
+{
+    pool_ctx *p = (pool_ctx *)ctx;
+    pthread_t threads[MAX_CONSUMERS];
+    for (uint32_t c = 0; c < p->consumers; c++)
+    {
+        atomic_store(&rings[c].head, 0);
+        atomic_store(&rings[c].tail, 0);
+        atomic_store(&rings[c].done, false);
+        rings[c].mode = p->mode;
+        rings[c].owner = bond_buffer_pool_current();
+        pthread_create(&threads[c], NULL, consume, &rings[c]);
+    }
+
+    double bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+    {
+        bond_buffer buf;
+        open_buffer(&buf, p->mode);
+        serialize_message(&buf, i);
+        bytes = (double)buf.size;
+        produce(&rings[i % p->consumers], &buf);
+    }
+
+    for (uint32_t c = 0; c < p->consumers; c++)
+    {
+        atomic_store_explicit(&rings[c].done, true, memory_order_release);
+    }
+    for (uint32_t c = 0; c < p->consumers; c++)
+    {
+        pthread_join(threads[c], NULL);
+        bench_sink += rings[c].sink;
+    }
+    return bytes;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static void setup_cases(void)
+{
+    memset(payload, 'x', sizeof(payload) - 1);
+    for (size_t i = 0; i < CASE_COUNT; i++)
+    {
+        pool_ctx *p = &contexts[i];
+        const char *alloc = p->mode == ALLOC_POOL ? "pool" : "malloc";
+        if (p->consumers == 0)
+        {
+            snprintf(case_names[i], sizeof(case_names[i]), "pool/local/%s", alloc);
+        }
+        else
+        {
+            snprintf(case_names[i], sizeof(case_names[i]), "pool/handoff/%s/%uconsumers",
+                     alloc, p->consumers);
+        }
+        cases[i].name = case_names[i];
+        cases[i].fn = p->consumers == 0 ? bench_local : bench_handoff;
+        cases[i].ctx = p;
+        cases[i].prepare = NULL;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options;
+    bench_options_init(&options);
+    for (int i = 1; i < argc; i++)
+    {
+        if (!bench_parse_option(argv[i], &options))
+        {
+            fprintf(stderr, "usage: %s [options]\n", argv[0]);
+            bench_print_usage();
+            return 2;
+        }
+    }
+
+    setup_cases();
+    int status = bench_run("bond_pool_bench", cases, CASE_COUNT, &options);
+    bond_buffer_pool_trim();
+    return status;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file bond_copy.h
+ * @brief Raw passthrough copy of encoded values from a reader to a writer
+ *
+ * Like Bond's bonded<T>: a nested value is never decoded, only delimited with
+ * bond_reader_skip and appended to the output as one block of bytes. Useful
+ * for proxies that rewrite a few envelope fields around a large payload.
+ */
+
+#ifndef BOND_COPY_H
+#define BOND_COPY_H
+
+#include "bond_reader.h"
+#include "bond_writer.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Copy one value of the given type verbatim
+ *
+ * @param reader  Reader positioned at the value (after its field header)
+ * @param writer  Writer to append the encoded bytes to
+ * @param type    The value's BondDataType
+ * @return false if the value is malformed or truncated; nothing is written
+ */
+bool bond_copy_value(BondReader *reader, bond_writer *writer, uint8_t type);
+
+/**
+ * Copy one field's value verbatim under a (possibly different) field ID
+ *
+ * Writes a new field header for `field_id`, then the value bytes.
+ *
+ * @param reader    Reader positioned at the value (after its field header)
+ * @param writer    Writer to append to
+ * @param field_id  Field ID to emit
+ * @param type      The value's BondDataType
+ * @return false if the value is malformed or truncated; nothing is written
+ */
+bool bond_copy_field(BondReader *reader, bond_writer *writer,
+                     uint16_t field_id, uint8_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_COPY_H
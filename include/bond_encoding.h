@@ -10,6 +10,20 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// Host Byte Order
+// ============================================================================
+
+/**
+ * Defined when the host is big-endian. Bond's wire format is little-endian,
+ * so fixed-width values can be copied verbatim unless this is set.
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BOND_BIG_ENDIAN 1
+#endif
 
 // ============================================================================
 // Varint Encoding (LEB128)
@@ -74,4 +88,46 @@ void bond_encode_double(uint8_t *out, double value);
 float bond_decode_float(const uint8_t *data);
 double bond_decode_double(const uint8_t *data);
 
+/**
+ * Copy `count` 4-byte / 8-byte values between host order and little-endian
+ * wire order (the conversion is its own inverse, so one helper serves both
+ * directions). A single memcpy on little-endian hosts; on big-endian hosts a
+ * plain byte-swap loop the compiler turns into vector shuffles.
+ */
+static inline void bond_copy_le32(void *dst, const void *src, size_t count)
+{
+#ifdef BOND_BIG_ENDIAN
+    uint32_t word;
+    for (size_t i = 0; i < count; i++)
+    {
+        memcpy(&word, (const uint8_t *)src + i * 4, 4);
+        word = __builtin_bswap32(word);
+        memcpy((uint8_t *)dst + i * 4, &word, 4);
+    }
+#else
+    if (count > 0)
+    {
+        memcpy(dst, src, count * 4);
+    }
+#endif
+}
+
+static inline void bond_copy_le64(void *dst, const void *src, size_t count)
+{
+#ifdef BOND_BIG_ENDIAN
+    uint64_t word;
+    for (size_t i = 0; i < count; i++)
+    {
+        memcpy(&word, (const uint8_t *)src + i * 8, 8);
+        word = __builtin_bswap64(word);
+        memcpy((uint8_t *)dst + i * 8, &word, 8);
+    }
+#else
+    if (count > 0)
+    {
+        memcpy(dst, src, count * 8);
+    }
+#endif
+}
+
 #endif // BOND_ENCODING_H
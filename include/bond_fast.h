@@ -0,0 +1,152 @@
+/**
+ * @file bond_fast.h
+ * @brief FastBinary v1 writer and reader
+ *
+ * Same API shape as bond_writer / BondReader, different wire format:
+ *   - Field header: [type:8][id:16 LE] (always 3 bytes), STOP is one byte
+ *   - Integers: fixed-width little-endian (no varint, no zigzag)
+ *   - bool, float, double: as in CompactBinary
+ *   - String/wstring lengths and container counts: varint32
+ *
+ * Fixed-width values decode with one bounds check and one load, at the cost
+ * of a larger payload than CompactBinary.
+ */
+
+#ifndef BOND_FAST_H
+#define BOND_FAST_H
+
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+typedef struct {
+    bond_buffer *buffer;    // Output buffer
+} bond_fast_writer;
+
+void bond_fast_writer_init(bond_fast_writer *writer, bond_buffer *buffer);
+
+/**
+ * Begin a struct (no-op, for symmetry)
+ */
+void bond_fast_writer_struct_begin(bond_fast_writer *writer);
+
+/**
+ * End a struct - writes BT_STOP
+ */
+void bond_fast_writer_struct_end(bond_fast_writer *writer);
+
+/**
+ * End the base part of a derived struct - writes BT_STOP_BASE
+ */
+void bond_fast_writer_base_end(bond_fast_writer *writer);
+
+/**
+ * Write field header: [type:8][id_lo:8][id_hi:8]
+ */
+void bond_fast_writer_write_field_header(bond_fast_writer *writer, uint16_t field_id,
+                                         BondDataType type);
+
+// Primitive writers (with field header)
+void bond_fast_writer_write_bool(bond_fast_writer *writer, uint16_t field_id, bool value);
+void bond_fast_writer_write_uint8(bond_fast_writer *writer, uint16_t field_id, uint8_t value);
+void bond_fast_writer_write_uint16(bond_fast_writer *writer, uint16_t field_id, uint16_t value);
+void bond_fast_writer_write_uint32(bond_fast_writer *writer, uint16_t field_id, uint32_t value);
+void bond_fast_writer_write_uint64(bond_fast_writer *writer, uint16_t field_id, uint64_t value);
+void bond_fast_writer_write_int8(bond_fast_writer *writer, uint16_t field_id, int8_t value);
+void bond_fast_writer_write_int16(bond_fast_writer *writer, uint16_t field_id, int16_t value);
+void bond_fast_writer_write_int32(bond_fast_writer *writer, uint16_t field_id, int32_t value);
+void bond_fast_writer_write_int64(bond_fast_writer *writer, uint16_t field_id, int64_t value);
+void bond_fast_writer_write_float(bond_fast_writer *writer, uint16_t field_id, float value);
+void bond_fast_writer_write_double(bond_fast_writer *writer, uint16_t field_id, double value);
+void bond_fast_writer_write_string(bond_fast_writer *writer, uint16_t field_id, const char *value);
+
+// Container headers
+void bond_fast_writer_write_list_begin(bond_fast_writer *writer, uint16_t field_id,
+                                       BondDataType element_type, uint32_t count);
+void bond_fast_writer_write_set_begin(bond_fast_writer *writer, uint16_t field_id,
+                                      BondDataType element_type, uint32_t count);
+void bond_fast_writer_write_map_begin(bond_fast_writer *writer, uint16_t field_id,
+                                      BondDataType key_type, BondDataType value_type,
+                                      uint32_t count);
+
+// Raw value writers (no field header - for container elements)
+void bond_fast_writer_write_bool_value(bond_fast_writer *writer, bool value);
+void bond_fast_writer_write_uint8_value(bond_fast_writer *writer, uint8_t value);
+void bond_fast_writer_write_uint16_value(bond_fast_writer *writer, uint16_t value);
+void bond_fast_writer_write_uint32_value(bond_fast_writer *writer, uint32_t value);
+void bond_fast_writer_write_uint64_value(bond_fast_writer *writer, uint64_t value);
+void bond_fast_writer_write_int8_value(bond_fast_writer *writer, int8_t value);
+void bond_fast_writer_write_int16_value(bond_fast_writer *writer, int16_t value);
+void bond_fast_writer_write_int32_value(bond_fast_writer *writer, int32_t value);
+void bond_fast_writer_write_int64_value(bond_fast_writer *writer, int64_t value);
+void bond_fast_writer_write_float_value(bond_fast_writer *writer, float value);
+void bond_fast_writer_write_double_value(bond_fast_writer *writer, double value);
+void bond_fast_writer_write_string_value(bond_fast_writer *writer, const char *value);
+void bond_fast_writer_write_wstring_value(bond_fast_writer *writer, const uint16_t *value,
+                                          uint32_t length);
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+typedef struct {
+    bond_buffer *buffer;    // Uses buffer's read_pos, data, size
+} BondFastReader;
+
+void bond_fast_reader_init(BondFastReader *reader, bond_buffer *buffer);
+
+/**
+ * Read the next field header
+ *
+ * STOP and STOP_BASE are a lone type byte; field_id is set to 0 for them.
+ */
+bool bond_fast_reader_read_field_header(BondFastReader *reader, uint16_t *field_id, uint8_t *type);
+
+bool bond_fast_reader_read_bool_value(BondFastReader *reader, bool *value);
+bool bond_fast_reader_read_uint8_value(BondFastReader *reader, uint8_t *value);
+bool bond_fast_reader_read_uint16_value(BondFastReader *reader, uint16_t *value);
+bool bond_fast_reader_read_uint32_value(BondFastReader *reader, uint32_t *value);
+bool bond_fast_reader_read_uint64_value(BondFastReader *reader, uint64_t *value);
+bool bond_fast_reader_read_int8_value(BondFastReader *reader, int8_t *value);
+bool bond_fast_reader_read_int16_value(BondFastReader *reader, int16_t *value);
+bool bond_fast_reader_read_int32_value(BondFastReader *reader, int32_t *value);
+bool bond_fast_reader_read_int64_value(BondFastReader *reader, int64_t *value);
+bool bond_fast_reader_read_float_value(BondFastReader *reader, float *value);
+bool bond_fast_reader_read_double_value(BondFastReader *reader, double *value);
+
+/**
+ * Read a string value (zero-copy, NOT null-terminated)
+ */
+bool bond_fast_reader_read_string_value(BondFastReader *reader, const char **str, uint32_t *len);
+
+/**
+ * Read a wstring value (zero-copy UTF-16LE, length in code units)
+ */
+bool bond_fast_reader_read_wstring_value(BondFastReader *reader, const uint8_t **units,
+                                         uint32_t *length);
+
+bool bond_fast_reader_read_list_begin(BondFastReader *reader, uint8_t *element_type, uint32_t *count);
+bool bond_fast_reader_read_set_begin(BondFastReader *reader, uint8_t *element_type, uint32_t *count);
+bool bond_fast_reader_read_map_begin(BondFastReader *reader, uint8_t *key_type,
+                                     uint8_t *value_type, uint32_t *count);
+
+/**
+ * Skip a value of the given type (nested structs and containers included)
+ */
+bool bond_fast_reader_skip(BondFastReader *reader, uint8_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_FAST_H
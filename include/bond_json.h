@@ -0,0 +1,95 @@
+/**
+ * @file bond_json.h
+ * @brief CompactBinary v1 <-> SimpleJSON transcoding
+ *
+ * JSON layout follows Bond's SimpleJSON protocol:
+ *   - struct: object; fields of base structs are merged into the same object
+ *   - list/set: array
+ *   - map: flat array of alternating keys and values [k1, v1, k2, v2, ...]
+ *   - wstring: JSON string (UTF-8)
+ *   - NaN / infinities: the strings "NaN", "Infinity", "-Infinity"
+ * Object keys are field names from a schema descriptor, or the decimal field
+ * ID when there is none.
+ */
+
+#ifndef BOND_JSON_H
+#define BOND_JSON_H
+
+#include "bond_buffer.h"
+#include "bond_reader.h"
+#include "bond_schema.h"
+#include "bond_writer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_JSON_MAX_DEPTH 64              // Max nesting of structs and containers
+#define BOND_JSON_DEFAULT_FLUSH_THRESHOLD (64 * 1024)
+
+// ============================================================================
+// CompactBinary -> JSON
+// ============================================================================
+
+/**
+ * Streaming sink: receives output whenever the buffer fills up
+ *
+ * @return false to abort transcoding
+ */
+typedef bool (*bond_json_flush_fn)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    const BondSchemaStruct *schema;         // Field names, or NULL for field IDs
+    bond_json_flush_fn flush;               // NULL: keep all output in the buffer
+    void *flush_ctx;                        // Passed to flush
+    size_t flush_threshold;                 // Flush at this many bytes (0 = default)
+} BondJsonOptions;
+
+/**
+ * Transcode one CompactBinary struct to JSON text
+ *
+ * Output is appended to `out`. With a flush callback, `out` is handed to it
+ * and emptied every time it reaches the threshold, and once more at the end,
+ * so memory use stays bounded for any input size.
+ *
+ * @param reader   Reader positioned at the struct
+ * @param options  Options, or NULL for field IDs and no streaming
+ * @param out      Output buffer
+ * @return false on malformed input (including a string that is not valid
+ *         UTF-8 or a wstring that is not valid UTF-16), too deep nesting, or
+ *         a failed flush (output written so far is not rolled back)
+ */
+bool bond_json_from_compact(BondReader *reader, const BondJsonOptions *options,
+                            bond_buffer *out);
+
+// ============================================================================
+// JSON -> CompactBinary
+// ============================================================================
+
+/**
+ * Transcode one SimpleJSON object to a CompactBinary struct
+ *
+ * Field IDs and wire types come from the schema. Keys may be field names or
+ * decimal field IDs; keys the schema does not know and null values are
+ * skipped. The input is tokenized in place with no allocation; containers
+ * are written with deferred counts. Objects of derived structs are scanned
+ * once per inheritance level to put base fields first.
+ *
+ * @param json    JSON text (need not be null-terminated)
+ * @param len     Length of json in bytes
+ * @param schema  Struct definition (required)
+ * @param writer  Writer to append the struct to
+ * @return false on malformed JSON, invalid UTF-8, a value that does not fit
+ *         its field type, or too deep nesting (output is rolled back)
+ */
+bool bond_json_to_compact(const char *json, size_t len, const BondSchemaStruct *schema,
+                          bond_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_JSON_H
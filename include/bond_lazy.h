@@ -0,0 +1,123 @@
+/**
+ * @file bond_lazy.h
+ * @brief Lazy on-demand DOM over CompactBinary v1 payloads
+ *
+ * Nested structs and containers are recorded as (type, offset) handles and
+ * only parsed the first time they are accessed. Expanding a node walks its
+ * direct children once with bond_reader_skip and caches every child's start
+ * and end offset, so later accesses to the same level never re-scan.
+ */
+
+#ifndef BOND_LAZY_H
+#define BOND_LAZY_H
+
+#include "bond_buffer.h"
+#include "bond_reader.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Document Nodes
+// ============================================================================
+
+typedef struct BondLazyNode BondLazyNode;
+
+struct BondLazyNode {
+    uint8_t type;            // BondDataType of this value
+    uint8_t key_type;        // Map key type (maps only)
+    uint8_t element_type;    // List/set element type, map value type
+    bool expanded;           // True once children have been parsed
+    uint16_t field_id;       // Field ID (struct members only)
+    uint32_t child_count;    // Fields, elements, or 2 * pairs for maps
+    size_t offset;           // Start of the value bytes (after any field header)
+    size_t end;              // End of the value bytes, 0 until first traversed
+    BondLazyNode *children;  // Parsed children, NULL until expanded
+};
+
+typedef struct {
+    const uint8_t *data;     // Payload bytes (not owned)
+    size_t size;             // Payload size
+    BondLazyNode root;       // Top-level struct
+} BondLazyDoc;
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+/**
+ * Create a document over a serialized struct
+ *
+ * The root struct starts at the buffer's current read position. Nothing is
+ * parsed here. The buffer's bytes must stay alive as long as the document.
+ */
+void bond_lazy_doc_init(BondLazyDoc *doc, const bond_buffer *buffer);
+
+/**
+ * Free every expanded node (does not touch the payload bytes)
+ */
+void bond_lazy_doc_destroy(BondLazyDoc *doc);
+
+/**
+ * Get the root struct node
+ */
+BondLazyNode *bond_lazy_root(BondLazyDoc *doc);
+
+// ============================================================================
+// Navigation (expands the node on first access)
+// ============================================================================
+
+/**
+ * Find a field of a struct node
+ *
+ * @return The field node, or NULL if absent, not a struct, or malformed
+ */
+BondLazyNode *bond_lazy_field(BondLazyDoc *doc, BondLazyNode *node, uint16_t field_id);
+
+/**
+ * Number of fields (struct), elements (list/set) or pairs (map)
+ *
+ * @return true on success, false if the node is malformed or not expandable
+ */
+bool bond_lazy_count(BondLazyDoc *doc, BondLazyNode *node, uint32_t *count);
+
+/**
+ * Get the index-th field of a struct or element of a list/set
+ */
+BondLazyNode *bond_lazy_child(BondLazyDoc *doc, BondLazyNode *node, uint32_t index);
+
+/**
+ * Get the key or value of the index-th map pair
+ */
+BondLazyNode *bond_lazy_map_key(BondLazyDoc *doc, BondLazyNode *node, uint32_t index);
+BondLazyNode *bond_lazy_map_value(BondLazyDoc *doc, BondLazyNode *node, uint32_t index);
+
+// ============================================================================
+// Value Access
+// ============================================================================
+
+/**
+ * Position a reader at a node's value
+ *
+ * Wraps the document bytes in `view` and points `reader` at the node, so the
+ * regular bond_reader_read_*_value functions can decode it (zero-copy for
+ * strings). For container nodes the reader starts at the container header.
+ */
+void bond_lazy_reader(const BondLazyDoc *doc, const BondLazyNode *node,
+                      bond_buffer *view, BondReader *reader);
+
+/**
+ * Get the end offset of a node's value, skipping it once if not yet known
+ */
+bool bond_lazy_end(BondLazyDoc *doc, BondLazyNode *node, size_t *end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_LAZY_H
@@ -13,5 +13,21 @@
 #include "bond_encoding.h"
 #include "bond_writer.h"
 #include "bond_reader.h"
+#include "bond_lazy.h"
+#include "bond_validate.h"
+#include "bond_unicode.h"
+#include "bond_copy.h"
+#include "bond_patch.h"
+#include "bond_fast.h"
+#include "bond_schema.h"
+#include "bond_simple.h"
+#include "bond_marshal.h"
+#include "bond_json.h"
+#include "bond_transcode.h"
+#include "bond_stats.h"
+#include "bond_pool.h"
+#ifdef BOND_LITE_HAS_PARALLEL
+#include "bond_parallel.h"
+#endif
 
 #endif /* BOND_LITE_H */
@@ -0,0 +1,82 @@
+/**
+ * @file bond_marshal.h
+ * @brief Marshaled payloads: protocol + version header with auto-detection
+ *
+ * A marshaled payload is prefixed with the protocol that encoded it:
+ *   [protocol: uint16 LE][version: uint16 LE][payload...]
+ * so a receiver can pick the right reader without out-of-band config.
+ */
+
+#ifndef BOND_MARSHAL_H
+#define BOND_MARSHAL_H
+
+#include "bond_buffer.h"
+#include "bond_fast.h"
+#include "bond_reader.h"
+#include "bond_simple.h"
+#include "bond_transcode.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_MARSHAL_HEADER_SIZE 4
+
+/**
+ * Reader for an unmarshaled payload; `protocol` selects the union member
+ *
+ * CompactBinary v2 payloads get the compact reader too, but BondReader
+ * parses v1 only: check `version` and re-encode with
+ * bond_compact_transcode(&reader.compact, BOND_COMPACT_VERSION_2,
+ * BOND_COMPACT_VERSION_1, ...) before reading fields.
+ */
+typedef struct {
+    BondProtocolType protocol;      // BOND_PROTOCOL_COMPACT, _FAST or _SIMPLE
+    uint16_t version;               // Protocol version from the header
+    union {
+        BondReader compact;         // BOND_PROTOCOL_COMPACT
+        BondFastReader fast;        // BOND_PROTOCOL_FAST
+        BondSimpleReader simple;    // BOND_PROTOCOL_SIMPLE
+    } reader;
+} BondUnmarshaled;
+
+/**
+ * Write the marshaling header; the payload is then written with the writer
+ * matching `protocol`
+ */
+void bond_marshal_begin(bond_buffer *buffer, BondProtocolType protocol, uint16_t version);
+
+/**
+ * Write the marshaling header followed by an already-encoded payload
+ *
+ * @return false on allocation failure (buffer size unchanged)
+ */
+bool bond_marshal(bond_buffer *buffer, BondProtocolType protocol, uint16_t version,
+                  const uint8_t *payload, size_t len);
+
+/**
+ * Check whether a protocol/version pair can be unmarshaled by this library
+ *
+ * Supported: CompactBinary v1 and v2, FastBinary v1, SimpleBinary v1 and v2.
+ */
+bool bond_marshal_supported(BondProtocolType protocol, uint16_t version);
+
+/**
+ * Read the header at the buffer's read position and set up the matching reader
+ *
+ * On success the reader is positioned at the start of the payload.
+ *
+ * @return false if the header is truncated or names an unsupported
+ *         protocol/version (read position unchanged)
+ */
+bool bond_unmarshal(bond_buffer *buffer, BondUnmarshaled *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_MARSHAL_H
@@ -0,0 +1,140 @@
+/**
+ * @file bond_parallel.h
+ * @brief Multi-threaded serialization and decoding of large lists
+ *
+ * A bond_thread_pool is a fixed set of worker threads that run one job at a
+ * time; the calling thread takes part as worker 0. On top of it,
+ * bond_writer_write_struct_list_parallel() serializes list<struct> elements
+ * on all workers and stitches the results behind the list header, and
+ * bond_reader_read_list_parallel() finds element boundaries in one skip-only
+ * pass and then hands elements to a callback on all workers.
+ *
+ * Available where the build finds POSIX threads (BOND_LITE_HAS_PARALLEL is
+ * defined by CMake then).
+ */
+
+#ifndef BOND_PARALLEL_H
+#define BOND_PARALLEL_H
+
+#include "bond_reader.h"
+#include "bond_writer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct bond_thread_pool bond_thread_pool;
+
+/**
+ * Job body, called once on every worker with its index
+ * (0 .. bond_thread_pool_size() - 1; 0 is the thread that called run)
+ */
+typedef void (*bond_parallel_fn)(void *arg, unsigned worker);
+
+/**
+ * Serialize element `index` of `items`
+ *
+ * Writes the element's fields only; the STOP marker is added by the caller.
+ * Called concurrently on different writers, so it must not touch shared
+ * mutable state.
+ *
+ * @return false to abort the whole list
+ */
+typedef bool (*bond_struct_list_fn)(bond_writer *writer, const void *items, size_t index);
+
+/**
+ * Decode element `index` of a list
+ *
+ * `reader` covers exactly the element's bytes, positioned at its start
+ * (for structs: at the first field header). Called concurrently; results
+ * usually go to slot `index` of an output array in `ctx`.
+ *
+ * @return false to abort the whole list
+ */
+typedef bool (*bond_list_element_fn)(BondReader *reader, uint32_t index, void *ctx);
+
+// ============================================================================
+// Thread Pool
+// ============================================================================
+
+/**
+ * Start a pool of `workers` participants (workers - 1 threads)
+ *
+ * @param workers  0 for one per online CPU
+ * @return NULL on failure
+ */
+bond_thread_pool *bond_thread_pool_create(unsigned workers);
+
+/**
+ * Stop and join the threads; no job may be running
+ */
+void bond_thread_pool_destroy(bond_thread_pool *pool);
+
+/**
+ * Number of participants, including the calling thread
+ */
+unsigned bond_thread_pool_size(const bond_thread_pool *pool);
+
+/**
+ * Run fn(arg, worker) on every participant and wait for all of them
+ *
+ * One job at a time per pool; do not call from inside a job.
+ */
+void bond_thread_pool_run(bond_thread_pool *pool, bond_parallel_fn fn, void *arg);
+
+// ============================================================================
+// Parallel Writers
+// ============================================================================
+
+/**
+ * Write a list<struct> field, serializing elements on all pool workers
+ *
+ * Elements are claimed in small chunks from a shared counter, so workers
+ * that draw cheap elements simply take more chunks. Each chunk is written
+ * to a pooled buffer (bond_pool.h); once all are done, workers copy their
+ * chunks into place behind the list header in parallel. The output is
+ * byte-identical to writing the list sequentially.
+ *
+ * With a NULL pool or a short list the elements are written in place on
+ * the calling thread.
+ *
+ * @return false if serialize_fn failed or memory ran out; the buffer is
+ *         rolled back to its size before the call
+ */
+bool bond_writer_write_struct_list_parallel(bond_writer *writer, uint16_t field_id,
+                                            const void *items, uint32_t count,
+                                            bond_struct_list_fn serialize_fn,
+                                            bond_thread_pool *pool);
+
+// ============================================================================
+// Parallel Readers
+// ============================================================================
+
+/**
+ * Decode every element of a list on all pool workers
+ *
+ * Call right after bond_reader_read_list_begin() or
+ * bond_reader_read_set_begin(). Element boundaries are found first with
+ * bond_reader_list_offsets() on the calling thread; elements are then
+ * claimed in chunks by the workers and passed to element_fn in no
+ * particular order. The reader's flags apply to every element reader.
+ *
+ * With a NULL pool or a short list every element is decoded on the calling
+ * thread, in order.
+ *
+ * @return false on a malformed list, allocation failure, or element_fn
+ *         returning false; the read position is then unchanged. On success
+ *         the reader is past the list.
+ */
+bool bond_reader_read_list_parallel(BondReader *reader, uint8_t element_type,
+                                    uint32_t count, bond_list_element_fn element_fn,
+                                    void *ctx, bond_thread_pool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_PARALLEL_H
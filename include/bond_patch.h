@@ -0,0 +1,115 @@
+/**
+ * @file bond_patch.h
+ * @brief In-place patching of top-level fields in serialized structs
+ *
+ * A BondPatchIndex records where each top-level field's value lives. A
+ * patch re-encodes one value: if the new encoding has the same length it is
+ * overwritten in place, otherwise the bytes after it are moved with one
+ * memmove and the index offsets after it are shifted. No other part of the
+ * payload is decoded or re-encoded.
+ */
+
+#ifndef BOND_PATCH_H
+#define BOND_PATCH_H
+
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Field Index
+// ============================================================================
+
+typedef struct {
+    uint16_t field_id;      // Field ID
+    uint8_t type;           // BondDataType of the value
+    size_t offset;          // Start of the value bytes (after the field header)
+    size_t end;             // One past the last value byte
+} BondPatchField;
+
+typedef struct {
+    BondPatchField *fields; // Top-level fields in wire order
+    uint32_t count;         // Number of fields
+} BondPatchIndex;
+
+/**
+ * Index the top-level fields of the struct at the buffer's read position
+ *
+ * Fields of every level of an inheritance chain are included (scanning
+ * continues past STOP_BASE up to the final STOP).
+ *
+ * @return false if the payload is malformed or allocation fails
+ */
+bool bond_patch_index_build(BondPatchIndex *index, const bond_buffer *buffer);
+
+/**
+ * Free the index
+ */
+void bond_patch_index_destroy(BondPatchIndex *index);
+
+/**
+ * Find a field (first occurrence) in the index
+ *
+ * @return The field, or NULL if absent
+ */
+const BondPatchField *bond_patch_index_find(const BondPatchIndex *index, uint16_t field_id);
+
+// ============================================================================
+// Patching
+// ============================================================================
+//
+// Every patch function takes an optional index. With an index the field is
+// looked up without scanning and the index is kept in sync with any splice;
+// with NULL the struct at the buffer's read position is scanned for it.
+// On failure the buffer is left untouched. Values may point into the buffer
+// itself (say, a string read zero-copy from another field); such values are
+// copied before the buffer moves.
+
+/**
+ * Replace a field's value with already-encoded bytes (same wire type)
+ *
+ * @return false if the field is absent, the payload is malformed or growing
+ *         the buffer fails
+ */
+bool bond_patch_raw(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                    const uint8_t *value, size_t len);
+
+/**
+ * Set an unsigned integer field (bool, uint8/16/32/64)
+ * @return false if absent, of another type, or `value` does not fit the type
+ */
+bool bond_patch_uint(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                     uint64_t value);
+
+/**
+ * Set a signed integer field (int8/16/32/64)
+ * @return false if absent, of another type, or `value` does not fit the type
+ */
+bool bond_patch_int(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                    int64_t value);
+
+/**
+ * Set a float or double field
+ * @return false if absent or of another type
+ */
+bool bond_patch_double(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                       double value);
+
+/**
+ * Set a string field
+ * @return false if absent or of another type
+ */
+bool bond_patch_string(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                       const char *value, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_PATCH_H
@@ -0,0 +1,159 @@
+/**
+ * @file bond_pool.h
+ * @brief Thread-local pooling of bond_buffer memory
+ *
+ * bond_buffer_acquire() hands out a buffer whose memory comes from the
+ * calling thread's freelists when possible; bond_buffer_release() puts it
+ * back instead of freeing it. Freelists are bucketed by power-of-two
+ * capacity class from BOND_POOL_MIN_CAPACITY to BOND_POOL_MAX_CAPACITY, and
+ * the bytes a thread keeps are capped (BOND_POOL_DEFAULT_LIMIT unless
+ * changed), so steady-state request handling allocates nothing.
+ *
+ * A bond_buffer_site placed at a call site learns how big its buffers end
+ * up, so later acquisitions start at that capacity and skip the growth
+ * reallocations:
+ *
+ *   static bond_buffer_site response_site;
+ *   bond_buffer out;
+ *   bond_buffer_acquire_at(&out, &response_site);
+ *   ... serialize, send ...
+ *   bond_buffer_release_at(&out, &response_site);
+ *
+ * bond_buffer_release() files memory in the calling thread's pool. When a
+ * buffer is handed to another thread (e.g. an I/O thread that sends it),
+ * release it with bond_buffer_release_to() and the producer's pool handle
+ * instead: the block goes back to the producer through a lock-free inbox,
+ * with no mutex and no cross-thread free():
+ *
+ *   // Producer
+ *   msg->owner = bond_buffer_pool_current();
+ *   bond_buffer_acquire(&msg->buf, n);
+ *   ... serialize, enqueue msg ...
+ *
+ *   // I/O thread
+ *   send(fd, msg->buf.data, msg->buf.size, 0);
+ *   bond_buffer_release_to(&msg->buf, msg->owner);
+ */
+
+#ifndef BOND_POOL_H
+#define BOND_POOL_H
+
+#include "bond_buffer.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_POOL_MIN_CAPACITY 256                      // Smallest class
+#define BOND_POOL_MAX_CAPACITY (4 * 1024 * 1024)        // Larger buffers are not kept
+#define BOND_POOL_DEFAULT_LIMIT (8 * 1024 * 1024)       // Retained bytes per thread
+
+/**
+ * One thread's pool, as a target for bond_buffer_release_to()
+ */
+typedef struct bond_buffer_pool bond_buffer_pool;
+
+/**
+ * Learned size for one call site
+ *
+ * Zero-initialize (a static does that). Safe to share between threads as
+ * long as `typical` is only touched through the functions below.
+ */
+typedef struct {
+    size_t typical;         // Capacity to start with; follows release sizes
+} bond_buffer_site;
+
+// ============================================================================
+// Acquire / Release
+// ============================================================================
+
+/**
+ * Initialize `buf` with at least `size_hint` bytes of capacity
+ *
+ * Takes memory from the calling thread's pool when a large enough buffer is
+ * cached, otherwise allocates a full capacity class.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+int bond_buffer_acquire(bond_buffer *buf, size_t size_hint);
+
+/**
+ * Acquire with the capacity learned at `site`
+ */
+int bond_buffer_acquire_at(bond_buffer *buf, bond_buffer_site *site);
+
+/**
+ * Return the memory of `buf` to the calling thread's pool and reset `buf`
+ *
+ * Memory is freed instead when the buffer does not own it, is outside the
+ * pooled classes, or would push the thread over its retention limit.
+ * Any owned buffer may be released, not only acquired ones.
+ */
+void bond_buffer_release(bond_buffer *buf);
+
+/**
+ * Release and teach `site` the size this buffer reached
+ *
+ * Growth is adopted at once; shrinking decays slowly, so an occasional
+ * small message does not cost the next large one a reallocation.
+ */
+void bond_buffer_release_at(bond_buffer *buf, bond_buffer_site *site);
+
+/**
+ * Return the memory of `buf` to `owner`'s pool from any thread and reset `buf`
+ *
+ * Lock-free: the block is pushed onto the owner's inbox and filed by the
+ * owner on its next pool miss or bond_buffer_pool_collect(); the retention
+ * limit is applied then. Releasing to the calling thread's own pool (or to
+ * NULL) is bond_buffer_release(). `owner` must not have exited.
+ */
+void bond_buffer_release_to(bond_buffer *buf, bond_buffer_pool *owner);
+
+// ============================================================================
+// Pool Control
+// ============================================================================
+
+/**
+ * The calling thread's pool
+ *
+ * Valid until the thread exits; pass it along with buffers that another
+ * thread will release.
+ */
+bond_buffer_pool *bond_buffer_pool_current(void);
+
+/**
+ * File buffers other threads returned to the calling thread's pool
+ *
+ * Acquire does this on a miss, so calling it is only needed to bring
+ * bond_buffer_pool_retained() up to date.
+ *
+ * @return Number of buffers taken from the inbox
+ */
+size_t bond_buffer_pool_collect(void);
+
+/**
+ * Set the per-thread retention limit in bytes (0 disables pooling)
+ *
+ * Applies to all threads; call before worker threads start.
+ */
+void bond_buffer_pool_set_limit(size_t bytes);
+
+/**
+ * Bytes currently cached by the calling thread
+ */
+size_t bond_buffer_pool_retained(void);
+
+/**
+ * Free everything cached by the calling thread, including its inbox
+ *
+ * Call before a thread exits, or its cached memory is leaked. Other threads
+ * must be done releasing to it by then.
+ */
+void bond_buffer_pool_trim(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_POOL_H
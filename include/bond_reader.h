@@ -23,8 +23,12 @@ extern "C" {
 // Reader State
 // ============================================================================
 
+// Reader option flags
+#define BOND_READER_VALIDATE_UTF8  0x1u  // Reject strings that are not valid UTF-8
+
 typedef struct {
     bond_buffer *buffer;   // Uses buffer's read_pos, data, size
+    uint32_t flags;        // BOND_READER_* options (0 by default)
 } BondReader;
 
 // ============================================================================
@@ -39,6 +43,14 @@ typedef struct {
  */
 void bond_reader_init(BondReader *reader, bond_buffer *buffer);
 
+/**
+ * Set reader options (BOND_READER_* flags)
+ *
+ * With BOND_READER_VALIDATE_UTF8, bond_reader_read_string_value() fails on
+ * malformed UTF-8 instead of handing back the raw bytes.
+ */
+void bond_reader_set_flags(BondReader *reader, uint32_t flags);
+
 // ============================================================================
 // Struct Control
 // ============================================================================
@@ -95,9 +107,22 @@ bool bond_reader_read_double_value(BondReader *reader, double *value);
  * 
  * Note: The returned string points directly into the buffer.
  * It is NOT null-terminated. Copy if you need a C string.
+ * Fails on invalid UTF-8 if BOND_READER_VALIDATE_UTF8 is set.
  */
 bool bond_reader_read_string_value(BondReader *reader, const char **str, uint32_t *len);
 
+/**
+ * Read a wstring value (zero-copy)
+ *
+ * @param reader  The reader
+ * @param units   Output: pointer to UTF-16LE bytes (points into buffer, unaligned)
+ * @param length  Output: length in UTF-16 code units (byte size is 2 * length)
+ * @return true on success, false on error
+ *
+ * Use bond_utf16le_to_utf8() from bond_unicode.h to convert to UTF-8.
+ */
+bool bond_reader_read_wstring_value(BondReader *reader, const uint8_t **units, uint32_t *length);
+
 // ============================================================================
 // Container Header Readers
 // ============================================================================
@@ -107,6 +132,31 @@ bool bond_reader_read_string_value(BondReader *reader, const char **str, uint32_
  */
 bool bond_reader_read_list_begin(BondReader *reader, uint8_t *element_type, uint32_t *count);
 
+/**
+ * Read a blob (list<int8> or list<uint8>) as one zero-copy byte range
+ *
+ * @param reader  The reader (positioned after a BOND_TYPE_LIST field header)
+ * @param data    Output: pointer to the bytes (points into buffer)
+ * @param len     Output: number of bytes
+ * @return false on truncation or if the element type is not int8/uint8
+ */
+bool bond_reader_read_blob(BondReader *reader, const uint8_t **data, uint32_t *len);
+
+/**
+ * Read a whole list<float> / list<double> into an array in one bulk copy
+ *
+ * @param reader     The reader (positioned after a BOND_TYPE_LIST field header)
+ * @param values     Output array
+ * @param max_count  Capacity of `values` in elements
+ * @param count      Output: number of elements (set even when it exceeds max_count)
+ * @return false on truncation, a different element type, or count > max_count.
+ *         The read position is left unchanged on failure.
+ */
+bool bond_reader_read_float_list(BondReader *reader, float *values,
+                                 uint32_t max_count, uint32_t *count);
+bool bond_reader_read_double_list(BondReader *reader, double *values,
+                                  uint32_t max_count, uint32_t *count);
+
 /**
  * Read set header (element type and count) - same wire format as list
  */
@@ -133,6 +183,28 @@ bool bond_reader_read_map_begin(BondReader *reader, uint8_t *key_type, uint8_t *
  */
 bool bond_reader_skip(BondReader *reader, uint8_t type);
 
+// ============================================================================
+// List Element Offsets
+// ============================================================================
+
+/**
+ * Find where every element of a list starts, without decoding them
+ *
+ * Call right after bond_reader_read_list_begin(). Fixed-width elements are
+ * computed rather than scanned, strings are found by hopping over their
+ * length prefixes, and other types are skipped element by element.
+ *
+ * @param reader        The reader (positioned at the first element)
+ * @param element_type  Element type from the list header
+ * @param count         Element count from the list header
+ * @param offsets       Output: count + 1 absolute buffer offsets; element i
+ *                      is [offsets[i], offsets[i + 1])
+ * @return false on truncation or a malformed element. On success the reader
+ *         is past the list; on failure the read position is unchanged.
+ */
+bool bond_reader_list_offsets(BondReader *reader, uint8_t element_type,
+                              uint32_t count, size_t *offsets);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,86 @@
+/**
+ * @file bond_schema.h
+ * @brief Runtime schema descriptors
+ *
+ * Describes a Bond struct at runtime for encodings that need the schema to
+ * decode (SimpleBinary) or to map names to field IDs. Descriptors are plain
+ * const data, normally declared statically next to the code that uses them:
+ *
+ *   static const BondSchemaField point_fields[] = {
+ *       { 0, "x", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+ *       { 1, "y", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+ *   };
+ *   static const BondSchemaStruct point = { "Point", NULL, point_fields, 2 };
+ */
+
+#ifndef BOND_SCHEMA_H
+#define BOND_SCHEMA_H
+
+#include "bond_types.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BondSchemaType BondSchemaType;
+typedef struct BondSchemaStruct BondSchemaStruct;
+
+/**
+ * Type of a field or container element
+ */
+struct BondSchemaType {
+    uint8_t id;                         // BondDataType
+    const BondSchemaType *key;          // Map key type (maps only)
+    const BondSchemaType *element;      // List/set element type, map value type
+    const BondSchemaStruct *struct_def; // Struct definition (structs only)
+};
+
+#define BOND_SCHEMA_PRIMITIVE(type_id)        { (type_id), NULL, NULL, NULL }
+#define BOND_SCHEMA_STRUCT(def)               { BOND_TYPE_STRUCT, NULL, NULL, (def) }
+#define BOND_SCHEMA_LIST(element_type)        { BOND_TYPE_LIST, NULL, (element_type), NULL }
+#define BOND_SCHEMA_SET(element_type)         { BOND_TYPE_SET, NULL, (element_type), NULL }
+#define BOND_SCHEMA_MAP(key_type, value_type) { BOND_TYPE_MAP, (key_type), (value_type), NULL }
+
+typedef struct {
+    uint16_t id;                        // Field ID
+    const char *name;                   // Field name
+    BondSchemaType type;                // Field type
+} BondSchemaField;
+
+/**
+ * Struct definition
+ *
+ * Fields are listed in ordinal order, which is the order encodings without
+ * field headers use. The base struct's fields precede these on the wire.
+ */
+struct BondSchemaStruct {
+    const char *name;                   // Struct name
+    const BondSchemaStruct *base;       // Base struct, or NULL
+    const BondSchemaField *fields;      // Fields declared by this struct
+    uint32_t field_count;               // Number of fields
+};
+
+/**
+ * Find a field declared by `def` itself (bases are not searched)
+ *
+ * @return The field, or NULL if absent
+ */
+const BondSchemaField *bond_schema_find_field(const BondSchemaStruct *def, uint16_t id);
+
+/**
+ * Find a field declared by `def` itself by name
+ *
+ * @param name  Name bytes (need not be null-terminated)
+ * @param len   Length of name in bytes
+ * @return The field, or NULL if absent
+ */
+const BondSchemaField *bond_schema_find_field_by_name(const BondSchemaStruct *def,
+                                                      const char *name, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_SCHEMA_H
@@ -0,0 +1,152 @@
+/**
+ * @file bond_simple.h
+ * @brief SimpleBinary writer, reader and schema-driven transcoding
+ *
+ * SimpleBinary has no field headers, no STOP markers and no container
+ * element types: every field of the schema is written in ordinal order
+ * (base struct first), so the payload can only be decoded with the schema.
+ *   - bool, integers, float, double: fixed-width little-endian
+ *   - string/wstring length, container count:
+ *       version 1: uint32 little-endian
+ *       version 2: varint32
+ *
+ * The writer and reader work at the value level; the schema-driven
+ * functions convert whole structs to and from CompactBinary v1 so the rest
+ * of the library (lazy DOM, validator, copy, patch) applies unchanged.
+ */
+
+#ifndef BOND_SIMPLE_H
+#define BOND_SIMPLE_H
+
+#include "bond_buffer.h"
+#include "bond_reader.h"
+#include "bond_schema.h"
+#include "bond_types.h"
+#include "bond_writer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_SIMPLE_VERSION_1 1
+#define BOND_SIMPLE_VERSION_2 2
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+typedef struct {
+    bond_buffer *buffer;    // Output buffer
+    uint16_t version;       // BOND_SIMPLE_VERSION_*
+} bond_simple_writer;
+
+void bond_simple_writer_init(bond_simple_writer *writer, bond_buffer *buffer, uint16_t version);
+
+void bond_simple_writer_write_bool_value(bond_simple_writer *writer, bool value);
+void bond_simple_writer_write_uint8_value(bond_simple_writer *writer, uint8_t value);
+void bond_simple_writer_write_uint16_value(bond_simple_writer *writer, uint16_t value);
+void bond_simple_writer_write_uint32_value(bond_simple_writer *writer, uint32_t value);
+void bond_simple_writer_write_uint64_value(bond_simple_writer *writer, uint64_t value);
+void bond_simple_writer_write_int8_value(bond_simple_writer *writer, int8_t value);
+void bond_simple_writer_write_int16_value(bond_simple_writer *writer, int16_t value);
+void bond_simple_writer_write_int32_value(bond_simple_writer *writer, int32_t value);
+void bond_simple_writer_write_int64_value(bond_simple_writer *writer, int64_t value);
+void bond_simple_writer_write_float_value(bond_simple_writer *writer, float value);
+void bond_simple_writer_write_double_value(bond_simple_writer *writer, double value);
+
+/**
+ * Write a string: [length][bytes]
+ */
+void bond_simple_writer_write_string_value(bond_simple_writer *writer, const char *value,
+                                           uint32_t len);
+
+/**
+ * Write a wstring: [length in code units][UTF-16LE units]
+ */
+void bond_simple_writer_write_wstring_value(bond_simple_writer *writer, const uint16_t *value,
+                                            uint32_t length);
+
+/**
+ * Write a list/set/map element count (no element types in SimpleBinary)
+ */
+void bond_simple_writer_write_container_begin(bond_simple_writer *writer, uint32_t count);
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+typedef struct {
+    bond_buffer *buffer;    // Uses buffer's read_pos, data, size
+    uint16_t version;       // BOND_SIMPLE_VERSION_*
+} BondSimpleReader;
+
+void bond_simple_reader_init(BondSimpleReader *reader, bond_buffer *buffer, uint16_t version);
+
+bool bond_simple_reader_read_bool_value(BondSimpleReader *reader, bool *value);
+bool bond_simple_reader_read_uint8_value(BondSimpleReader *reader, uint8_t *value);
+bool bond_simple_reader_read_uint16_value(BondSimpleReader *reader, uint16_t *value);
+bool bond_simple_reader_read_uint32_value(BondSimpleReader *reader, uint32_t *value);
+bool bond_simple_reader_read_uint64_value(BondSimpleReader *reader, uint64_t *value);
+bool bond_simple_reader_read_int8_value(BondSimpleReader *reader, int8_t *value);
+bool bond_simple_reader_read_int16_value(BondSimpleReader *reader, int16_t *value);
+bool bond_simple_reader_read_int32_value(BondSimpleReader *reader, int32_t *value);
+bool bond_simple_reader_read_int64_value(BondSimpleReader *reader, int64_t *value);
+bool bond_simple_reader_read_float_value(BondSimpleReader *reader, float *value);
+bool bond_simple_reader_read_double_value(BondSimpleReader *reader, double *value);
+
+/**
+ * Read a string value (zero-copy, NOT null-terminated)
+ */
+bool bond_simple_reader_read_string_value(BondSimpleReader *reader, const char **str, uint32_t *len);
+
+/**
+ * Read a wstring value (zero-copy UTF-16LE, length in code units)
+ */
+bool bond_simple_reader_read_wstring_value(BondSimpleReader *reader, const uint8_t **units,
+                                           uint32_t *length);
+
+/**
+ * Read a list/set/map element count
+ */
+bool bond_simple_reader_read_container_begin(BondSimpleReader *reader, uint32_t *count);
+
+/**
+ * Skip one value described by `type`
+ */
+bool bond_simple_reader_skip(BondSimpleReader *reader, const BondSchemaType *type);
+
+// ============================================================================
+// Schema-Driven Transcoding
+// ============================================================================
+
+/**
+ * Decode one SimpleBinary struct into CompactBinary v1
+ *
+ * Writes every field (base fields, STOP_BASE, own fields, STOP).
+ *
+ * @return false on truncated input
+ */
+bool bond_simple_to_compact(BondSimpleReader *reader, const BondSchemaStruct *schema,
+                            bond_writer *writer);
+
+/**
+ * Encode one CompactBinary v1 struct as SimpleBinary
+ *
+ * Fields are emitted in schema order regardless of their order on the wire.
+ * Fields absent from the input are written as zero / empty; fields not in
+ * the schema are skipped.
+ *
+ * @return false on malformed input, a wire type that does not match the
+ *         schema, or allocation failure
+ */
+bool bond_simple_from_compact(BondReader *reader, const BondSchemaStruct *schema,
+                              bond_simple_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_SIMPLE_H
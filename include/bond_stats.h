@@ -0,0 +1,125 @@
+/**
+ * @file bond_stats.h
+ * @brief Optional per-thread encode/decode counters
+ *
+ * Build with -DBOND_LITE_STATS=ON (which defines BOND_LITE_STATS) to count,
+ * per thread:
+ *   - bytes appended to and consumed from bond_buffer by the library
+ *   - bond_buffer_reserve reallocations and the bytes they had to move
+ *   - varint lengths written and read, split by value type
+ *   - bytes consumed by bond_reader_skip
+ *   - maximum struct nesting seen by the reader and writer
+ *   - bond_buffer_acquire calls served from / missing the buffer pool
+ *
+ * Without the option every counter macro expands to nothing and the
+ * snapshot API reports zeros, so callers do not need their own #ifdefs.
+ */
+
+#ifndef BOND_STATS_H
+#define BOND_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_STATS_VARINT_MAX_BYTES 10
+
+/**
+ * Varint histogram rows
+ */
+typedef enum {
+    BOND_STATS_VARINT_UINT16,
+    BOND_STATS_VARINT_UINT32,
+    BOND_STATS_VARINT_UINT64,
+    BOND_STATS_VARINT_INT16,
+    BOND_STATS_VARINT_INT32,
+    BOND_STATS_VARINT_INT64,
+    BOND_STATS_VARINT_LENGTH,       // String lengths and container counts
+    BOND_STATS_VARINT_KIND_COUNT
+} bond_stats_varint_kind;
+
+typedef struct {
+    uint64_t bytes_written;
+    uint64_t bytes_read;            // Includes bytes_skipped
+    uint64_t bytes_skipped;
+    uint64_t reserve_reallocs;
+    uint64_t reserve_bytes_copied;  // Bytes live in the buffer at each realloc
+    uint64_t pool_hits;             // Acquires served from the thread's pool
+    uint64_t pool_misses;           // Acquires that had to malloc
+    uint64_t pool_remote_releases;  // bond_buffer_release_to pushes from this thread
+    // [kind][encoded length - 1]
+    uint64_t varint_written[BOND_STATS_VARINT_KIND_COUNT][BOND_STATS_VARINT_MAX_BYTES];
+    uint64_t varint_read[BOND_STATS_VARINT_KIND_COUNT][BOND_STATS_VARINT_MAX_BYTES];
+    uint32_t depth;                 // Current struct nesting
+    uint32_t max_depth;
+} bond_stats;
+
+// ============================================================================
+// Snapshot API
+// ============================================================================
+
+/**
+ * True when the library was built with BOND_LITE_STATS
+ */
+bool bond_stats_enabled(void);
+
+/**
+ * Copy the calling thread's counters
+ */
+void bond_stats_snapshot(bond_stats *out);
+
+/**
+ * Zero the calling thread's counters
+ */
+void bond_stats_reset(void);
+
+/**
+ * Add the counters of `stats` into `total` (max_depth takes the maximum)
+ *
+ * For aggregating snapshots taken on several threads.
+ */
+void bond_stats_merge(bond_stats *total, const bond_stats *stats);
+
+// ============================================================================
+// Counter Macros (library internal)
+// ============================================================================
+
+#ifdef BOND_LITE_STATS
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define BOND_STATS_THREAD_LOCAL __declspec(thread)
+#else
+#define BOND_STATS_THREAD_LOCAL _Thread_local
+#endif
+
+extern BOND_STATS_THREAD_LOCAL bond_stats bond_stats_current;
+
+#define BOND_STATS_ADD(counter, n) (bond_stats_current.counter += (uint64_t)(n))
+#define BOND_STATS_SUB(counter, n) (bond_stats_current.counter -= (uint64_t)(n))
+#define BOND_STATS_VARINT(direction, kind, len) \
+    (bond_stats_current.direction[(kind)][(len) - 1]++)
+#define BOND_STATS_ENTER() \
+    (++bond_stats_current.depth > bond_stats_current.max_depth \
+        ? (void)(bond_stats_current.max_depth = bond_stats_current.depth) : (void)0)
+#define BOND_STATS_LEAVE() \
+    (bond_stats_current.depth > 0 ? (void)bond_stats_current.depth-- : (void)0)
+
+#else
+
+// sizeof keeps the arguments "used" without evaluating them
+#define BOND_STATS_ADD(counter, n) ((void)sizeof(n))
+#define BOND_STATS_SUB(counter, n) ((void)sizeof(n))
+#define BOND_STATS_VARINT(direction, kind, len) ((void)sizeof((kind) + (len)))
+#define BOND_STATS_ENTER() ((void)0)
+#define BOND_STATS_LEAVE() ((void)0)
+
+#endif // BOND_LITE_STATS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_STATS_H
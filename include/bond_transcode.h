@@ -0,0 +1,117 @@
+/**
+ * @file bond_transcode.h
+ * @brief CompactBinary v1 <-> v2 re-encoding
+ *
+ * CompactBinary v2 differs from v1 in two places:
+ *   - every struct (top-level, nested field or container element) is
+ *     preceded by a varint32 byte length of its body
+ *   - list/set headers with fewer than 7 elements pack the count into the
+ *     element type byte: [type | (count + 1) << 5]
+ * Everything else is byte-for-byte identical, so re-encoding copies runs of
+ * the input verbatim and only rewrites those headers. v2 struct lengths are
+ * backpatched as each struct closes; no tree is built.
+ */
+
+#ifndef BOND_TRANSCODE_H
+#define BOND_TRANSCODE_H
+
+#include "bond_buffer.h"
+#include "bond_reader.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOND_COMPACT_VERSION_1 1
+#define BOND_COMPACT_VERSION_2 2
+
+#define BOND_TRANSCODE_MAX_DEPTH 64     // Max nesting of structs and containers
+
+// ============================================================================
+// One-shot
+// ============================================================================
+
+/**
+ * Re-encode one struct between CompactBinary versions
+ *
+ * @param reader        Reader positioned at the struct; advanced past it
+ * @param from_version  BOND_COMPACT_VERSION_* of the input
+ * @param to_version    BOND_COMPACT_VERSION_* to write
+ * @param out           Output buffer (appended to)
+ * @return false on malformed or truncated input or unknown versions;
+ *         output and read position are left unchanged
+ */
+bool bond_compact_transcode(BondReader *reader, uint16_t from_version, uint16_t to_version,
+                            bond_buffer *out);
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+/**
+ * Open struct or container in a partially received struct
+ */
+typedef struct {
+    uint8_t key_type;       // Map key type; BOND_TYPE_STOP for structs
+    uint8_t value_type;     // Element or map value type
+    bool at_value;          // Map: key read, value next
+    uint32_t remaining;     // Elements (map pairs) still to come
+} BondCompactScanFrame;
+
+/**
+ * Re-encodes a stream of back-to-back structs fed in arbitrary chunks
+ *
+ * Each complete struct is converted as soon as its last byte arrives. Only
+ * the bytes of a struct that straddles a chunk boundary are kept, so memory
+ * is bounded by the largest struct rather than the stream.
+ *
+ * The end of a struct is found by a scan that resumes where the previous
+ * chunk left off (v2 input jumps over each struct by its length prefix), and
+ * the struct is converted once, when complete. Each input byte is therefore
+ * looked at a bounded number of times however finely the stream is chunked.
+ */
+typedef struct {
+    uint16_t from_version;
+    uint16_t to_version;
+    bond_buffer pending;    // Start of a struct still waiting for more bytes
+
+    // Scan state of the pending struct
+    size_t scanned;         // Bytes of it walked so far
+    uint64_t skip;          // Payload bytes still to pass over
+    uint32_t depth;         // Open frames; 0 before the struct starts
+    BondCompactScanFrame frames[BOND_TRANSCODE_MAX_DEPTH];
+} BondCompactTranscoder;
+
+/**
+ * @return false on unknown versions or allocation failure
+ */
+bool bond_compact_transcoder_init(BondCompactTranscoder *transcoder,
+                                  uint16_t from_version, uint16_t to_version);
+
+void bond_compact_transcoder_destroy(BondCompactTranscoder *transcoder);
+
+/**
+ * Convert every struct completed by this chunk
+ *
+ * Output is appended to `out`, which the caller may drain between calls.
+ *
+ * @return false on malformed input; the transcoder must not be fed again
+ */
+bool bond_compact_transcoder_feed(BondCompactTranscoder *transcoder,
+                                  const uint8_t *data, size_t len, bond_buffer *out);
+
+/**
+ * End of stream
+ *
+ * @return false if the stream ended in the middle of a struct
+ */
+bool bond_compact_transcoder_finish(BondCompactTranscoder *transcoder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_TRANSCODE_H
@@ -0,0 +1,91 @@
+/**
+ * @file bond_unicode.h
+ * @brief UTF-8 validation and UTF-16 transcoding for Bond string payloads
+ *
+ * bond_utf8_validate() picks the fastest implementation for the running CPU
+ * (AVX2, SSSE3, or portable scalar) at runtime.
+ */
+
+#ifndef BOND_UNICODE_H
+#define BOND_UNICODE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// UTF-8 Validation
+// ============================================================================
+
+/**
+ * Check that a byte range is well-formed UTF-8
+ *
+ * Rejects overlong encodings, surrogates (U+D800..U+DFFF), code points above
+ * U+10FFFF and truncated sequences.
+ *
+ * @param data  Bytes to check (may be NULL if len is 0)
+ * @param len   Number of bytes
+ * @return true if the bytes are valid UTF-8
+ */
+bool bond_utf8_validate(const uint8_t *data, size_t len);
+
+/**
+ * Portable byte-at-a-time implementation (reference for the SIMD paths)
+ */
+bool bond_utf8_validate_scalar(const uint8_t *data, size_t len);
+
+// ============================================================================
+// UTF-16 Transcoding
+// ============================================================================
+//
+// UTF-16 text is handled as little-endian bytes, exactly as it appears in a
+// Bond wstring payload, so no alignment or host byte order is assumed.
+// Runs of ASCII are converted 16 characters at a time with SSE2 on x86.
+
+/**
+ * Worst-case UTF-8 size in bytes for `units` UTF-16 code units
+ */
+#define BOND_UTF8_MAX_FROM_UTF16(units) ((size_t)(units) * 3)
+
+/**
+ * Number of UTF-16 code units needed for a UTF-8 string
+ *
+ * Assumes valid input; the transcoder still validates.
+ */
+size_t bond_utf8_utf16_length(const uint8_t *src, size_t len);
+
+/**
+ * Convert UTF-16LE to UTF-8
+ *
+ * @param src       UTF-16LE bytes (2 * units bytes)
+ * @param units     Number of code units
+ * @param dst       Output buffer
+ * @param capacity  Output capacity in bytes
+ * @param written   Output: bytes written
+ * @return false on unpaired surrogates or insufficient capacity
+ */
+bool bond_utf16le_to_utf8(const uint8_t *src, size_t units,
+                          uint8_t *dst, size_t capacity, size_t *written);
+
+/**
+ * Convert UTF-8 to UTF-16LE
+ *
+ * @param src       UTF-8 bytes
+ * @param len       Number of bytes
+ * @param dst       Output buffer (UTF-16LE bytes)
+ * @param capacity  Output capacity in bytes
+ * @param units     Output: code units written
+ * @return false on invalid UTF-8 or insufficient capacity
+ */
+bool bond_utf8_to_utf16le(const uint8_t *src, size_t len,
+                          uint8_t *dst, size_t capacity, size_t *units);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_UNICODE_H
@@ -0,0 +1,118 @@
+/**
+ * @file bond_validate.h
+ * @brief One-shot structural validation and unchecked CompactBinary v1 reading
+ *
+ * bond_validate() walks an untrusted payload once and checks everything the
+ * reader would otherwise check byte by byte: field types, varint lengths,
+ * string lengths, container counts against the remaining bytes and nesting
+ * depth. A successful pass yields a token that unlocks BondUncheckedReader,
+ * which decodes straight from memory with no bounds checks at all.
+ */
+
+#ifndef BOND_VALIDATE_H
+#define BOND_VALIDATE_H
+
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+#define BOND_VALIDATE_DEFAULT_MAX_DEPTH 64
+
+/**
+ * Limits applied while validating
+ */
+typedef struct {
+    uint32_t max_depth;     // Max nesting of structs and containers (0 = default)
+    bool validate_utf8;     // Also require every string to be valid UTF-8
+} BondValidateLimits;
+
+/**
+ * Proof that a byte range holds one structurally valid struct
+ *
+ * Only bond_validate() should fill this in.
+ */
+typedef struct {
+    const uint8_t *data;    // First byte of the validated struct
+    size_t size;            // Length of the validated struct in bytes
+    bool valid;             // True if validation succeeded
+} BondValidationToken;
+
+/**
+ * Validate one struct starting at the buffer's read position
+ *
+ * Does not move the buffer's read position.
+ *
+ * @param buffer  Buffer holding the payload
+ * @param limits  Limits to enforce, or NULL for defaults
+ * @param token   Output: token describing the validated range
+ * @return true if the payload is structurally valid, false otherwise
+ */
+bool bond_validate(const bond_buffer *buffer, const BondValidateLimits *limits,
+                   BondValidationToken *token);
+
+// ============================================================================
+// Unchecked Reader
+// ============================================================================
+
+/**
+ * Reader over validated bytes
+ *
+ * Performs no bounds checks. Values must be read with the function matching
+ * the wire type reported by the field or container header, exactly as with
+ * BondReader; reading a different type than the one encoded is undefined.
+ */
+typedef struct {
+    const uint8_t *pos;     // Next byte to read
+    const uint8_t *end;     // One past the validated range
+} BondUncheckedReader;
+
+/**
+ * Initialize an unchecked reader from a validation token
+ *
+ * @return false if the token is not valid
+ */
+bool bond_unchecked_reader_init(BondUncheckedReader *reader, const BondValidationToken *token);
+
+void bond_unchecked_read_field_header(BondUncheckedReader *reader, uint16_t *field_id, uint8_t *type);
+
+bool bond_unchecked_read_bool_value(BondUncheckedReader *reader);
+uint8_t bond_unchecked_read_uint8_value(BondUncheckedReader *reader);
+uint16_t bond_unchecked_read_uint16_value(BondUncheckedReader *reader);
+uint32_t bond_unchecked_read_uint32_value(BondUncheckedReader *reader);
+uint64_t bond_unchecked_read_uint64_value(BondUncheckedReader *reader);
+int8_t bond_unchecked_read_int8_value(BondUncheckedReader *reader);
+int16_t bond_unchecked_read_int16_value(BondUncheckedReader *reader);
+int32_t bond_unchecked_read_int32_value(BondUncheckedReader *reader);
+int64_t bond_unchecked_read_int64_value(BondUncheckedReader *reader);
+float bond_unchecked_read_float_value(BondUncheckedReader *reader);
+double bond_unchecked_read_double_value(BondUncheckedReader *reader);
+
+/**
+ * Read a string value (zero-copy, NOT null-terminated)
+ */
+void bond_unchecked_read_string_value(BondUncheckedReader *reader, const char **str, uint32_t *len);
+
+void bond_unchecked_read_list_begin(BondUncheckedReader *reader, uint8_t *element_type, uint32_t *count);
+void bond_unchecked_read_map_begin(BondUncheckedReader *reader, uint8_t *key_type,
+                                   uint8_t *value_type, uint32_t *count);
+
+/**
+ * Skip a value of the given type
+ */
+void bond_unchecked_skip(BondUncheckedReader *reader, uint8_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOND_VALIDATE_H
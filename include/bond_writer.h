@@ -35,7 +35,10 @@ void bond_writer_init(bond_writer *writer, bond_buffer *buffer);
 // ============================================================================
 
 /**
- * Begin writing a struct (no-op in v1, resets state if needed)
+ * Begin writing a struct
+ *
+ * Writes nothing (v1 structs have no header); marks the start for the
+ * BOND_LITE_STATS counters and the writer_struct_begin probe.
  */
 void bond_writer_struct_begin(bond_writer *writer);
 
@@ -77,6 +80,20 @@ void bond_writer_write_double(bond_writer *writer, uint16_t field_id, double val
 
 void bond_writer_write_string(bond_writer *writer, uint16_t field_id, const char *value);
 
+/**
+ * Write a wstring field from UTF-16 code units (host byte order)
+ * Format: [field_header][length:varint32 in code units][UTF-16LE bytes]
+ */
+void bond_writer_write_wstring(bond_writer *writer, uint16_t field_id,
+                               const uint16_t *value, uint32_t length);
+
+/**
+ * Write a wstring field from UTF-8, transcoding straight into the buffer
+ * @return false if `value` is not valid UTF-8 (nothing is written)
+ */
+bool bond_writer_write_wstring_utf8(bond_writer *writer, uint16_t field_id,
+                                    const char *value, size_t len);
+
 // ============================================================================
 // Container Writers
 // ============================================================================
@@ -88,6 +105,22 @@ void bond_writer_write_string(bond_writer *writer, uint16_t field_id, const char
 void bond_writer_write_list_begin(bond_writer *writer, uint16_t field_id, 
                                   BondDataType element_type, uint32_t count);
 
+/**
+ * Write a blob field: list<int8> header plus all bytes with one memcpy
+ * Format: [field_header][BOND_TYPE_INT8][count:varint][bytes]
+ */
+void bond_writer_write_blob(bond_writer *writer, uint16_t field_id,
+                            const void *data, uint32_t len);
+
+/**
+ * Write list<float> / list<double> from an array in one bulk copy
+ * Format: [field_header][BOND_TYPE_FLOAT|DOUBLE][count:varint][values LE]
+ */
+void bond_writer_write_float_list(bond_writer *writer, uint16_t field_id,
+                                  const float *values, uint32_t count);
+void bond_writer_write_double_list(bond_writer *writer, uint16_t field_id,
+                                   const double *values, uint32_t count);
+
 /**
  * Write set container header
  * Format: [field_header][element_type:8][count:varint]
@@ -103,6 +136,57 @@ void bond_writer_write_map_begin(bond_writer *writer, uint16_t field_id,
                                  BondDataType key_type, BondDataType value_type, 
                                  uint32_t count);
 
+// ============================================================================
+// Deferred-Count Containers
+// ============================================================================
+//
+// For containers whose size is only known once every element has been
+// written. *_begin_deferred() leaves room for a max-width count and returns a
+// mark; the matching *_end() writes the real count there. If the count needs
+// fewer than 5 varint bytes the elements are moved down with one memmove, so
+// the output is byte-identical to writing the count up front.
+
+#define BOND_DEFERRED_COUNT_SIZE 5
+
+/**
+ * Begin a list whose count is supplied later to bond_writer_write_list_end()
+ * @return Mark to pass to bond_writer_write_list_end()
+ */
+size_t bond_writer_write_list_begin_deferred(bond_writer *writer, uint16_t field_id,
+                                             BondDataType element_type);
+
+/**
+ * Same as bond_writer_write_list_begin_deferred() without a field header
+ * (for a list nested inside another container)
+ */
+size_t bond_writer_write_list_value_begin_deferred(bond_writer *writer,
+                                                   BondDataType element_type);
+
+/**
+ * Backpatch the element count of a deferred list
+ * @return false if the mark does not belong to this buffer
+ */
+bool bond_writer_write_list_end(bond_writer *writer, size_t mark, uint32_t count);
+
+/**
+ * Begin a map whose count is supplied later to bond_writer_write_map_end()
+ * @return Mark to pass to bond_writer_write_map_end()
+ */
+size_t bond_writer_write_map_begin_deferred(bond_writer *writer, uint16_t field_id,
+                                            BondDataType key_type, BondDataType value_type);
+
+/**
+ * Same as bond_writer_write_map_begin_deferred() without a field header
+ */
+size_t bond_writer_write_map_value_begin_deferred(bond_writer *writer,
+                                                  BondDataType key_type, BondDataType value_type);
+
+/**
+ * Backpatch the pair count of a deferred map
+ * @return false if the mark does not belong to this buffer
+ */
+bool bond_writer_write_map_end(bond_writer *writer, size_t mark, uint32_t count);
+
 // ============================================================================
 // Raw Value Writers (no field header - for container elements)
 // ============================================================================
@@ -119,5 +203,7 @@ void bond_writer_write_int64_value(bond_writer *writer, int64_t value);
 void bond_writer_write_float_value(bond_writer *writer, float value);
 void bond_writer_write_double_value(bond_writer *writer, double value);
 void bond_writer_write_string_value(bond_writer *writer, const char *value);
+void bond_writer_write_wstring_value(bond_writer *writer, const uint16_t *value, uint32_t length);
+bool bond_writer_write_wstring_utf8_value(bond_writer *writer, const char *value, size_t len);
 
 #endif // BOND_WRITER_H
@@ -1,4 +1,6 @@
 #include "bond_buffer.h"
+#include "bond_probes.h"
+#include "bond_stats.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -62,6 +64,9 @@ int bond_buffer_reserve(bond_buffer *buf, size_t additional)
         {
             return -1;
         }
+        BOND_STATS_ADD(reserve_reallocs, 1);
+        BOND_STATS_ADD(reserve_bytes_copied, buf->size);
+        BOND_PROBE4(buffer_grow, buf, buf->size, buf->capacity, new_capacity);
         buf->data = new_data;
         buf->capacity = new_capacity;
     }
@@ -79,6 +84,7 @@ int bond_buffer_write(bond_buffer *buf, const void *data, size_t len)
     }
     memcpy(buf->data + buf->size, data, len);
     buf->size += len;
+    BOND_STATS_ADD(bytes_written, len);
     return 0;
 }
 
@@ -90,6 +96,7 @@ int bond_buffer_write_byte(bond_buffer *buf, uint8_t byte)
         return -1;
     }
     buf->data[buf->size++] = byte; 
+    BOND_STATS_ADD(bytes_written, 1);
     return 0;
 }
 
@@ -103,6 +110,7 @@ size_t bond_buffer_read(bond_buffer *buf, void *dest, size_t len)
     size_t bytes_to_read = (len < bytes_available) ? len : bytes_available;
     memcpy(dest, buf->data + buf->read_pos, bytes_to_read);
     buf->read_pos += bytes_to_read;
+    BOND_STATS_ADD(bytes_read, bytes_to_read);
     return bytes_to_read;
 }
 
@@ -111,6 +119,7 @@ int bond_buffer_read_byte(bond_buffer *buf)
 {
     if (buf->read_pos < buf->size)
     {
+        BOND_STATS_ADD(bytes_read, 1);
         return buf->data[buf->read_pos++];
     }
     return -1;
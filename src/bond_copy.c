@@ -0,0 +1,40 @@
+/**
+ * @file bond_copy.c
+ * @brief Raw passthrough copy implementation
+ */
+
+#include "bond_copy.h"
+
+bool bond_copy_value(BondReader *reader, bond_writer *writer, uint8_t type)
+{
+    size_t start = reader->buffer->read_pos;
+    if (!bond_reader_skip(reader, type))
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    // The value's extent is exactly what skip consumed
+    size_t len = reader->buffer->read_pos - start;
+    return bond_buffer_write(writer->buffer, reader->buffer->data + start, len) == 0;
+}
+
+bool bond_copy_field(BondReader *reader, bond_writer *writer,
+                     uint16_t field_id, uint8_t type)
+{
+    size_t start = reader->buffer->read_pos;
+    if (!bond_reader_skip(reader, type))
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    size_t len = reader->buffer->read_pos - start;
+
+    size_t mark = writer->buffer->size;
+    bond_writer_write_field_header(writer, field_id, (BondDataType)type);
+    if (bond_buffer_write(writer->buffer, reader->buffer->data + start, len) != 0)
+    {
+        writer->buffer->size = mark;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,582 @@
+/**
+ * @file bond_fast.c
+ * @brief FastBinary v1 writer and reader implementation
+ */
+
+#include "bond_fast.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_encoding.h"
+#include <string.h>
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+//
+// Strings, wstrings and container counts use the same varint-prefixed layout
+// as CompactBinary, so those go through a CompactBinary writer/reader over
+// the same buffer. Everything else is fixed width.
+
+static bond_writer compact_writer(bond_fast_writer *writer)
+{
+    bond_writer compact = { writer->buffer };
+    return compact;
+}
+
+static BondReader compact_reader(BondFastReader *reader)
+{
+    BondReader compact = { reader->buffer, 0 };
+    return compact;
+}
+
+// Append `width` bytes of `value`, least significant first
+static void put_fixed(bond_fast_writer *writer, uint64_t value, size_t width)
+{
+    uint8_t buf[8];
+    for (size_t i = 0; i < width; i++)
+    {
+        buf[i] = (uint8_t)(value >> (8 * i));
+    }
+    bond_buffer_write(writer->buffer, buf, width);
+}
+
+// Consume `width` bytes and return a pointer to them, or NULL if truncated
+static const uint8_t *take(BondFastReader *reader, size_t width)
+{
+    if (bond_buffer_remaining(reader->buffer) < width)
+    {
+        return NULL;
+    }
+    const uint8_t *p = reader->buffer->data + reader->buffer->read_pos;
+    reader->buffer->read_pos += width;
+    return p;
+}
+
+static uint64_t load_fixed(const uint8_t *p, size_t width)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; i++)
+    {
+        value |= (uint64_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+// Wire size of a fixed-width value, 0 for variable-size types
+static size_t fixed_width(uint8_t type)
+{
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            return 1;
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_INT16:
+            return 2;
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_FLOAT:
+            return 4;
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT64:
+        case BOND_TYPE_DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+void bond_fast_writer_init(bond_fast_writer *writer, bond_buffer *buffer)
+{
+    writer->buffer = buffer;
+}
+
+void bond_fast_writer_struct_begin(bond_fast_writer *writer)
+{
+    (void)writer;
+}
+
+void bond_fast_writer_struct_end(bond_fast_writer *writer)
+{
+    bond_buffer_write_byte(writer->buffer, BOND_TYPE_STOP);
+}
+
+void bond_fast_writer_base_end(bond_fast_writer *writer)
+{
+    bond_buffer_write_byte(writer->buffer, BOND_TYPE_STOP_BASE);
+}
+
+void bond_fast_writer_write_field_header(bond_fast_writer *writer, uint16_t field_id,
+                                         BondDataType type)
+{
+    uint8_t header[3] = { (uint8_t)type, (uint8_t)field_id, (uint8_t)(field_id >> 8) };
+    bond_buffer_write(writer->buffer, header, sizeof(header));
+}
+
+void bond_fast_writer_write_bool(bond_fast_writer *writer, uint16_t field_id, bool value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_BOOL);
+    bond_fast_writer_write_bool_value(writer, value);
+}
+
+void bond_fast_writer_write_uint8(bond_fast_writer *writer, uint16_t field_id, uint8_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_UINT8);
+    bond_fast_writer_write_uint8_value(writer, value);
+}
+
+void bond_fast_writer_write_uint16(bond_fast_writer *writer, uint16_t field_id, uint16_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_UINT16);
+    bond_fast_writer_write_uint16_value(writer, value);
+}
+
+void bond_fast_writer_write_uint32(bond_fast_writer *writer, uint16_t field_id, uint32_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_UINT32);
+    bond_fast_writer_write_uint32_value(writer, value);
+}
+
+void bond_fast_writer_write_uint64(bond_fast_writer *writer, uint16_t field_id, uint64_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_UINT64);
+    bond_fast_writer_write_uint64_value(writer, value);
+}
+
+void bond_fast_writer_write_int8(bond_fast_writer *writer, uint16_t field_id, int8_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_INT8);
+    bond_fast_writer_write_int8_value(writer, value);
+}
+
+void bond_fast_writer_write_int16(bond_fast_writer *writer, uint16_t field_id, int16_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_INT16);
+    bond_fast_writer_write_int16_value(writer, value);
+}
+
+void bond_fast_writer_write_int32(bond_fast_writer *writer, uint16_t field_id, int32_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_INT32);
+    bond_fast_writer_write_int32_value(writer, value);
+}
+
+void bond_fast_writer_write_int64(bond_fast_writer *writer, uint16_t field_id, int64_t value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_INT64);
+    bond_fast_writer_write_int64_value(writer, value);
+}
+
+void bond_fast_writer_write_float(bond_fast_writer *writer, uint16_t field_id, float value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_FLOAT);
+    bond_fast_writer_write_float_value(writer, value);
+}
+
+void bond_fast_writer_write_double(bond_fast_writer *writer, uint16_t field_id, double value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_DOUBLE);
+    bond_fast_writer_write_double_value(writer, value);
+}
+
+void bond_fast_writer_write_string(bond_fast_writer *writer, uint16_t field_id, const char *value)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_STRING);
+    bond_fast_writer_write_string_value(writer, value);
+}
+
+void bond_fast_writer_write_list_begin(bond_fast_writer *writer, uint16_t field_id,
+                                       BondDataType element_type, uint32_t count)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_LIST);
+    bond_buffer_write_byte(writer->buffer, (uint8_t)element_type);
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_uint32_value(&compact, count);
+}
+
+void bond_fast_writer_write_set_begin(bond_fast_writer *writer, uint16_t field_id,
+                                      BondDataType element_type, uint32_t count)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_SET);
+    bond_buffer_write_byte(writer->buffer, (uint8_t)element_type);
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_uint32_value(&compact, count);
+}
+
+void bond_fast_writer_write_map_begin(bond_fast_writer *writer, uint16_t field_id,
+                                      BondDataType key_type, BondDataType value_type,
+                                      uint32_t count)
+{
+    bond_fast_writer_write_field_header(writer, field_id, BOND_TYPE_MAP);
+    uint8_t types[2] = { (uint8_t)key_type, (uint8_t)value_type };
+    bond_buffer_write(writer->buffer, types, sizeof(types));
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_uint32_value(&compact, count);
+}
+
+void bond_fast_writer_write_bool_value(bond_fast_writer *writer, bool value)
+{
+    bond_buffer_write_byte(writer->buffer, value ? 1 : 0);
+}
+
+void bond_fast_writer_write_uint8_value(bond_fast_writer *writer, uint8_t value)
+{
+    bond_buffer_write_byte(writer->buffer, value);
+}
+
+void bond_fast_writer_write_uint16_value(bond_fast_writer *writer, uint16_t value)
+{
+    put_fixed(writer, value, 2);
+}
+
+void bond_fast_writer_write_uint32_value(bond_fast_writer *writer, uint32_t value)
+{
+    put_fixed(writer, value, 4);
+}
+
+void bond_fast_writer_write_uint64_value(bond_fast_writer *writer, uint64_t value)
+{
+    put_fixed(writer, value, 8);
+}
+
+void bond_fast_writer_write_int8_value(bond_fast_writer *writer, int8_t value)
+{
+    bond_buffer_write_byte(writer->buffer, (uint8_t)value);
+}
+
+void bond_fast_writer_write_int16_value(bond_fast_writer *writer, int16_t value)
+{
+    put_fixed(writer, (uint16_t)value, 2);
+}
+
+void bond_fast_writer_write_int32_value(bond_fast_writer *writer, int32_t value)
+{
+    put_fixed(writer, (uint32_t)value, 4);
+}
+
+void bond_fast_writer_write_int64_value(bond_fast_writer *writer, int64_t value)
+{
+    put_fixed(writer, (uint64_t)value, 8);
+}
+
+void bond_fast_writer_write_float_value(bond_fast_writer *writer, float value)
+{
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_float_value(&compact, value);
+}
+
+void bond_fast_writer_write_double_value(bond_fast_writer *writer, double value)
+{
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_double_value(&compact, value);
+}
+
+void bond_fast_writer_write_string_value(bond_fast_writer *writer, const char *value)
+{
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_string_value(&compact, value);
+}
+
+void bond_fast_writer_write_wstring_value(bond_fast_writer *writer, const uint16_t *value,
+                                          uint32_t length)
+{
+    bond_writer compact = compact_writer(writer);
+    bond_writer_write_wstring_value(&compact, value, length);
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+void bond_fast_reader_init(BondFastReader *reader, bond_buffer *buffer)
+{
+    reader->buffer = buffer;
+}
+
+bool bond_fast_reader_read_field_header(BondFastReader *reader, uint16_t *field_id, uint8_t *type)
+{
+    const uint8_t *p = take(reader, 1);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *type = p[0];
+    if (*type == BOND_TYPE_STOP || *type == BOND_TYPE_STOP_BASE)
+    {
+        *field_id = 0;
+        return true;
+    }
+    p = take(reader, 2);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *field_id = (uint16_t)load_fixed(p, 2);
+    return true;
+}
+
+bool bond_fast_reader_read_bool_value(BondFastReader *reader, bool *value)
+{
+    const uint8_t *p = take(reader, 1);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = p[0] != 0;
+    return true;
+}
+
+bool bond_fast_reader_read_uint8_value(BondFastReader *reader, uint8_t *value)
+{
+    const uint8_t *p = take(reader, 1);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = p[0];
+    return true;
+}
+
+bool bond_fast_reader_read_uint16_value(BondFastReader *reader, uint16_t *value)
+{
+    const uint8_t *p = take(reader, 2);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = (uint16_t)load_fixed(p, 2);
+    return true;
+}
+
+bool bond_fast_reader_read_uint32_value(BondFastReader *reader, uint32_t *value)
+{
+    const uint8_t *p = take(reader, 4);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = (uint32_t)load_fixed(p, 4);
+    return true;
+}
+
+bool bond_fast_reader_read_uint64_value(BondFastReader *reader, uint64_t *value)
+{
+    const uint8_t *p = take(reader, 8);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = load_fixed(p, 8);
+    return true;
+}
+
+bool bond_fast_reader_read_int8_value(BondFastReader *reader, int8_t *value)
+{
+    uint8_t uvalue;
+    if (!bond_fast_reader_read_uint8_value(reader, &uvalue))
+    {
+        return false;
+    }
+    *value = (int8_t)uvalue;
+    return true;
+}
+
+bool bond_fast_reader_read_int16_value(BondFastReader *reader, int16_t *value)
+{
+    uint16_t uvalue;
+    if (!bond_fast_reader_read_uint16_value(reader, &uvalue))
+    {
+        return false;
+    }
+    *value = (int16_t)uvalue;
+    return true;
+}
+
+bool bond_fast_reader_read_int32_value(BondFastReader *reader, int32_t *value)
+{
+    uint32_t uvalue;
+    if (!bond_fast_reader_read_uint32_value(reader, &uvalue))
+    {
+        return false;
+    }
+    *value = (int32_t)uvalue;
+    return true;
+}
+
+bool bond_fast_reader_read_int64_value(BondFastReader *reader, int64_t *value)
+{
+    uint64_t uvalue;
+    if (!bond_fast_reader_read_uint64_value(reader, &uvalue))
+    {
+        return false;
+    }
+    *value = (int64_t)uvalue;
+    return true;
+}
+
+bool bond_fast_reader_read_float_value(BondFastReader *reader, float *value)
+{
+    const uint8_t *p = take(reader, 4);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = bond_decode_float(p);
+    return true;
+}
+
+bool bond_fast_reader_read_double_value(BondFastReader *reader, double *value)
+{
+    const uint8_t *p = take(reader, 8);
+    if (p == NULL)
+    {
+        return false;
+    }
+    *value = bond_decode_double(p);
+    return true;
+}
+
+bool bond_fast_reader_read_string_value(BondFastReader *reader, const char **str, uint32_t *len)
+{
+    BondReader compact = compact_reader(reader);
+    return bond_reader_read_string_value(&compact, str, len);
+}
+
+bool bond_fast_reader_read_wstring_value(BondFastReader *reader, const uint8_t **units,
+                                         uint32_t *length)
+{
+    BondReader compact = compact_reader(reader);
+    return bond_reader_read_wstring_value(&compact, units, length);
+}
+
+bool bond_fast_reader_read_list_begin(BondFastReader *reader, uint8_t *element_type, uint32_t *count)
+{
+    // Element type byte + varint count: same as CompactBinary v1
+    BondReader compact = compact_reader(reader);
+    return bond_reader_read_list_begin(&compact, element_type, count);
+}
+
+bool bond_fast_reader_read_set_begin(BondFastReader *reader, uint8_t *element_type, uint32_t *count)
+{
+    return bond_fast_reader_read_list_begin(reader, element_type, count);
+}
+
+bool bond_fast_reader_read_map_begin(BondFastReader *reader, uint8_t *key_type,
+                                     uint8_t *value_type, uint32_t *count)
+{
+    BondReader compact = compact_reader(reader);
+    return bond_reader_read_map_begin(&compact, key_type, value_type, count);
+}
+
+// Skip `count` values alternating between types[0] and types[1]
+static bool skip_elements(BondFastReader *reader, uint32_t count, const uint8_t types[2])
+{
+    // Fixed-width elements are skipped in one step
+    size_t width0 = fixed_width(types[0]);
+    size_t width1 = fixed_width(types[1]);
+    if (width0 != 0 && width1 != 0)
+    {
+        uint64_t bytes = (uint64_t)(count / 2) * (width0 + width1) + (count & 1) * width0;
+        if (bond_buffer_remaining(reader->buffer) < bytes)
+        {
+            return false;
+        }
+        reader->buffer->read_pos += (size_t)bytes;
+        return true;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!bond_fast_reader_skip(reader, types[i & 1]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bond_fast_reader_skip(BondFastReader *reader, uint8_t type)
+{
+    size_t width = fixed_width(type);
+    if (width != 0)
+    {
+        return take(reader, width) != NULL;
+    }
+
+    switch (type)
+    {
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            return bond_fast_reader_read_string_value(reader, &str, &len);
+        }
+
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t length;
+            return bond_fast_reader_read_wstring_value(reader, &units, &length);
+        }
+
+        case BOND_TYPE_STRUCT:
+        {
+            // Fields until STOP; base parts end in STOP_BASE and continue
+            uint16_t field_id;
+            uint8_t field_type;
+            while (true)
+            {
+                if (!bond_fast_reader_read_field_header(reader, &field_id, &field_type))
+                {
+                    return false;
+                }
+                if (field_type == BOND_TYPE_STOP)
+                {
+                    return true;
+                }
+                if (field_type != BOND_TYPE_STOP_BASE &&
+                    !bond_fast_reader_skip(reader, field_type))
+                {
+                    return false;
+                }
+            }
+        }
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            uint8_t types[2];
+            uint32_t count;
+            if (!bond_fast_reader_read_list_begin(reader, &types[0], &count))
+            {
+                return false;
+            }
+            types[1] = types[0];
+            return skip_elements(reader, count, types);
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            uint8_t types[2];
+            uint32_t count;
+            if (!bond_fast_reader_read_map_begin(reader, &types[0], &types[1], &count))
+            {
+                return false;
+            }
+            // Pairs are skipped as alternating key/value elements
+            if (count > UINT32_MAX / 2)
+            {
+                return false;
+            }
+            return skip_elements(reader, count * 2, types);
+        }
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,1245 @@
+/**
+ * @file bond_json.c
+ * @brief CompactBinary v1 <-> SimpleJSON transcoding implementation
+ */
+
+#include "bond_json.h"
+#include "bond_encoding.h"
+#include "bond_number.h"
+#include "bond_unicode.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Schema Helpers
+// ============================================================================
+
+// Deepest inheritance chain either direction handles
+#define JSON_MAX_SCHEMA_LEVELS 16
+
+// Inheritance chain of `schema`, base-most first (none for a NULL schema)
+static bool schema_levels(const BondSchemaStruct *schema,
+                          const BondSchemaStruct *levels[JSON_MAX_SCHEMA_LEVELS],
+                          uint32_t *count)
+{
+    uint32_t n = 0;
+    for (const BondSchemaStruct *s = schema; s != NULL; s = s->base)
+    {
+        if (n == JSON_MAX_SCHEMA_LEVELS)
+        {
+            return false;
+        }
+        levels[n++] = s;
+    }
+    for (uint32_t i = 0; i < n / 2; i++)
+    {
+        const BondSchemaStruct *tmp = levels[i];
+        levels[i] = levels[n - 1 - i];
+        levels[n - 1 - i] = tmp;
+    }
+    *count = n;
+    return true;
+}
+
+// ============================================================================
+// CompactBinary -> JSON
+// ============================================================================
+
+typedef struct {
+    BondReader *reader;
+    bond_buffer *out;
+    bond_json_flush_fn flush;
+    void *flush_ctx;
+    size_t flush_threshold;
+    bool failed;            // A write or flush failed
+} json_writer;
+
+static void put(json_writer *w, const void *data, size_t len)
+{
+    if (bond_buffer_write(w->out, data, len) != 0)
+    {
+        w->failed = true;
+    }
+}
+
+static void put_char(json_writer *w, char c)
+{
+    if (bond_buffer_write_byte(w->out, (uint8_t)c) != 0)
+    {
+        w->failed = true;
+    }
+}
+
+// Hand full buffers to the sink between values
+static void maybe_flush(json_writer *w)
+{
+    if (w->flush != NULL && w->out->size >= w->flush_threshold && !w->failed)
+    {
+        if (!w->flush(w->flush_ctx, w->out->data, w->out->size))
+        {
+            w->failed = true;
+        }
+        w->out->size = 0;
+    }
+}
+
+// Write a JSON string, copying runs that need no escaping in one go
+static void put_string(json_writer *w, const uint8_t *s, size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+    put_char(w, '"');
+    size_t run = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        uint8_t c = s[i];
+        if (c >= 0x20 && c != '"' && c != '\\')
+        {
+            continue;
+        }
+        put(w, s + run, i - run);
+        run = i + 1;
+        switch (c)
+        {
+            case '"':  put(w, "\\\"", 2); break;
+            case '\\': put(w, "\\\\", 2); break;
+            case '\n': put(w, "\\n", 2); break;
+            case '\r': put(w, "\\r", 2); break;
+            case '\t': put(w, "\\t", 2); break;
+            case '\b': put(w, "\\b", 2); break;
+            case '\f': put(w, "\\f", 2); break;
+            default:
+            {
+                char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+                put(w, esc, sizeof(esc));
+                break;
+            }
+        }
+    }
+    put(w, s + run, len - run);
+    put_char(w, '"');
+}
+
+static void put_uint(json_writer *w, uint64_t value)
+{
+    char buf[20];
+    put(w, buf, bond_number_format_uint64(buf, value));
+}
+
+static void put_int(json_writer *w, int64_t value)
+{
+    char buf[21];
+    put(w, buf, bond_number_format_int64(buf, value));
+}
+
+// Non-finite values are not valid JSON numbers
+static bool put_non_finite(json_writer *w, double value)
+{
+    if (isnan(value))
+    {
+        put(w, "\"NaN\"", 5);
+    }
+    else if (isinf(value))
+    {
+        if (value > 0)
+        {
+            put(w, "\"Infinity\"", 10);
+        }
+        else
+        {
+            put(w, "\"-Infinity\"", 11);
+        }
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool json_value(json_writer *w, uint8_t type, const BondSchemaType *schema,
+                       uint32_t depth);
+
+static bool json_struct(json_writer *w, const BondSchemaStruct *schema, uint32_t depth)
+{
+    // Section N of the payload (between STOP_BASE markers) holds the fields
+    // of levels[N]
+    const BondSchemaStruct *levels[JSON_MAX_SCHEMA_LEVELS];
+    uint32_t level_count;
+    if (!schema_levels(schema, levels, &level_count))
+    {
+        return false;
+    }
+
+    uint32_t section = 0;
+    bool first = true;
+    put_char(w, '{');
+    while (true)
+    {
+        uint16_t field_id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(w->reader, &field_id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            break;
+        }
+        if (type == BOND_TYPE_STOP_BASE)
+        {
+            section++;
+            continue;
+        }
+
+        const BondSchemaField *field = NULL;
+        if (section < level_count)
+        {
+            field = bond_schema_find_field(levels[section], field_id);
+        }
+
+        if (!first)
+        {
+            put_char(w, ',');
+        }
+        first = false;
+        if (field != NULL && field->name != NULL)
+        {
+            put_string(w, (const uint8_t *)field->name, strlen(field->name));
+        }
+        else
+        {
+            put_char(w, '"');
+            put_uint(w, field_id);
+            put_char(w, '"');
+        }
+        put_char(w, ':');
+        if (!json_value(w, type, field != NULL ? &field->type : NULL, depth + 1))
+        {
+            return false;
+        }
+        maybe_flush(w);
+    }
+    put_char(w, '}');
+    return true;
+}
+
+static bool json_value(json_writer *w, uint8_t type, const BondSchemaType *schema,
+                       uint32_t depth)
+{
+    if (depth > BOND_JSON_MAX_DEPTH || w->failed)
+    {
+        return false;
+    }
+    // The schema only contributes names; types always come from the wire
+    if (schema != NULL && schema->id != type)
+    {
+        schema = NULL;
+    }
+
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        {
+            bool value;
+            if (!bond_reader_read_bool_value(w->reader, &value))
+            {
+                return false;
+            }
+            put(w, value ? "true" : "false", value ? 4 : 5);
+            return true;
+        }
+
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_UINT64:
+        {
+            uint64_t value;
+            bool ok;
+            if (type == BOND_TYPE_UINT8)
+            {
+                uint8_t v;
+                ok = bond_reader_read_uint8_value(w->reader, &v);
+                value = v;
+            }
+            else if (type == BOND_TYPE_UINT16)
+            {
+                uint16_t v;
+                ok = bond_reader_read_uint16_value(w->reader, &v);
+                value = v;
+            }
+            else if (type == BOND_TYPE_UINT32)
+            {
+                uint32_t v;
+                ok = bond_reader_read_uint32_value(w->reader, &v);
+                value = v;
+            }
+            else
+            {
+                ok = bond_reader_read_uint64_value(w->reader, &value);
+            }
+            if (!ok)
+            {
+                return false;
+            }
+            put_uint(w, value);
+            return true;
+        }
+
+        case BOND_TYPE_INT8:
+        case BOND_TYPE_INT16:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_INT64:
+        {
+            int64_t value;
+            bool ok;
+            if (type == BOND_TYPE_INT8)
+            {
+                int8_t v;
+                ok = bond_reader_read_int8_value(w->reader, &v);
+                value = v;
+            }
+            else if (type == BOND_TYPE_INT16)
+            {
+                int16_t v;
+                ok = bond_reader_read_int16_value(w->reader, &v);
+                value = v;
+            }
+            else if (type == BOND_TYPE_INT32)
+            {
+                int32_t v;
+                ok = bond_reader_read_int32_value(w->reader, &v);
+                value = v;
+            }
+            else
+            {
+                ok = bond_reader_read_int64_value(w->reader, &value);
+            }
+            if (!ok)
+            {
+                return false;
+            }
+            put_int(w, value);
+            return true;
+        }
+
+        case BOND_TYPE_FLOAT:
+        {
+            float value;
+            if (!bond_reader_read_float_value(w->reader, &value))
+            {
+                return false;
+            }
+            if (!put_non_finite(w, value))
+            {
+                char buf[BOND_NUMBER_MAX_TEXT];
+                put(w, buf, bond_number_format_float(buf, value));
+            }
+            return true;
+        }
+
+        case BOND_TYPE_DOUBLE:
+        {
+            double value;
+            if (!bond_reader_read_double_value(w->reader, &value))
+            {
+                return false;
+            }
+            if (!put_non_finite(w, value))
+            {
+                char buf[BOND_NUMBER_MAX_TEXT];
+                put(w, buf, bond_number_format_double(buf, value));
+            }
+            return true;
+        }
+
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            // Invalid UTF-8 would make invalid JSON; fail as wstring does
+            if (!bond_reader_read_string_value(w->reader, &str, &len) ||
+                !bond_utf8_validate((const uint8_t *)str, len))
+            {
+                return false;
+            }
+            put_string(w, (const uint8_t *)str, len);
+            return true;
+        }
+
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t length;
+            if (!bond_reader_read_wstring_value(w->reader, &units, &length))
+            {
+                return false;
+            }
+            size_t capacity = BOND_UTF8_MAX_FROM_UTF16(length);
+            uint8_t stack[256];
+            uint8_t *utf8 = capacity <= sizeof(stack) ? stack : (uint8_t *)malloc(capacity);
+            size_t written;
+            bool ok = utf8 != NULL &&
+                      bond_utf16le_to_utf8(units, length, utf8, capacity, &written);
+            if (ok)
+            {
+                put_string(w, utf8, written);
+            }
+            if (utf8 != stack)
+            {
+                free(utf8);
+            }
+            return ok;
+        }
+
+        case BOND_TYPE_STRUCT:
+            return json_struct(w, schema != NULL ? schema->struct_def : NULL, depth);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        case BOND_TYPE_MAP:
+        {
+            uint8_t types[2];
+            uint32_t count;
+            if (type == BOND_TYPE_MAP)
+            {
+                if (!bond_reader_read_map_begin(w->reader, &types[0], &types[1], &count) ||
+                    count > UINT32_MAX / 2)
+                {
+                    return false;
+                }
+                count *= 2;
+            }
+            else
+            {
+                if (!bond_reader_read_list_begin(w->reader, &types[0], &count))
+                {
+                    return false;
+                }
+                types[1] = types[0];
+            }
+            const BondSchemaType *element_schema[2] = { NULL, NULL };
+            if (schema != NULL)
+            {
+                element_schema[0] = (type == BOND_TYPE_MAP) ? schema->key : schema->element;
+                element_schema[1] = schema->element;
+            }
+
+            put_char(w, '[');
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (i > 0)
+                {
+                    put_char(w, ',');
+                }
+                if (!json_value(w, types[i & 1], element_schema[i & 1], depth + 1))
+                {
+                    return false;
+                }
+                maybe_flush(w);
+            }
+            put_char(w, ']');
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool bond_json_from_compact(BondReader *reader, const BondJsonOptions *options,
+                            bond_buffer *out)
+{
+    json_writer w;
+    w.reader = reader;
+    w.out = out;
+    w.flush = options != NULL ? options->flush : NULL;
+    w.flush_ctx = options != NULL ? options->flush_ctx : NULL;
+    w.flush_threshold = (options != NULL && options->flush_threshold != 0)
+        ? options->flush_threshold : BOND_JSON_DEFAULT_FLUSH_THRESHOLD;
+    w.failed = false;
+
+    if (!json_struct(&w, options != NULL ? options->schema : NULL, 0) || w.failed)
+    {
+        return false;
+    }
+    if (w.flush != NULL && out->size > 0)
+    {
+        if (!w.flush(w.flush_ctx, out->data, out->size))
+        {
+            return false;
+        }
+        out->size = 0;
+    }
+    return true;
+}
+
+// ============================================================================
+// JSON -> CompactBinary
+// ============================================================================
+
+typedef struct {
+    const uint8_t *pos;     // Next input byte
+    const uint8_t *end;     // One past the input
+    bond_writer *writer;
+} json_parser;
+
+static void skip_ws(json_parser *p)
+{
+    while (p->pos < p->end &&
+           (*p->pos == ' ' || *p->pos == '\n' || *p->pos == '\r' || *p->pos == '\t'))
+    {
+        p->pos++;
+    }
+}
+
+// Consume `c` after optional whitespace
+static bool expect(json_parser *p, char c)
+{
+    skip_ws(p);
+    if (p->pos < p->end && *p->pos == (uint8_t)c)
+    {
+        p->pos++;
+        return true;
+    }
+    return false;
+}
+
+static bool match_literal(json_parser *p, const char *literal, size_t len)
+{
+    if ((size_t)(p->end - p->pos) < len || memcmp(p->pos, literal, len) != 0)
+    {
+        return false;
+    }
+    p->pos += len;
+    return true;
+}
+
+/**
+ * Scan a string token without decoding it.
+ *
+ * On success `s`/`len` cover the raw contents between the quotes and
+ * `escaped` tells whether any backslash escapes need decoding.
+ */
+static bool scan_string(json_parser *p, const uint8_t **s, size_t *len, bool *escaped)
+{
+    if (p->pos >= p->end || *p->pos != '"')
+    {
+        return false;
+    }
+    const uint8_t *start = ++p->pos;
+    bool esc = false;
+    while (p->pos < p->end)
+    {
+        uint8_t c = *p->pos;
+        if (c == '"')
+        {
+            *s = start;
+            *len = (size_t)(p->pos - start);
+            *escaped = esc;
+            p->pos++;
+            return true;
+        }
+        if (c < 0x20)
+        {
+            return false;
+        }
+        if (c == '\\')
+        {
+            esc = true;
+            if (++p->pos >= p->end)
+            {
+                return false;
+            }
+        }
+        p->pos++;
+    }
+    return false;
+}
+
+static int32_t hex4(const uint8_t *s)
+{
+    int32_t value = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        uint8_t c = s[i];
+        int32_t digit;
+        if (c >= '0' && c <= '9')
+        {
+            digit = c - '0';
+        }
+        else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f')
+        {
+            digit = (c | 0x20) - 'a' + 10;
+        }
+        else
+        {
+            return -1;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+static size_t encode_utf8(uint8_t *out, uint32_t cp)
+{
+    if (cp < 0x80)
+    {
+        out[0] = (uint8_t)cp;
+        return 1;
+    }
+    if (cp < 0x800)
+    {
+        out[0] = (uint8_t)(0xC0 | (cp >> 6));
+        out[1] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000)
+    {
+        out[0] = (uint8_t)(0xE0 | (cp >> 12));
+        out[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (uint8_t)(0xF0 | (cp >> 18));
+    out[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (uint8_t)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/**
+ * Decode the escapes of a scanned string to UTF-8.
+ *
+ * Every escape is at least as long as what it decodes to, so `out` needs no
+ * more than `len` bytes. Unpaired surrogate escapes are rejected.
+ */
+static bool unescape(const uint8_t *s, size_t len, uint8_t *out, size_t *out_len)
+{
+    const uint8_t *end = s + len;
+    size_t n = 0;
+    while (s < end)
+    {
+        const uint8_t *slash = (const uint8_t *)memchr(s, '\\', (size_t)(end - s));
+        size_t run = (slash != NULL ? slash : end) - s;
+        memmove(out + n, s, run);
+        n += run;
+        s += run;
+        if (slash == NULL)
+        {
+            break;
+        }
+
+        uint8_t c = s[1];
+        s += 2;
+        switch (c)
+        {
+            case '"':  out[n++] = '"'; break;
+            case '\\': out[n++] = '\\'; break;
+            case '/':  out[n++] = '/'; break;
+            case 'b':  out[n++] = '\b'; break;
+            case 'f':  out[n++] = '\f'; break;
+            case 'n':  out[n++] = '\n'; break;
+            case 'r':  out[n++] = '\r'; break;
+            case 't':  out[n++] = '\t'; break;
+            case 'u':
+            {
+                int32_t cp = end - s >= 4 ? hex4(s) : -1;
+                if (cp < 0 || (cp >= 0xDC00 && cp <= 0xDFFF))
+                {
+                    return false;
+                }
+                s += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF)
+                {
+                    int32_t low = (end - s >= 6 && s[0] == '\\' && s[1] == 'u') ? hex4(s + 2) : -1;
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return false;
+                    }
+                    s += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                n += encode_utf8(out + n, (uint32_t)cp);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    *out_len = n;
+    return true;
+}
+
+/**
+ * Write a string or wstring value.
+ *
+ * Strings without escapes are copied straight from the input. Otherwise the
+ * text is decoded into spare capacity of the output buffer past the widest
+ * possible length prefix (and past the UTF-16 output for wstrings), so no
+ * temporary allocation is needed.
+ */
+static bool parse_string_value(json_parser *p, bool wide)
+{
+    const uint8_t *s;
+    size_t len;
+    bool escaped;
+    if (!scan_string(p, &s, &len, &escaped) || len > UINT32_MAX)
+    {
+        return false;
+    }
+    bond_buffer *buffer = p->writer->buffer;
+
+    if (!escaped)
+    {
+        if (wide)
+        {
+            return bond_writer_write_wstring_utf8_value(p->writer, (const char *)s, len);
+        }
+        if (!bond_utf8_validate(s, len))
+        {
+            return false;
+        }
+        bond_writer_write_uint32_value(p->writer, (uint32_t)len);
+        return bond_buffer_write(buffer, s, len) == 0;
+    }
+
+    size_t scratch = BOND_DEFERRED_COUNT_SIZE + (wide ? 2 * len : 0);
+    if (bond_buffer_reserve(buffer, scratch + len) != 0)
+    {
+        return false;
+    }
+    uint8_t *text = buffer->data + buffer->size + scratch;
+    size_t text_len;
+    if (!unescape(s, len, text, &text_len))
+    {
+        return false;
+    }
+    if (wide)
+    {
+        // Fits in the reserved space, so the buffer is not reallocated
+        return bond_writer_write_wstring_utf8_value(p->writer, (const char *)text, text_len);
+    }
+    if (!bond_utf8_validate(text, text_len))
+    {
+        return false;
+    }
+    uint8_t prefix[BOND_DEFERRED_COUNT_SIZE];
+    size_t prefix_len = bond_encode_varint32(prefix, (uint32_t)text_len);
+    memmove(buffer->data + buffer->size + prefix_len, text, text_len);
+    memcpy(buffer->data + buffer->size, prefix, prefix_len);
+    buffer->size += prefix_len + text_len;
+    return true;
+}
+
+typedef struct {
+    const uint8_t *start;   // First byte of the token
+    size_t len;             // Token length
+    bool negative;
+    bool integral;          // No fraction or exponent
+    bool overflow;          // Integer part does not fit in 64 bits
+    uint64_t magnitude;     // Integer part (valid unless overflow)
+} json_number;
+
+// Scan a number token per the JSON grammar
+static bool scan_number(json_parser *p, json_number *n)
+{
+    const uint8_t *q = p->pos;
+    const uint8_t *end = p->end;
+    n->start = q;
+    n->negative = q < end && *q == '-';
+    n->integral = true;
+    n->overflow = false;
+    n->magnitude = 0;
+    if (n->negative)
+    {
+        q++;
+    }
+    if (q >= end || *q < '0' || *q > '9')
+    {
+        return false;
+    }
+    if (*q == '0')
+    {
+        q++;
+    }
+    else
+    {
+        while (q < end && *q >= '0' && *q <= '9')
+        {
+            uint64_t digit = (uint64_t)(*q - '0');
+            if (n->magnitude > (UINT64_MAX - digit) / 10)
+            {
+                n->overflow = true;
+            }
+            n->magnitude = n->magnitude * 10 + digit;
+            q++;
+        }
+    }
+    if (q < end && *q == '.')
+    {
+        n->integral = false;
+        q++;
+        if (q >= end || *q < '0' || *q > '9')
+        {
+            return false;
+        }
+        while (q < end && *q >= '0' && *q <= '9')
+        {
+            q++;
+        }
+    }
+    if (q < end && (*q == 'e' || *q == 'E'))
+    {
+        n->integral = false;
+        q++;
+        if (q < end && (*q == '+' || *q == '-'))
+        {
+            q++;
+        }
+        if (q >= end || *q < '0' || *q > '9')
+        {
+            return false;
+        }
+        while (q < end && *q >= '0' && *q <= '9')
+        {
+            q++;
+        }
+    }
+    n->len = (size_t)(q - n->start);
+    p->pos = q;
+    return true;
+}
+
+static bool parse_uint(json_parser *p, uint64_t max, uint64_t *value)
+{
+    json_number n;
+    if (!scan_number(p, &n) || !n.integral || n.overflow || n.magnitude > max ||
+        (n.negative && n.magnitude != 0))
+    {
+        return false;
+    }
+    *value = n.magnitude;
+    return true;
+}
+
+static bool parse_int(json_parser *p, int64_t min, int64_t max, int64_t *value)
+{
+    json_number n;
+    if (!scan_number(p, &n) || !n.integral || n.overflow)
+    {
+        return false;
+    }
+    if (n.negative)
+    {
+        if (n.magnitude > (uint64_t)-(min + 1) + 1)
+        {
+            return false;
+        }
+        *value = n.magnitude == 0 ? 0 : -(int64_t)(n.magnitude - 1) - 1;
+    }
+    else
+    {
+        if (n.magnitude > (uint64_t)max)
+        {
+            return false;
+        }
+        *value = (int64_t)n.magnitude;
+    }
+    return true;
+}
+
+// The strings written for non-finite values
+static bool parse_non_finite(json_parser *p, double *value)
+{
+    if (match_literal(p, "\"NaN\"", 5))
+    {
+        *value = NAN;
+    }
+    else if (match_literal(p, "\"Infinity\"", 10))
+    {
+        *value = INFINITY;
+    }
+    else if (match_literal(p, "\"-Infinity\"", 11))
+    {
+        *value = -INFINITY;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Numbers are converted in place on the token, whatever its length
+static bool parse_double(json_parser *p, double *value)
+{
+    if (p->pos < p->end && *p->pos == '"')
+    {
+        return parse_non_finite(p, value);
+    }
+    json_number n;
+    return scan_number(p, &n) &&
+           bond_number_parse_double((const char *)n.start, n.len, value);
+}
+
+// Rounded straight to float; going through a double could round twice
+static bool parse_float(json_parser *p, float *value)
+{
+    if (p->pos < p->end && *p->pos == '"')
+    {
+        double d;
+        if (!parse_non_finite(p, &d))
+        {
+            return false;
+        }
+        *value = (float)d;
+        return true;
+    }
+    json_number n;
+    return scan_number(p, &n) &&
+           bond_number_parse_float((const char *)n.start, n.len, value);
+}
+
+static bool skip_value(json_parser *p, uint32_t depth)
+{
+    skip_ws(p);
+    if (depth > BOND_JSON_MAX_DEPTH || p->pos >= p->end)
+    {
+        return false;
+    }
+    const uint8_t *s;
+    size_t len;
+    bool escaped;
+    json_number n;
+    switch (*p->pos)
+    {
+        case '"':
+            return scan_string(p, &s, &len, &escaped);
+        case 't':
+            return match_literal(p, "true", 4);
+        case 'f':
+            return match_literal(p, "false", 5);
+        case 'n':
+            return match_literal(p, "null", 4);
+        case '[':
+        case '{':
+        {
+            bool object = *p->pos == '{';
+            char close = object ? '}' : ']';
+            p->pos++;
+            if (expect(p, close))
+            {
+                return true;
+            }
+            do
+            {
+                if (object)
+                {
+                    skip_ws(p);
+                    if (!scan_string(p, &s, &len, &escaped) || !expect(p, ':'))
+                    {
+                        return false;
+                    }
+                }
+                if (!skip_value(p, depth + 1))
+                {
+                    return false;
+                }
+            } while (expect(p, ','));
+            return expect(p, close);
+        }
+        default:
+            return scan_number(p, &n);
+    }
+}
+
+static bool parse_value(json_parser *p, const BondSchemaType *type, uint32_t depth);
+static bool parse_struct(json_parser *p, const BondSchemaStruct *def, uint32_t depth);
+
+// Find the field a key names: field name first, then decimal field ID
+static const BondSchemaField *lookup_field(const BondSchemaStruct *def, const uint8_t *key,
+                                           size_t len, bool escaped)
+{
+    char name[128];
+    if (escaped)
+    {
+        size_t name_len;
+        if (len > sizeof(name) || !unescape(key, len, (uint8_t *)name, &name_len))
+        {
+            return NULL;
+        }
+        key = (const uint8_t *)name;
+        len = name_len;
+    }
+    const BondSchemaField *field = bond_schema_find_field_by_name(def, (const char *)key, len);
+    if (field != NULL || len == 0 || len > 5)
+    {
+        return field;
+    }
+    uint32_t id = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (key[i] < '0' || key[i] > '9')
+        {
+            return NULL;
+        }
+        id = id * 10 + (uint32_t)(key[i] - '0');
+    }
+    return id <= UINT16_MAX ? bond_schema_find_field(def, (uint16_t)id) : NULL;
+}
+
+/**
+ * Write one struct's fields and STOP.
+ *
+ * SimpleJSON merges base fields into the derived object while CompactBinary
+ * needs them first, so a derived struct scans its object once per
+ * inheritance level; structs without a base are a single pass.
+ */
+static bool parse_struct(json_parser *p, const BondSchemaStruct *def, uint32_t depth)
+{
+    const BondSchemaStruct *levels[JSON_MAX_SCHEMA_LEVELS];
+    uint32_t level_count;
+    if (def == NULL || !schema_levels(def, levels, &level_count))
+    {
+        return false;
+    }
+    skip_ws(p);
+    const uint8_t *object = p->pos;
+
+    for (uint32_t level = 0; level < level_count; level++)
+    {
+        p->pos = object;
+        if (level > 0)
+        {
+            bond_buffer_write_byte(p->writer->buffer, BOND_TYPE_STOP_BASE);
+        }
+        if (!expect(p, '{'))
+        {
+            return false;
+        }
+        if (expect(p, '}'))
+        {
+            continue;
+        }
+        do
+        {
+            const uint8_t *key;
+            size_t key_len;
+            bool escaped;
+            skip_ws(p);
+            if (!scan_string(p, &key, &key_len, &escaped) || !expect(p, ':'))
+            {
+                return false;
+            }
+            const BondSchemaField *field = lookup_field(levels[level], key, key_len, escaped);
+            skip_ws(p);
+
+            // Unknown keys and nulls (absent optional fields) are skipped
+            if (field == NULL || (p->pos < p->end && *p->pos == 'n'))
+            {
+                if (!skip_value(p, depth + 1))
+                {
+                    return false;
+                }
+                continue;
+            }
+            bond_writer_write_field_header(p->writer, field->id, (BondDataType)field->type.id);
+            if (!parse_value(p, &field->type, depth + 1))
+            {
+                return false;
+            }
+        } while (expect(p, ','));
+        if (!expect(p, '}'))
+        {
+            return false;
+        }
+    }
+    bond_writer_struct_end(p->writer);
+    return true;
+}
+
+static bool parse_value(json_parser *p, const BondSchemaType *type, uint32_t depth)
+{
+    skip_ws(p);
+    if (depth > BOND_JSON_MAX_DEPTH || p->pos >= p->end)
+    {
+        return false;
+    }
+    bond_writer *writer = p->writer;
+    uint64_t u;
+    int64_t i;
+    double d;
+    float f;
+
+    switch (type->id)
+    {
+        case BOND_TYPE_BOOL:
+            if (match_literal(p, "true", 4))
+            {
+                bond_writer_write_bool_value(writer, true);
+                return true;
+            }
+            if (match_literal(p, "false", 5))
+            {
+                bond_writer_write_bool_value(writer, false);
+                return true;
+            }
+            return false;
+
+        case BOND_TYPE_UINT8:
+            if (!parse_uint(p, UINT8_MAX, &u))
+            {
+                return false;
+            }
+            bond_writer_write_uint8_value(writer, (uint8_t)u);
+            return true;
+
+        case BOND_TYPE_UINT16:
+            if (!parse_uint(p, UINT16_MAX, &u))
+            {
+                return false;
+            }
+            bond_writer_write_uint16_value(writer, (uint16_t)u);
+            return true;
+
+        case BOND_TYPE_UINT32:
+            if (!parse_uint(p, UINT32_MAX, &u))
+            {
+                return false;
+            }
+            bond_writer_write_uint32_value(writer, (uint32_t)u);
+            return true;
+
+        case BOND_TYPE_UINT64:
+            if (!parse_uint(p, UINT64_MAX, &u))
+            {
+                return false;
+            }
+            bond_writer_write_uint64_value(writer, u);
+            return true;
+
+        case BOND_TYPE_INT8:
+            if (!parse_int(p, INT8_MIN, INT8_MAX, &i))
+            {
+                return false;
+            }
+            bond_writer_write_int8_value(writer, (int8_t)i);
+            return true;
+
+        case BOND_TYPE_INT16:
+            if (!parse_int(p, INT16_MIN, INT16_MAX, &i))
+            {
+                return false;
+            }
+            bond_writer_write_int16_value(writer, (int16_t)i);
+            return true;
+
+        case BOND_TYPE_INT32:
+            if (!parse_int(p, INT32_MIN, INT32_MAX, &i))
+            {
+                return false;
+            }
+            bond_writer_write_int32_value(writer, (int32_t)i);
+            return true;
+
+        case BOND_TYPE_INT64:
+            if (!parse_int(p, INT64_MIN, INT64_MAX, &i))
+            {
+                return false;
+            }
+            bond_writer_write_int64_value(writer, i);
+            return true;
+
+        case BOND_TYPE_FLOAT:
+            if (!parse_float(p, &f))
+            {
+                return false;
+            }
+            bond_writer_write_float_value(writer, f);
+            return true;
+
+        case BOND_TYPE_DOUBLE:
+            if (!parse_double(p, &d))
+            {
+                return false;
+            }
+            bond_writer_write_double_value(writer, d);
+            return true;
+
+        case BOND_TYPE_STRING:
+            return parse_string_value(p, false);
+
+        case BOND_TYPE_WSTRING:
+            return parse_string_value(p, true);
+
+        case BOND_TYPE_STRUCT:
+            return parse_struct(p, type->struct_def, depth);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        case BOND_TYPE_MAP:
+        {
+            // Element counts are only known at the closing bracket
+            bool map = type->id == BOND_TYPE_MAP;
+            const BondSchemaType *element[2] = { map ? type->key : type->element, type->element };
+            if (element[0] == NULL || element[1] == NULL || !expect(p, '['))
+            {
+                return false;
+            }
+            size_t mark = map
+                ? bond_writer_write_map_value_begin_deferred(writer, (BondDataType)element[0]->id,
+                                                             (BondDataType)element[1]->id)
+                : bond_writer_write_list_value_begin_deferred(writer, (BondDataType)element[0]->id);
+            uint32_t count = 0;
+            if (!expect(p, ']'))
+            {
+                do
+                {
+                    if (count == UINT32_MAX ||
+                        !parse_value(p, element[map ? (count & 1) : 0], depth + 1))
+                    {
+                        return false;
+                    }
+                    count++;
+                } while (expect(p, ','));
+                if (!expect(p, ']'))
+                {
+                    return false;
+                }
+            }
+            if (map)
+            {
+                return (count & 1) == 0 && bond_writer_write_map_end(writer, mark, count / 2);
+            }
+            return bond_writer_write_list_end(writer, mark, count);
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool bond_json_to_compact(const char *json, size_t len, const BondSchemaStruct *schema,
+                          bond_writer *writer)
+{
+    json_parser p;
+    p.pos = (const uint8_t *)json;
+    p.end = p.pos + len;
+    p.writer = writer;
+
+    size_t start = writer->buffer->size;
+    if (!parse_struct(&p, schema, 0))
+    {
+        writer->buffer->size = start;
+        return false;
+    }
+    skip_ws(&p);
+    if (p.pos != p.end)
+    {
+        writer->buffer->size = start;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file bond_lazy.c
+ * @brief Lazy on-demand DOM implementation
+ */
+
+#include "bond_lazy.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+// Wrap the document bytes and seek a reader to `offset`
+static void open_at(const BondLazyDoc *doc, size_t offset,
+                    bond_buffer *view, BondReader *reader)
+{
+    bond_buffer_init_from(view, doc->data, doc->size);
+    view->read_pos = offset;
+    bond_reader_init(reader, view);
+}
+
+static void init_child(BondLazyNode *child, uint8_t type, uint16_t field_id, size_t offset)
+{
+    memset(child, 0, sizeof(*child));
+    child->type = type;
+    child->field_id = field_id;
+    child->offset = offset;
+}
+
+// Record the value starting at the reader position as child `child`,
+// skipping it once so its end offset is cached.
+static bool record_child(BondReader *reader, BondLazyNode *child,
+                         uint8_t type, uint16_t field_id)
+{
+    init_child(child, type, field_id, reader->buffer->read_pos);
+    if (!bond_reader_skip(reader, type))
+    {
+        return false;
+    }
+    child->end = reader->buffer->read_pos;
+    return true;
+}
+
+static bool expand_struct(BondLazyNode *node, BondReader *reader)
+{
+    BondLazyNode *children = NULL;
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+
+    while (true)
+    {
+        uint16_t field_id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(reader, &field_id, &type))
+        {
+            free(children);
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            break;
+        }
+        if (type == BOND_TYPE_STOP_BASE)
+        {
+            continue;       // Base fields and derived fields are children alike
+        }
+
+        if (count == capacity)
+        {
+            uint32_t new_capacity = capacity ? capacity * 2 : 8;
+            BondLazyNode *grown = (BondLazyNode *)realloc(children, new_capacity * sizeof(BondLazyNode));
+            if (grown == NULL)
+            {
+                free(children);
+                return false;
+            }
+            children = grown;
+            capacity = new_capacity;
+        }
+
+        if (!record_child(reader, &children[count], type, field_id))
+        {
+            free(children);
+            return false;
+        }
+        count++;
+    }
+
+    node->children = children;
+    node->child_count = count;
+    node->end = reader->buffer->read_pos;
+    return true;
+}
+
+// Parse `count` consecutive values, alternating between `types[0]` and
+// `types[1]` (identical for lists, key/value for maps).
+static bool expand_elements(BondLazyNode *node, BondReader *reader,
+                            uint32_t count, const uint8_t types[2])
+{
+    // Every encoded value takes at least one byte; reject counts that
+    // cannot possibly fit before allocating for them.
+    if (count > bond_buffer_remaining(reader->buffer))
+    {
+        return false;
+    }
+
+    BondLazyNode *children = NULL;
+    if (count > 0)
+    {
+        children = (BondLazyNode *)malloc(count * sizeof(BondLazyNode));
+        if (children == NULL)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!record_child(reader, &children[i], types[i & 1], 0))
+        {
+            free(children);
+            return false;
+        }
+    }
+
+    node->children = children;
+    node->child_count = count;
+    node->end = reader->buffer->read_pos;
+    return true;
+}
+
+static bool expand(BondLazyDoc *doc, BondLazyNode *node)
+{
+    if (node->expanded)
+    {
+        return true;
+    }
+
+    bond_buffer view;
+    BondReader reader;
+    open_at(doc, node->offset, &view, &reader);
+
+    bool ok;
+    switch (node->type)
+    {
+        case BOND_TYPE_STRUCT:
+            ok = expand_struct(node, &reader);
+            break;
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            uint32_t count;
+            if (!bond_reader_read_list_begin(&reader, &node->element_type, &count))
+            {
+                return false;
+            }
+            uint8_t types[2] = { node->element_type, node->element_type };
+            ok = expand_elements(node, &reader, count, types);
+            break;
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            uint32_t count;
+            if (!bond_reader_read_map_begin(&reader, &node->key_type, &node->element_type, &count))
+            {
+                return false;
+            }
+            if (count > UINT32_MAX / 2)
+            {
+                return false;
+            }
+            uint8_t types[2] = { node->key_type, node->element_type };
+            ok = expand_elements(node, &reader, count * 2, types);
+            break;
+        }
+
+        default:
+            // Scalars have no children
+            return false;
+    }
+
+    node->expanded = ok;
+    return ok;
+}
+
+static void destroy_node(BondLazyNode *node)
+{
+    for (uint32_t i = 0; i < node->child_count; i++)
+    {
+        destroy_node(&node->children[i]);
+    }
+    free(node->children);
+    node->children = NULL;
+    node->child_count = 0;
+    node->expanded = false;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void bond_lazy_doc_init(BondLazyDoc *doc, const bond_buffer *buffer)
+{
+    doc->data = buffer->data;
+    doc->size = buffer->size;
+    init_child(&doc->root, BOND_TYPE_STRUCT, 0, buffer->read_pos);
+}
+
+void bond_lazy_doc_destroy(BondLazyDoc *doc)
+{
+    destroy_node(&doc->root);
+}
+
+BondLazyNode *bond_lazy_root(BondLazyDoc *doc)
+{
+    return &doc->root;
+}
+
+// ============================================================================
+// Navigation
+// ============================================================================
+
+BondLazyNode *bond_lazy_field(BondLazyDoc *doc, BondLazyNode *node, uint16_t field_id)
+{
+    if (node == NULL || node->type != BOND_TYPE_STRUCT || !expand(doc, node))
+    {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < node->child_count; i++)
+    {
+        if (node->children[i].field_id == field_id)
+        {
+            return &node->children[i];
+        }
+    }
+    return NULL;
+}
+
+bool bond_lazy_count(BondLazyDoc *doc, BondLazyNode *node, uint32_t *count)
+{
+    if (node == NULL || !expand(doc, node))
+    {
+        return false;
+    }
+    *count = (node->type == BOND_TYPE_MAP) ? node->child_count / 2 : node->child_count;
+    return true;
+}
+
+BondLazyNode *bond_lazy_child(BondLazyDoc *doc, BondLazyNode *node, uint32_t index)
+{
+    if (node == NULL || node->type == BOND_TYPE_MAP || !expand(doc, node))
+    {
+        return NULL;
+    }
+    return (index < node->child_count) ? &node->children[index] : NULL;
+}
+
+BondLazyNode *bond_lazy_map_key(BondLazyDoc *doc, BondLazyNode *node, uint32_t index)
+{
+    if (node == NULL || node->type != BOND_TYPE_MAP || !expand(doc, node))
+    {
+        return NULL;
+    }
+    return (index < node->child_count / 2) ? &node->children[index * 2] : NULL;
+}
+
+BondLazyNode *bond_lazy_map_value(BondLazyDoc *doc, BondLazyNode *node, uint32_t index)
+{
+    if (node == NULL || node->type != BOND_TYPE_MAP || !expand(doc, node))
+    {
+        return NULL;
+    }
+    return (index < node->child_count / 2) ? &node->children[index * 2 + 1] : NULL;
+}
+
+// ============================================================================
+// Value Access
+// ============================================================================
+
+void bond_lazy_reader(const BondLazyDoc *doc, const BondLazyNode *node,
+                      bond_buffer *view, BondReader *reader)
+{
+    open_at(doc, node->offset, view, reader);
+}
+
+bool bond_lazy_end(BondLazyDoc *doc, BondLazyNode *node, size_t *end)
+{
+    if (node->end == 0)
+    {
+        bond_buffer view;
+        BondReader reader;
+        open_at(doc, node->offset, &view, &reader);
+        if (!bond_reader_skip(&reader, node->type))
+        {
+            return false;
+        }
+        node->end = view.read_pos;
+    }
+    *end = node->end;
+    return true;
+}
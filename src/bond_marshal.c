@@ -0,0 +1,85 @@
+/**
+ * @file bond_marshal.c
+ * @brief Marshaled payload header implementation
+ */
+
+#include "bond_marshal.h"
+
+// Protocol and version folded into one switch key
+#define MARSHAL_KEY(protocol, version) (((uint32_t)(protocol) << 16) | (uint32_t)(version))
+
+void bond_marshal_begin(bond_buffer *buffer, BondProtocolType protocol, uint16_t version)
+{
+    uint8_t header[BOND_MARSHAL_HEADER_SIZE] = {
+        (uint8_t)protocol, (uint8_t)((uint32_t)protocol >> 8),
+        (uint8_t)version, (uint8_t)(version >> 8)
+    };
+    bond_buffer_write(buffer, header, sizeof(header));
+}
+
+bool bond_marshal(bond_buffer *buffer, BondProtocolType protocol, uint16_t version,
+                  const uint8_t *payload, size_t len)
+{
+    size_t start = buffer->size;
+    if (bond_buffer_reserve(buffer, BOND_MARSHAL_HEADER_SIZE + len) != 0)
+    {
+        return false;
+    }
+    bond_marshal_begin(buffer, protocol, version);
+    if (bond_buffer_write(buffer, payload, len) != 0)
+    {
+        buffer->size = start;
+        return false;
+    }
+    return true;
+}
+
+bool bond_marshal_supported(BondProtocolType protocol, uint16_t version)
+{
+    switch (MARSHAL_KEY(protocol, version))
+    {
+        case MARSHAL_KEY(BOND_PROTOCOL_COMPACT, BOND_COMPACT_VERSION_1):
+        case MARSHAL_KEY(BOND_PROTOCOL_COMPACT, BOND_COMPACT_VERSION_2):
+        case MARSHAL_KEY(BOND_PROTOCOL_FAST, 1):
+        case MARSHAL_KEY(BOND_PROTOCOL_SIMPLE, BOND_SIMPLE_VERSION_1):
+        case MARSHAL_KEY(BOND_PROTOCOL_SIMPLE, BOND_SIMPLE_VERSION_2):
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool bond_unmarshal(bond_buffer *buffer, BondUnmarshaled *out)
+{
+    if (bond_buffer_remaining(buffer) < BOND_MARSHAL_HEADER_SIZE)
+    {
+        return false;
+    }
+    const uint8_t *header = buffer->data + buffer->read_pos;
+    uint16_t protocol = (uint16_t)(header[0] | (header[1] << 8));
+    uint16_t version = (uint16_t)(header[2] | (header[3] << 8));
+
+    // One branch on the combined key picks the reader
+    switch (MARSHAL_KEY(protocol, version))
+    {
+        case MARSHAL_KEY(BOND_PROTOCOL_COMPACT, BOND_COMPACT_VERSION_1):
+        case MARSHAL_KEY(BOND_PROTOCOL_COMPACT, BOND_COMPACT_VERSION_2):
+            // v2 is left to the caller to re-encode (bond_compact_transcode)
+            bond_reader_init(&out->reader.compact, buffer);
+            break;
+        case MARSHAL_KEY(BOND_PROTOCOL_FAST, 1):
+            bond_fast_reader_init(&out->reader.fast, buffer);
+            break;
+        case MARSHAL_KEY(BOND_PROTOCOL_SIMPLE, BOND_SIMPLE_VERSION_1):
+        case MARSHAL_KEY(BOND_PROTOCOL_SIMPLE, BOND_SIMPLE_VERSION_2):
+            bond_simple_reader_init(&out->reader.simple, buffer, version);
+            break;
+        default:
+            return false;
+    }
+
+    out->protocol = (BondProtocolType)protocol;
+    out->version = version;
+    buffer->read_pos += BOND_MARSHAL_HEADER_SIZE;
+    return true;
+}
@@ -0,0 +1,927 @@
+/**
+ * @file bond_number.c
+ * @brief Locale-independent number formatting and parsing implementation
+ */
+
+#include "bond_number.h"
+#include "bond_number_tables.h"
+#include <float.h>
+#include <string.h>
+
+// ============================================================================
+// Integers
+// ============================================================================
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t bond_number_format_uint64(char *out, uint64_t value)
+{
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+    while (value >= 100)
+    {
+        const char *pair = digit_pairs + (value % 100) * 2;
+        value /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (value >= 10)
+    {
+        const char *pair = digit_pairs + value * 2;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    else
+    {
+        *--p = (char)('0' + value);
+    }
+    size_t len = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(out, p, len);
+    return len;
+}
+
+size_t bond_number_format_int64(char *out, int64_t value)
+{
+    if (value < 0)
+    {
+        out[0] = '-';
+        return 1 + bond_number_format_uint64(out + 1, 0 - (uint64_t)value);
+    }
+    return bond_number_format_uint64(out, (uint64_t)value);
+}
+
+// ============================================================================
+// Shortest Digits (Ryu)
+// ============================================================================
+
+// floor(log2(5^e)) + 1 for 0 <= e <= 3528
+static int32_t pow5_bits(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)) for 0 <= e <= 1650
+static uint32_t log10_pow2(int32_t e)
+{
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+// floor(log10(5^e)) for 0 <= e <= 2620
+static uint32_t log10_pow5(int32_t e)
+{
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static bool multiple_of_pow5(uint64_t value, uint32_t p)
+{
+    uint32_t count = 0;
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static bool multiple_of_pow2(uint64_t value, uint32_t p)
+{
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// (m * mul) >> j for a 128-bit mul, 64 <= j < 192
+#if defined(__SIZEOF_INT128__)
+
+__extension__ typedef unsigned __int128 uint128;
+
+static uint64_t mul_shift64(uint64_t m, const uint64_t *mul, int32_t j)
+{
+    uint128 b0 = (uint128)m * mul[0];
+    uint128 b2 = (uint128)m * mul[1];
+    return (uint64_t)(((b0 >> 64) + b2) >> (j - 64));
+}
+
+#else
+
+static uint64_t umul128(uint64_t a, uint64_t b, uint64_t *high)
+{
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t b00 = a_lo * b_lo;
+    uint64_t b01 = a_lo * b_hi;
+    uint64_t b10 = a_hi * b_lo;
+    uint64_t b11 = a_hi * b_hi;
+    uint64_t mid1 = b10 + (b00 >> 32);
+    uint64_t mid2 = b01 + (uint32_t)mid1;
+    *high = b11 + (mid1 >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | (uint32_t)b00;
+}
+
+static uint64_t mul_shift64(uint64_t m, const uint64_t *mul, int32_t j)
+{
+    uint64_t high0;
+    uint64_t high1;
+    umul128(m, mul[0], &high0);
+    uint64_t low1 = umul128(m, mul[1], &high1);
+    uint64_t sum = high0 + low1;
+    if (sum < high0)
+    {
+        high1++;
+    }
+    int32_t dist = j - 64;
+    if (dist >= 64)
+    {
+        return high1 >> (dist - 64);
+    }
+    return dist == 0 ? sum : (high1 << (64 - dist)) | (sum >> dist);
+}
+
+#endif
+
+/**
+ * Shortest decimal digits * 10^exponent that rounds back to m2 * 2^e2.
+ *
+ * `e2` is the binary exponent of m2 minus 2 (the interval is worked out on
+ * 4 * m2); `mm_shift` is 0 when the lower neighbour is half as far away
+ * (m2 is a power of two and not the smallest normal). Among the shortest
+ * candidates the one nearest the exact value wins, ties to even. Works for
+ * any m2 below 2^54, so floats use it as well.
+ */
+static uint64_t shortest_digits(uint64_t m2, int32_t e2, uint32_t mm_shift, int32_t *exponent)
+{
+    bool accept_bounds = (m2 & 1) == 0;
+    uint64_t mv = 4 * m2;
+
+    // The interval (vm, vp) around vr, scaled by a power of 10
+    uint64_t vr, vp, vm;
+    int32_t e10;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+    if (e2 >= 0)
+    {
+        uint32_t q = log10_pow2(e2) - (e2 > 3);
+        e10 = (int32_t)q;
+        int32_t k = POW5_INV_BITCOUNT + pow5_bits((int32_t)q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+        vr = mul_shift64(4 * m2, pow5_inv_split[q], i);
+        vp = mul_shift64(4 * m2 + 2, pow5_inv_split[q], i);
+        vm = mul_shift64(4 * m2 - 1 - mm_shift, pow5_inv_split[q], i);
+        if (q <= 21)
+        {
+            // At most one of mv, mp and mm is a multiple of 5
+            if (mv % 5 == 0)
+            {
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            }
+            else if (accept_bounds)
+            {
+                vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+            }
+            else
+            {
+                vp -= multiple_of_pow5(mv + 2, q);
+            }
+        }
+    }
+    else
+    {
+        uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+        e10 = (int32_t)q + e2;
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = pow5_bits(i) - POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+        vr = mul_shift64(4 * m2, pow5_split[i], j);
+        vp = mul_shift64(4 * m2 + 2, pow5_split[i], j);
+        vm = mul_shift64(4 * m2 - 1 - mm_shift, pow5_split[i], j);
+        if (q <= 1)
+        {
+            // mv has at least two trailing zero bits, mp at least one
+            vr_trailing_zeros = true;
+            if (accept_bounds)
+            {
+                vm_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if (q < 63)
+        {
+            vr_trailing_zeros = multiple_of_pow2(mv, q);
+        }
+    }
+
+    // Drop digits while the interval still holds a shorter number
+    int32_t removed = 0;
+    uint8_t last_removed = 0;
+    uint64_t output;
+    if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+        // Exact ties and inclusive bounds; rare
+        while (vp / 10 > vm / 10)
+        {
+            vm_trailing_zeros &= vm % 10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (uint8_t)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vm_trailing_zeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (uint8_t)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0)
+        {
+            last_removed = 4;       // Exactly half way: round to even
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) ||
+                       last_removed >= 5);
+    }
+    else
+    {
+        bool round_up = false;
+        if (vp / 100 > vm / 100)
+        {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10)
+        {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    *exponent = e10 + removed;
+    return output;
+}
+
+// ============================================================================
+// Layout
+// ============================================================================
+
+// digits * 10^exponent in JavaScript's Number.prototype.toString layout
+static size_t write_decimal(char *out, bool negative, uint64_t digits, int32_t exponent)
+{
+    char text[20];
+    int32_t k = (int32_t)bond_number_format_uint64(text, digits);
+    int32_t n = k + exponent;      // Position of the decimal point
+    char *p = out;
+    if (negative)
+    {
+        *p++ = '-';
+    }
+
+    if (k <= n && n <= 21)
+    {
+        memcpy(p, text, (size_t)k);
+        memset(p + k, '0', (size_t)(n - k));
+        p += n;
+    }
+    else if (0 < n && n <= 21)
+    {
+        memcpy(p, text, (size_t)n);
+        p[n] = '.';
+        memcpy(p + n + 1, text + n, (size_t)(k - n));
+        p += k + 1;
+    }
+    else if (-6 < n && n <= 0)
+    {
+        p[0] = '0';
+        p[1] = '.';
+        memset(p + 2, '0', (size_t)-n);
+        memcpy(p + 2 - n, text, (size_t)k);
+        p += 2 - n + k;
+    }
+    else
+    {
+        *p++ = text[0];
+        if (k > 1)
+        {
+            *p++ = '.';
+            memcpy(p, text + 1, (size_t)(k - 1));
+            p += k - 1;
+        }
+        *p++ = 'e';
+        *p++ = n - 1 < 0 ? '-' : '+';
+        p += bond_number_format_uint64(p, (uint64_t)(n - 1 < 0 ? 1 - n : n - 1));
+    }
+    return (size_t)(p - out);
+}
+
+// ============================================================================
+// Floating Point
+// ============================================================================
+
+size_t bond_number_format_double(char *out, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 63) != 0;
+    uint64_t mantissa = bits & ((1ull << 52) - 1);
+    uint32_t biased = (uint32_t)(bits >> 52) & 0x7FF;
+
+    if (biased == 0 && mantissa == 0)
+    {
+        return write_decimal(out, negative, 0, 0);
+    }
+
+    uint64_t m2 = biased == 0 ? mantissa : (1ull << 52) | mantissa;
+    int32_t e2 = (biased == 0 ? 1 : (int32_t)biased) - 1075;
+
+    // Integers below 2^53 print as themselves
+    if (e2 <= 0 && e2 > -53 && (m2 & ((1ull << -e2) - 1)) == 0)
+    {
+        return write_decimal(out, negative, m2 >> -e2, 0);
+    }
+
+    int32_t exponent;
+    uint64_t digits = shortest_digits(m2, e2 - 2, mantissa != 0 || biased <= 1, &exponent);
+    return write_decimal(out, negative, digits, exponent);
+}
+
+size_t bond_number_format_float(char *out, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bool negative = (bits >> 31) != 0;
+    uint32_t mantissa = bits & ((1u << 23) - 1);
+    uint32_t biased = (bits >> 23) & 0xFF;
+
+    if (biased == 0 && mantissa == 0)
+    {
+        return write_decimal(out, negative, 0, 0);
+    }
+
+    uint32_t m2 = biased == 0 ? mantissa : (1u << 23) | mantissa;
+    int32_t e2 = (biased == 0 ? 1 : (int32_t)biased) - 150;
+
+    // Integers below 2^24 print as themselves
+    if (e2 <= 0 && e2 > -24 && (m2 & ((1u << -e2) - 1)) == 0)
+    {
+        return write_decimal(out, negative, m2 >> -e2, 0);
+    }
+
+    int32_t exponent;
+    uint64_t digits = shortest_digits(m2, e2 - 2, mantissa != 0 || biased <= 1, &exponent);
+    return write_decimal(out, negative, digits, exponent);
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+#define FAST_DIGITS 19              // Significant digits kept in a uint64_t
+#define TABLE_DIGITS 17             // Most digits the table path is exact for
+#define DECIMAL_DIGITS 800          // Enough for any halfway point between doubles
+#define EXPONENT_LIMIT 100000       // Decimal exponents saturate here
+
+static const double exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// A scanned token: value = 0.d1d2d3... * 10^dp
+typedef struct {
+    bool negative;
+    bool many;          // More significant digits than fit in `digits`
+    uint64_t digits;    // Leading significant digits, trailing zeros dropped
+    int32_t count;      // Decimal digits in `digits`
+    int32_t dp;         // Decimal point position
+} number_token;
+
+static bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Append a significant digit; zeros are held back until a non-zero follows
+static void add_digit(number_token *t, char c, int32_t *zeros)
+{
+    if (c == '0')
+    {
+        (*zeros)++;
+        return;
+    }
+    if (t->many || t->count + *zeros + 1 > FAST_DIGITS)
+    {
+        t->many = true;
+        return;
+    }
+    for (; *zeros > 0; (*zeros)--)
+    {
+        t->digits *= 10;
+        t->count++;
+    }
+    t->digits = t->digits * 10 + (uint64_t)(c - '0');
+    t->count++;
+}
+
+static bool scan_token(const char *s, size_t len, number_token *t)
+{
+    size_t i = 0;
+    int64_t dp = 0;
+    int32_t zeros = 0;
+    t->negative = len > 0 && s[0] == '-';
+    t->many = false;
+    t->digits = 0;
+    t->count = 0;
+    if (t->negative)
+    {
+        i++;
+    }
+
+    if (i == len || !is_digit(s[i]))
+    {
+        return false;
+    }
+    if (s[i] == '0')
+    {
+        i++;
+    }
+    else
+    {
+        for (; i < len && is_digit(s[i]); i++)
+        {
+            add_digit(t, s[i], &zeros);
+            dp++;
+        }
+    }
+
+    if (i < len && s[i] == '.')
+    {
+        i++;
+        if (i == len || !is_digit(s[i]))
+        {
+            return false;
+        }
+        for (; i < len && is_digit(s[i]); i++)
+        {
+            if (t->count == 0 && s[i] == '0')
+            {
+                dp--;       // Leading zero of a fraction
+            }
+            else
+            {
+                add_digit(t, s[i], &zeros);
+            }
+        }
+    }
+
+    if (i < len && (s[i] == 'e' || s[i] == 'E'))
+    {
+        i++;
+        bool negative = i < len && s[i] == '-';
+        if (i < len && (s[i] == '+' || s[i] == '-'))
+        {
+            i++;
+        }
+        if (i == len || !is_digit(s[i]))
+        {
+            return false;
+        }
+        int64_t exponent = 0;
+        for (; i < len && is_digit(s[i]); i++)
+        {
+            if (exponent < EXPONENT_LIMIT)
+            {
+                exponent = exponent * 10 + (s[i] - '0');
+            }
+        }
+        dp += negative ? -exponent : exponent;
+    }
+
+    if (dp > EXPONENT_LIMIT)
+    {
+        dp = EXPONENT_LIMIT;
+    }
+    else if (dp < -EXPONENT_LIMIT)
+    {
+        dp = -EXPONENT_LIMIT;
+    }
+    t->dp = (int32_t)dp;
+    return i == len;
+}
+
+static int32_t floor_log2(uint64_t value)
+{
+    int32_t log = 0;
+    for (int32_t step = 32; step > 0; step /= 2)
+    {
+        if (value >> step)
+        {
+            value >>= step;
+            log += step;
+        }
+    }
+    return log;
+}
+
+/**
+ * Bits of the double nearest m10 * 10^e10 (m10 below 10^17, result known to
+ * be in range up to overflow), via the formatting tables.
+ *
+ * m10 is scaled into m2 * 2^e2 with m2 holding 54-55 significant bits;
+ * whether the scaling was exact decides halfway cases.
+ */
+static uint64_t table_to_bits(uint64_t m10, int32_t e10)
+{
+    int32_t e2;
+    uint64_t m2;
+    bool trailing_zeros;
+    if (e10 >= 0)
+    {
+        e2 = floor_log2(m10) + e10 + pow5_bits(e10) - 1 - 53;
+        int32_t j = e2 - e10 - pow5_bits(e10) + POW5_BITCOUNT;
+        m2 = mul_shift64(m10, pow5_split[e10], j);
+        trailing_zeros = e2 < e10 || (e2 - e10 < 64 && multiple_of_pow2(m10, (uint32_t)(e2 - e10)));
+    }
+    else
+    {
+        e2 = floor_log2(m10) + e10 - pow5_bits(-e10) - 53;
+        int32_t j = e2 - e10 + pow5_bits(-e10) - 1 + POW5_INV_BITCOUNT;
+        m2 = mul_shift64(m10, pow5_inv_split[-e10], j);
+        trailing_zeros = multiple_of_pow5(m10, (uint32_t)-e10);
+    }
+
+    int32_t biased = e2 + 1023 + floor_log2(m2);
+    if (biased < 0)
+    {
+        biased = 0;
+    }
+    if (biased > 0x7FE)
+    {
+        return 0x7FFull << 52;
+    }
+
+    // Drop the bits below the mantissa, rounding half to even
+    int32_t shift = (biased == 0 ? 1 : biased) - e2 - 1023 - 52;
+    trailing_zeros &= (m2 & ((1ull << (shift - 1)) - 1)) == 0;
+    bool last_removed = ((m2 >> (shift - 1)) & 1) != 0;
+    bool round_up = last_removed && (!trailing_zeros || ((m2 >> shift) & 1) != 0);
+    uint64_t mantissa = ((m2 >> shift) + round_up) & ((1ull << 52) - 1);
+    if (mantissa == 0 && round_up)
+    {
+        biased++;       // Carried into the exponent
+    }
+    return ((uint64_t)biased << 52) | mantissa;
+}
+
+// Exact decimal for long inputs: digits most significant first, value
+// 0.d[0]d[1]... * 10^dp. Shifts by powers of two are done digit by digit.
+typedef struct {
+    uint8_t d[DECIMAL_DIGITS + 24];     // Room for a left shift's new digits
+    int32_t nd;
+    int32_t dp;
+    bool trunc;                         // Non-zero digits dropped past d[]
+} big_decimal;
+
+#define MAX_SHIFT 60
+
+static void trim_zeros(big_decimal *a)
+{
+    while (a->nd > 0 && a->d[a->nd - 1] == 0)
+    {
+        a->nd--;
+    }
+    if (a->nd == 0)
+    {
+        a->dp = 0;
+    }
+}
+
+// a *= 2^k, k <= MAX_SHIFT
+static void left_shift(big_decimal *a, unsigned k)
+{
+    // Upper bound on the digits gained: ceil(k * log10(2))
+    int32_t delta = (int32_t)((k * 1233) >> 12) + 1;
+    int32_t w = a->nd + delta;
+    uint64_t n = 0;
+    for (int32_t r = a->nd - 1; r >= 0; r--)
+    {
+        n += (uint64_t)a->d[r] << k;
+        uint64_t quo = n / 10;
+        a->d[--w] = (uint8_t)(n - 10 * quo);
+        n = quo;
+    }
+    while (n > 0)
+    {
+        uint64_t quo = n / 10;
+        a->d[--w] = (uint8_t)(n - 10 * quo);
+        n = quo;
+    }
+
+    int32_t nd = a->nd + delta - w;
+    memmove(a->d, a->d + w, (size_t)nd);
+    a->dp += nd - a->nd;
+    if (nd > DECIMAL_DIGITS)
+    {
+        for (int32_t i = DECIMAL_DIGITS; i < nd; i++)
+        {
+            a->trunc |= a->d[i] != 0;
+        }
+        nd = DECIMAL_DIGITS;
+    }
+    a->nd = nd;
+    trim_zeros(a);
+}
+
+// a /= 2^k, k <= MAX_SHIFT
+static void right_shift(big_decimal *a, unsigned k)
+{
+    int32_t r = 0;
+    int32_t w = 0;
+    uint64_t n = 0;
+    for (; (n >> k) == 0; r++)
+    {
+        if (r >= a->nd)
+        {
+            if (n == 0)
+            {
+                a->nd = 0;
+                return;
+            }
+            while ((n >> k) == 0)
+            {
+                n *= 10;
+                r++;
+            }
+            break;
+        }
+        n = n * 10 + a->d[r];
+    }
+    a->dp -= r - 1;
+
+    uint64_t mask = (1ull << k) - 1;
+    for (; r < a->nd; r++)
+    {
+        uint8_t c = a->d[r];
+        a->d[w++] = (uint8_t)(n >> k);
+        n = (n & mask) * 10 + c;
+    }
+    while (n > 0)
+    {
+        uint8_t digit = (uint8_t)(n >> k);
+        n &= mask;
+        if (w < DECIMAL_DIGITS)
+        {
+            a->d[w++] = digit;
+        }
+        else if (digit > 0)
+        {
+            a->trunc = true;
+        }
+        n *= 10;
+    }
+    a->nd = w;
+    trim_zeros(a);
+}
+
+static void shift_decimal(big_decimal *a, int32_t k)
+{
+    for (; k > MAX_SHIFT; k -= MAX_SHIFT)
+    {
+        left_shift(a, MAX_SHIFT);
+    }
+    for (; k < -MAX_SHIFT; k += MAX_SHIFT)
+    {
+        right_shift(a, MAX_SHIFT);
+    }
+    if (k > 0)
+    {
+        left_shift(a, (unsigned)k);
+    }
+    else if (k < 0)
+    {
+        right_shift(a, (unsigned)-k);
+    }
+}
+
+// Integer part of a (below 2^64), rounded half to even on the fraction
+static uint64_t rounded_integer(const big_decimal *a)
+{
+    uint64_t n = 0;
+    int32_t i = 0;
+    for (; i < a->dp && i < a->nd; i++)
+    {
+        n = n * 10 + a->d[i];
+    }
+    for (; i < a->dp; i++)
+    {
+        n *= 10;
+    }
+    int32_t dp = a->dp;
+    if (dp >= 0 && dp < a->nd)
+    {
+        bool up = a->d[dp] > 5 || (a->d[dp] == 5 && (dp + 1 < a->nd || a->trunc));
+        if (a->d[dp] == 5 && dp + 1 == a->nd && !a->trunc)
+        {
+            up = dp > 0 && (a->d[dp - 1] & 1) != 0;     // Exactly half way
+        }
+        n += up;
+    }
+    return n;
+}
+
+// An IEEE binary format: exponent bias is max_exp, all-ones exponent is inf
+typedef struct {
+    int32_t mantissa_bits;      // Stored bits, without the implicit one
+    int32_t min_exp;
+    int32_t max_exp;
+} binary_format;
+
+static const binary_format binary64 = { 52, -1022, 1023 };
+static const binary_format binary32 = { 23, -126, 127 };
+
+static uint64_t infinity_bits(const binary_format *f)
+{
+    return (uint64_t)(2 * f->max_exp + 1) << f->mantissa_bits;
+}
+
+/**
+ * Bits of the value in format `f` nearest the digits of `s` (sign, point and
+ * exponent skipped) placed at decimal position `dp`.
+ *
+ * Halve or double the decimal until it lies in [0.5, 1), which gives the
+ * binary exponent, then shift in the mantissa bits and round.
+ */
+static uint64_t decimal_to_bits(const char *s, size_t len, int32_t dp, const binary_format *f)
+{
+    static const int32_t pow2_steps[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    big_decimal a;
+    a.nd = 0;
+    a.trunc = false;
+    for (size_t i = 0; i < len && s[i] != 'e' && s[i] != 'E'; i++)
+    {
+        if (!is_digit(s[i]) || (a.nd == 0 && s[i] == '0'))
+        {
+            continue;
+        }
+        if (a.nd < DECIMAL_DIGITS)
+        {
+            a.d[a.nd++] = (uint8_t)(s[i] - '0');
+        }
+        else if (s[i] != '0')
+        {
+            a.trunc = true;
+        }
+    }
+    a.dp = dp;
+    trim_zeros(&a);
+
+    int32_t exp = 0;
+    while (a.dp > 0)
+    {
+        int32_t n = a.dp >= 9 ? 27 : pow2_steps[a.dp];
+        shift_decimal(&a, -n);
+        exp += n;
+    }
+    while (a.dp < 0 || (a.dp == 0 && a.d[0] < 5))
+    {
+        int32_t n = -a.dp >= 9 ? 27 : pow2_steps[-a.dp];
+        shift_decimal(&a, n);
+        exp -= n;
+    }
+    exp--;          // Now value = 1.x * 2^exp
+
+    // Below the normal range the mantissa loses bits instead
+    if (exp < f->min_exp)
+    {
+        shift_decimal(&a, -(f->min_exp - exp));
+        exp = f->min_exp;
+    }
+    if (exp > f->max_exp)
+    {
+        return infinity_bits(f);
+    }
+
+    uint64_t one = 1ull << f->mantissa_bits;
+    shift_decimal(&a, f->mantissa_bits + 1);
+    uint64_t mantissa = rounded_integer(&a);
+    if (mantissa == 2 * one)
+    {
+        mantissa >>= 1;
+        if (++exp > f->max_exp)
+        {
+            return infinity_bits(f);
+        }
+    }
+    uint64_t biased = (mantissa & one) != 0 ? (uint64_t)(exp + f->max_exp) : 0;
+    return (biased << f->mantissa_bits) | (mantissa & (one - 1));
+}
+
+bool bond_number_parse_double(const char *text, size_t len, double *value)
+{
+    number_token t;
+    if (!scan_token(text, len, &t))
+    {
+        return false;
+    }
+
+    uint64_t bits;
+    int32_t e10 = t.dp - t.count;
+    if (t.count == 0 || t.dp < -324)
+    {
+        bits = 0;                   // Below half the smallest denormal
+    }
+    else if (t.dp > 310)
+    {
+        bits = 0x7FFull << 52;
+    }
+#if FLT_EVAL_METHOD == 0
+    else if (!t.many && t.digits <= (1ull << 53) && e10 >= -22 && e10 <= 22)
+    {
+        // Both operands exact, so the one rounding is the only one
+        double d = (double)t.digits;
+        *value = e10 < 0 ? d / exact_pow10[-e10] : d * exact_pow10[e10];
+        if (t.negative)
+        {
+            *value = -*value;
+        }
+        return true;
+    }
+#endif
+    else if (!t.many && t.count <= TABLE_DIGITS)
+    {
+        bits = table_to_bits(t.digits, e10);
+    }
+    else
+    {
+        bits = decimal_to_bits(text, len, t.dp, &binary64);
+    }
+
+    bits |= (uint64_t)t.negative << 63;
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+/**
+ * Whether `d` lies exactly half way between two adjacent floats (or between
+ * zero and the smallest denormal float): an odd multiple of half a float ulp.
+ */
+static bool is_float_midpoint(double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    int32_t biased = (int32_t)((bits >> 52) & 0x7FF);
+    if (biased == 0 || biased == 0x7FF)
+    {
+        return false;       // Zero, far below any float, or not finite
+    }
+    uint64_t m = (bits & ((1ull << 52) - 1)) | (1ull << 52);
+    int32_t e = biased - 1023;
+    int32_t half_ulp = (e < -126 ? -126 : e) - 24;
+    int32_t s = half_ulp - (e - 52);
+    return s <= 52 && (m & ((2ull << s) - 1)) == 1ull << s;
+}
+
+bool bond_number_parse_float(const char *text, size_t len, float *value)
+{
+    double d;
+    if (!bond_number_parse_double(text, len, &d))
+    {
+        return false;
+    }
+
+    // The double is correctly rounded, and rounding is monotonic, so it
+    // rounds to the same float as the decimal unless it landed exactly on a
+    // float halfway point; only then is the decimal itself consulted
+    if (!is_float_midpoint(d))
+    {
+        *value = (float)d;
+        return true;
+    }
+
+    number_token t;
+    scan_token(text, len, &t);
+    uint32_t bits = (uint32_t)decimal_to_bits(text, len, t.dp, &binary32);
+    bits |= (uint32_t)t.negative << 31;
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
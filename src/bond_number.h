@@ -0,0 +1,56 @@
+/**
+ * @file bond_number.h
+ * @brief Locale-independent number formatting and parsing (library internal)
+ *
+ * Integers are written two digits at a time. Finite doubles and floats are
+ * written with the fewest significant digits that read back to the same
+ * value (Ryu: the shortest decimal in the rounding interval, found with
+ * 128-bit fixed-point powers of 5), in JavaScript's layout: plain digits
+ * for decimal exponents -7 < e < 21, `d.ddde+XX` / `d.ddde-XX` outside.
+ *
+ * Parsing is correctly rounded for any number of digits: short inputs are
+ * converted with one exact double operation, up to 17 significant digits
+ * with the same power-of-5 tables, and anything longer by exact decimal
+ * arithmetic. No libc stdio or strtod is involved, so the current locale
+ * never matters.
+ */
+
+#ifndef BOND_NUMBER_H
+#define BOND_NUMBER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BOND_NUMBER_MAX_TEXT 32     // Longest output of any formatter, rounded up
+
+/**
+ * @return characters written to out (not NUL-terminated)
+ */
+size_t bond_number_format_uint64(char *out, uint64_t value);
+size_t bond_number_format_int64(char *out, int64_t value);
+
+/**
+ * Shortest round-trip text of a finite value; -0 keeps its sign
+ *
+ * @return characters written to out (not NUL-terminated)
+ */
+size_t bond_number_format_double(char *out, double value);
+size_t bond_number_format_float(char *out, float value);
+
+/**
+ * Parse a JSON number token, -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?,
+ * to the nearest double (ties to even); out-of-range values become
+ * +-infinity or +-0
+ *
+ * @return false unless all `len` bytes form one such token
+ */
+bool bond_number_parse_double(const char *text, size_t len, double *value);
+
+/**
+ * Same as bond_number_parse_double, rounded once, straight to the nearest
+ * float (never through a double)
+ */
+bool bond_number_parse_float(const char *text, size_t len, float *value);
+
+#endif // BOND_NUMBER_H
@@ -0,0 +1,475 @@
+/**
+ * @file bond_parallel.c
+ * @brief Thread pool and parallel list writing and decoding
+ *
+ * Parallel list writing runs two jobs on the pool. In the first, workers
+ * claim chunks of elements from an atomic counter and serialize each chunk
+ * into its own pooled buffer. The caller then sums the chunk sizes, reserves
+ * the output once and hands out destination offsets; in the second job
+ * workers claim chunks again and copy them into place.
+ *
+ * Parallel list reading is the reverse: bond_reader_list_offsets() finds
+ * every element boundary on the calling thread, then workers claim chunks
+ * of elements and decode each through a reader bounded to its bytes.
+ */
+
+#include "bond_parallel.h"
+#include "bond_pool.h"
+#include "bond_reader.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MIN_PARALLEL_ITEMS 256      // Shorter lists stay on the calling thread
+#define CHUNKS_PER_WORKER 32        // Enough slack to even out uneven elements
+#define MIN_CHUNK_ITEMS 16
+#define MAX_CHUNK_ITEMS 4096
+
+struct bond_thread_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;            // Signals a new generation or stopping
+    pthread_cond_t idle;            // Signals the last worker finishing a job
+    pthread_t *threads;
+    unsigned thread_count;          // Participants minus the caller
+    uint64_t generation;            // Bumped per job
+    unsigned running;               // Threads still inside the current job
+    bool stopping;
+    bond_parallel_fn fn;
+    void *arg;
+};
+
+typedef struct {
+    bond_thread_pool *pool;
+    unsigned worker;
+} worker_start;
+
+// ============================================================================
+// Thread Pool
+// ============================================================================
+
+static void *worker_main(void *arg)
+{
+    worker_start start = *(worker_start *)arg;
+    free(arg);
+    bond_thread_pool *pool = start.pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true)
+    {
+        while (pool->generation == seen && !pool->stopping)
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stopping)
+        {
+            break;
+        }
+        seen = pool->generation;
+        bond_parallel_fn fn = pool->fn;
+        void *job_arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        fn(job_arg, start.worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0)
+        {
+            pthread_cond_signal(&pool->idle);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    // Jobs acquire pooled buffers on this thread
+    bond_buffer_pool_trim();
+    return NULL;
+}
+
+static void stop_threads(bond_thread_pool *pool, unsigned started)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (unsigned i = 0; i < started; i++)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+}
+
+bond_thread_pool *bond_thread_pool_create(unsigned workers)
+{
+    if (workers == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = online > 0 ? (unsigned)online : 1;
+    }
+
+    bond_thread_pool *pool = (bond_thread_pool *)calloc(1, sizeof(*pool));
+    if (pool == NULL)
+    {
+        return NULL;
+    }
+    pool->thread_count = workers - 1;
+    pool->threads = (pthread_t *)calloc(workers, sizeof(pthread_t));
+    if (pool->threads == NULL)
+    {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+
+    for (unsigned i = 0; i < pool->thread_count; i++)
+    {
+        worker_start *start = (worker_start *)malloc(sizeof(*start));
+        if (start != NULL)
+        {
+            start->pool = pool;
+            start->worker = i + 1;
+        }
+        if (start == NULL || pthread_create(&pool->threads[i], NULL, worker_main, start) != 0)
+        {
+            free(start);
+            pool->thread_count = i;
+            bond_thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void bond_thread_pool_destroy(bond_thread_pool *pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+    stop_threads(pool, pool->thread_count);
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+unsigned bond_thread_pool_size(const bond_thread_pool *pool)
+{
+    return pool->thread_count + 1;
+}
+
+void bond_thread_pool_run(bond_thread_pool *pool, bond_parallel_fn fn, void *arg)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->running = pool->thread_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    fn(arg, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0)
+    {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// ============================================================================
+// Chunking
+// ============================================================================
+
+// Elements per claim: ~CHUNKS_PER_WORKER claims per worker, within limits
+static size_t chunk_items_for(uint32_t count, unsigned workers)
+{
+    size_t items = count / ((size_t)workers * CHUNKS_PER_WORKER);
+    if (items < MIN_CHUNK_ITEMS)
+    {
+        return MIN_CHUNK_ITEMS;
+    }
+    if (items > MAX_CHUNK_ITEMS)
+    {
+        return MAX_CHUNK_ITEMS;
+    }
+    return items;
+}
+
+// ============================================================================
+// Parallel Struct List
+// ============================================================================
+
+typedef struct {
+    bond_buffer buffer;
+    bond_buffer_pool *owner;        // Pool the buffer was acquired from
+    size_t offset;                  // Destination, set between the two jobs
+} list_chunk;
+
+typedef struct {
+    const void *items;
+    uint32_t count;
+    size_t chunk_items;
+    size_t chunk_count;
+    bond_struct_list_fn serialize_fn;
+    list_chunk *chunks;
+    uint8_t *dest;
+    _Atomic size_t next;            // Next chunk to claim
+    _Atomic bool failed;
+} list_job;
+
+// Learns the typical chunk size so chunk buffers rarely grow
+static bond_buffer_site chunk_site;
+
+static void release_chunk(list_chunk *chunk)
+{
+    if (chunk->owner == bond_buffer_pool_current())
+    {
+        bond_buffer_release_at(&chunk->buffer, &chunk_site);
+    }
+    else
+    {
+        bond_buffer_release_to(&chunk->buffer, chunk->owner);
+    }
+}
+
+static bool serialize_range(bond_writer *writer, const void *items, size_t begin,
+                            size_t end, bond_struct_list_fn serialize_fn)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        bond_writer_struct_begin(writer);
+        if (!serialize_fn(writer, items, i))
+        {
+            return false;
+        }
+        bond_writer_struct_end(writer);
+    }
+    return true;
+}
+
+static void serialize_chunks(void *arg, unsigned worker)
+{
+    list_job *job = (list_job *)arg;
+    (void)worker;
+    while (!atomic_load_explicit(&job->failed, memory_order_relaxed))
+    {
+        size_t index = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed);
+        if (index >= job->chunk_count)
+        {
+            break;
+        }
+        list_chunk *chunk = &job->chunks[index];
+        if (bond_buffer_acquire_at(&chunk->buffer, &chunk_site) != 0)
+        {
+            atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+            break;
+        }
+        chunk->owner = bond_buffer_pool_current();
+
+        size_t begin = index * job->chunk_items;
+        size_t end = begin + job->chunk_items;
+        if (end > job->count)
+        {
+            end = job->count;
+        }
+        bond_writer writer;
+        bond_writer_init(&writer, &chunk->buffer);
+        if (!serialize_range(&writer, job->items, begin, end, job->serialize_fn))
+        {
+            atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+static void copy_chunks(void *arg, unsigned worker)
+{
+    list_job *job = (list_job *)arg;
+    (void)worker;
+    while (true)
+    {
+        size_t index = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed);
+        if (index >= job->chunk_count)
+        {
+            break;
+        }
+        list_chunk *chunk = &job->chunks[index];
+        memcpy(job->dest + chunk->offset, chunk->buffer.data, chunk->buffer.size);
+        release_chunk(chunk);
+    }
+}
+
+bool bond_writer_write_struct_list_parallel(bond_writer *writer, uint16_t field_id,
+                                            const void *items, uint32_t count,
+                                            bond_struct_list_fn serialize_fn,
+                                            bond_thread_pool *pool)
+{
+    bond_buffer *buffer = writer->buffer;
+    size_t mark = buffer->size;
+    bond_writer_write_list_begin(writer, field_id, BOND_TYPE_STRUCT, count);
+
+    unsigned workers = pool != NULL ? bond_thread_pool_size(pool) : 1;
+    if (workers == 1 || count < MIN_PARALLEL_ITEMS)
+    {
+        if (!serialize_range(writer, items, 0, count, serialize_fn))
+        {
+            buffer->size = mark;
+            return false;
+        }
+        return true;
+    }
+
+    list_job job;
+    job.items = items;
+    job.count = count;
+    job.chunk_items = chunk_items_for(count, workers);
+    job.chunk_count = (count + job.chunk_items - 1) / job.chunk_items;
+    job.serialize_fn = serialize_fn;
+    job.dest = NULL;
+    atomic_init(&job.next, 0);
+    atomic_init(&job.failed, false);
+    job.chunks = (list_chunk *)calloc(job.chunk_count, sizeof(list_chunk));
+    if (job.chunks == NULL)
+    {
+        buffer->size = mark;
+        return false;
+    }
+
+    bond_thread_pool_run(pool, serialize_chunks, &job);
+
+    size_t total = 0;
+    if (!atomic_load(&job.failed))
+    {
+        for (size_t i = 0; i < job.chunk_count; i++)
+        {
+            job.chunks[i].offset = buffer->size + total;
+            total += job.chunks[i].buffer.size;
+        }
+    }
+    if (atomic_load(&job.failed) || bond_buffer_reserve(buffer, total) != 0)
+    {
+        for (size_t i = 0; i < job.chunk_count; i++)
+        {
+            if (job.chunks[i].buffer.data != NULL)
+            {
+                release_chunk(&job.chunks[i]);
+            }
+        }
+        free(job.chunks);
+        buffer->size = mark;
+        return false;
+    }
+
+    job.dest = buffer->data;
+    atomic_store(&job.next, 0);
+    bond_thread_pool_run(pool, copy_chunks, &job);
+    buffer->size += total;
+    free(job.chunks);
+    return true;
+}
+
+// ============================================================================
+// Parallel List Decode
+// ============================================================================
+
+typedef struct {
+    const uint8_t *data;
+    const size_t *offsets;
+    uint32_t count;
+    size_t chunk_items;
+    uint32_t flags;                 // Copied from the caller's reader
+    bond_list_element_fn element_fn;
+    void *ctx;
+    _Atomic size_t next;            // Next chunk to claim
+    _Atomic bool failed;
+} decode_job;
+
+static void decode_chunks(void *arg, unsigned worker)
+{
+    decode_job *job = (decode_job *)arg;
+    (void)worker;
+    while (!atomic_load_explicit(&job->failed, memory_order_relaxed))
+    {
+        size_t begin = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed) *
+                       job->chunk_items;
+        if (begin >= job->count)
+        {
+            break;
+        }
+        size_t end = begin + job->chunk_items;
+        if (end > job->count)
+        {
+            end = job->count;
+        }
+        for (size_t i = begin; i < end; i++)
+        {
+            bond_buffer element;
+            BondReader reader;
+            bond_buffer_init_from(&element, job->data + job->offsets[i],
+                                  job->offsets[i + 1] - job->offsets[i]);
+            bond_reader_init(&reader, &element);
+            bond_reader_set_flags(&reader, job->flags);
+            if (!job->element_fn(&reader, (uint32_t)i, job->ctx))
+            {
+                atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+                return;
+            }
+        }
+    }
+}
+
+bool bond_reader_read_list_parallel(BondReader *reader, uint8_t element_type,
+                                    uint32_t count, bond_list_element_fn element_fn,
+                                    void *ctx, bond_thread_pool *pool)
+{
+    bond_buffer *buffer = reader->buffer;
+    size_t start = buffer->read_pos;
+    if (count > bond_buffer_remaining(buffer))
+    {
+        return false;       // Every element takes at least one byte
+    }
+    size_t *offsets = (size_t *)malloc(((size_t)count + 1) * sizeof(size_t));
+    if (offsets == NULL)
+    {
+        return false;
+    }
+    if (!bond_reader_list_offsets(reader, element_type, count, offsets))
+    {
+        free(offsets);
+        return false;
+    }
+
+    unsigned workers = pool != NULL ? bond_thread_pool_size(pool) : 1;
+    decode_job job;
+    job.data = buffer->data;
+    job.offsets = offsets;
+    job.count = count;
+    job.chunk_items = chunk_items_for(count, workers);
+    job.flags = reader->flags;
+    job.element_fn = element_fn;
+    job.ctx = ctx;
+    atomic_init(&job.next, 0);
+    atomic_init(&job.failed, false);
+
+    if (workers == 1 || count < MIN_PARALLEL_ITEMS)
+    {
+        decode_chunks(&job, 0);
+    }
+    else
+    {
+        bond_thread_pool_run(pool, decode_chunks, &job);
+    }
+    free(offsets);
+
+    if (atomic_load(&job.failed))
+    {
+        buffer->read_pos = start;
+        return false;
+    }
+    return true;
+}
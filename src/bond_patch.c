@@ -0,0 +1,391 @@
+/**
+ * @file bond_patch.c
+ * @brief In-place field patching implementation
+ */
+
+#include "bond_patch.h"
+#include "bond_reader.h"
+#include "bond_encoding.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+// Walk the top-level fields of the struct at the buffer's read position,
+// calling `visit` for each. Stops early when `visit` returns false.
+typedef bool (*field_visitor)(const BondPatchField *field, void *ctx);
+
+static bool scan_fields(const bond_buffer *buffer, field_visitor visit, void *ctx)
+{
+    bond_buffer view;
+    bond_buffer_init_from(&view, buffer->data, buffer->size);
+    view.read_pos = buffer->read_pos;
+    BondReader reader;
+    bond_reader_init(&reader, &view);
+
+    while (true)
+    {
+        BondPatchField field;
+        if (!bond_reader_read_field_header(&reader, &field.field_id, &field.type))
+        {
+            return false;
+        }
+        if (field.type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        if (field.type == BOND_TYPE_STOP_BASE)
+        {
+            continue;
+        }
+
+        field.offset = view.read_pos;
+        if (!bond_reader_skip(&reader, field.type))
+        {
+            return false;
+        }
+        field.end = view.read_pos;
+        if (!visit(&field, ctx))
+        {
+            return true;
+        }
+    }
+}
+
+typedef struct {
+    BondPatchIndex *index;
+    uint32_t capacity;
+    bool failed;
+} build_ctx;
+
+static bool append_field(const BondPatchField *field, void *ctx)
+{
+    build_ctx *build = (build_ctx *)ctx;
+    BondPatchIndex *index = build->index;
+    if (index->count == build->capacity)
+    {
+        uint32_t new_capacity = build->capacity ? build->capacity * 2 : 8;
+        BondPatchField *grown = (BondPatchField *)realloc(
+            index->fields, new_capacity * sizeof(BondPatchField));
+        if (grown == NULL)
+        {
+            build->failed = true;
+            return false;
+        }
+        index->fields = grown;
+        build->capacity = new_capacity;
+    }
+    index->fields[index->count++] = *field;
+    return true;
+}
+
+typedef struct {
+    uint16_t field_id;
+    BondPatchField found;
+    bool matched;
+} find_ctx;
+
+static bool match_field(const BondPatchField *field, void *ctx)
+{
+    find_ctx *find = (find_ctx *)ctx;
+    if (field->field_id != find->field_id)
+    {
+        return true;
+    }
+    find->found = *field;
+    find->matched = true;
+    return false;
+}
+
+// Locate a field through the index, or by scanning when there is none.
+// `position` receives the index slot (unused without an index).
+static bool locate(const bond_buffer *buffer, const BondPatchIndex *index,
+                   uint16_t field_id, BondPatchField *field, uint32_t *position)
+{
+    if (index != NULL)
+    {
+        const BondPatchField *entry = bond_patch_index_find(index, field_id);
+        if (entry == NULL)
+        {
+            return false;
+        }
+        *field = *entry;
+        *position = (uint32_t)(entry - index->fields);
+        return true;
+    }
+
+    find_ctx find = { field_id, { 0, 0, 0, 0 }, false };
+    if (!scan_fields(buffer, match_field, &find) || !find.matched)
+    {
+        return false;
+    }
+    *field = find.found;
+    return true;
+}
+
+// Whether `len` bytes at `p` overlap the buffer's contents, e.g. a string
+// read zero-copy from the record being patched
+static bool aliases_buffer(const bond_buffer *buffer, const uint8_t *p, size_t len)
+{
+    uintptr_t start = (uintptr_t)buffer->data;
+    uintptr_t at = (uintptr_t)p;
+    return len > 0 && buffer->data != NULL &&
+           at < start + buffer->size && at + len > start;
+}
+
+/**
+ * Replace the bytes of `field` with prefix + body.
+ *
+ * Same length: plain overwrite. Otherwise the tail of the buffer is moved
+ * once to open or close the gap, and every later index entry is shifted by
+ * the size difference. A body inside the buffer would be moved by that (or
+ * freed by a reallocation), so it is copied out first; the prefix is always
+ * a local encoding.
+ */
+static bool splice(bond_buffer *buffer, BondPatchIndex *index, uint32_t position,
+                   const BondPatchField *field,
+                   const uint8_t *prefix, size_t prefix_len,
+                   const uint8_t *body, size_t body_len)
+{
+    uint8_t *staged = NULL;
+    if (aliases_buffer(buffer, body, body_len))
+    {
+        staged = (uint8_t *)malloc(body_len);
+        if (staged == NULL)
+        {
+            return false;
+        }
+        memcpy(staged, body, body_len);
+        body = staged;
+    }
+
+    size_t old_len = field->end - field->offset;
+    size_t new_len = prefix_len + body_len;
+
+    if (new_len != old_len)
+    {
+        if (new_len > old_len)
+        {
+            size_t grow = new_len - old_len;
+            // Wrapped (non-owned) memory cannot be reallocated
+            if (buffer->size + grow > buffer->capacity &&
+                (!buffer->owns_memory || bond_buffer_reserve(buffer, grow) != 0))
+            {
+                free(staged);
+                return false;
+            }
+        }
+        memmove(buffer->data + field->offset + new_len, buffer->data + field->end,
+                buffer->size - field->end);
+        buffer->size = buffer->size - old_len + new_len;
+
+        if (index != NULL)
+        {
+            index->fields[position].end = field->offset + new_len;
+            for (uint32_t i = position + 1; i < index->count; i++)
+            {
+                index->fields[i].offset = index->fields[i].offset - old_len + new_len;
+                index->fields[i].end = index->fields[i].end - old_len + new_len;
+            }
+        }
+    }
+
+    if (prefix_len > 0)
+    {
+        memcpy(buffer->data + field->offset, prefix, prefix_len);
+    }
+    if (body_len > 0)
+    {
+        memcpy(buffer->data + field->offset + prefix_len, body, body_len);
+    }
+    free(staged);
+    return true;
+}
+
+// ============================================================================
+// Field Index
+// ============================================================================
+
+bool bond_patch_index_build(BondPatchIndex *index, const bond_buffer *buffer)
+{
+    index->fields = NULL;
+    index->count = 0;
+    build_ctx build = { index, 0, false };
+    if (!scan_fields(buffer, append_field, &build) || build.failed)
+    {
+        bond_patch_index_destroy(index);
+        return false;
+    }
+    return true;
+}
+
+void bond_patch_index_destroy(BondPatchIndex *index)
+{
+    free(index->fields);
+    index->fields = NULL;
+    index->count = 0;
+}
+
+const BondPatchField *bond_patch_index_find(const BondPatchIndex *index, uint16_t field_id)
+{
+    for (uint32_t i = 0; i < index->count; i++)
+    {
+        if (index->fields[i].field_id == field_id)
+        {
+            return &index->fields[i];
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Patching
+// ============================================================================
+
+bool bond_patch_raw(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                    const uint8_t *value, size_t len)
+{
+    BondPatchField field;
+    uint32_t position = 0;
+    if (!locate(buffer, index, field_id, &field, &position))
+    {
+        return false;
+    }
+    return splice(buffer, index, position, &field, NULL, 0, value, len);
+}
+
+bool bond_patch_uint(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                     uint64_t value)
+{
+    BondPatchField field;
+    uint32_t position = 0;
+    if (!locate(buffer, index, field_id, &field, &position))
+    {
+        return false;
+    }
+
+    uint8_t encoded[10];
+    size_t len;
+    switch (field.type)
+    {
+        case BOND_TYPE_BOOL:
+            if (value > 1)
+            {
+                return false;
+            }
+            encoded[0] = (uint8_t)value;
+            len = 1;
+            break;
+        case BOND_TYPE_UINT8:
+            if (value > UINT8_MAX)
+            {
+                return false;
+            }
+            encoded[0] = (uint8_t)value;
+            len = 1;
+            break;
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_UINT32:
+            if (value > (field.type == BOND_TYPE_UINT16 ? UINT16_MAX : UINT32_MAX))
+            {
+                return false;
+            }
+            len = bond_encode_varint32(encoded, (uint32_t)value);
+            break;
+        case BOND_TYPE_UINT64:
+            len = bond_encode_varint64(encoded, value);
+            break;
+        default:
+            return false;
+    }
+    return splice(buffer, index, position, &field, NULL, 0, encoded, len);
+}
+
+bool bond_patch_int(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                    int64_t value)
+{
+    BondPatchField field;
+    uint32_t position = 0;
+    if (!locate(buffer, index, field_id, &field, &position))
+    {
+        return false;
+    }
+
+    uint8_t encoded[10];
+    size_t len;
+    switch (field.type)
+    {
+        case BOND_TYPE_INT8:
+            if (value < INT8_MIN || value > INT8_MAX)
+            {
+                return false;
+            }
+            encoded[0] = (uint8_t)(int8_t)value;
+            len = 1;
+            break;
+        case BOND_TYPE_INT16:
+            if (value < INT16_MIN || value > INT16_MAX)
+            {
+                return false;
+            }
+            len = bond_encode_varint32(encoded, bond_zigzag_encode32((int32_t)value));
+            break;
+        case BOND_TYPE_INT32:
+            if (value < INT32_MIN || value > INT32_MAX)
+            {
+                return false;
+            }
+            len = bond_encode_varint32(encoded, bond_zigzag_encode32((int32_t)value));
+            break;
+        case BOND_TYPE_INT64:
+            len = bond_encode_varint64(encoded, bond_zigzag_encode64(value));
+            break;
+        default:
+            return false;
+    }
+    return splice(buffer, index, position, &field, NULL, 0, encoded, len);
+}
+
+bool bond_patch_double(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                       double value)
+{
+    BondPatchField field;
+    uint32_t position = 0;
+    if (!locate(buffer, index, field_id, &field, &position))
+    {
+        return false;
+    }
+
+    // Fixed width: always an in-place overwrite
+    uint8_t encoded[8];
+    if (field.type == BOND_TYPE_FLOAT)
+    {
+        bond_encode_float(encoded, (float)value);
+        return splice(buffer, index, position, &field, NULL, 0, encoded, 4);
+    }
+    if (field.type == BOND_TYPE_DOUBLE)
+    {
+        bond_encode_double(encoded, value);
+        return splice(buffer, index, position, &field, NULL, 0, encoded, 8);
+    }
+    return false;
+}
+
+bool bond_patch_string(bond_buffer *buffer, BondPatchIndex *index, uint16_t field_id,
+                       const char *value, uint32_t len)
+{
+    BondPatchField field;
+    uint32_t position = 0;
+    if (!locate(buffer, index, field_id, &field, &position) ||
+        field.type != BOND_TYPE_STRING)
+    {
+        return false;
+    }
+
+    uint8_t prefix[5];
+    size_t prefix_len = bond_encode_varint32(prefix, len);
+    return splice(buffer, index, position, &field, prefix, prefix_len,
+                  (const uint8_t *)value, len);
+}
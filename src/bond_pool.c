@@ -0,0 +1,342 @@
+/**
+ * @file bond_pool.c
+ * @brief Thread-local pooling of bond_buffer memory
+ *
+ * Each thread keeps one intrusive freelist per power-of-two capacity class.
+ * A cached block stores its freelist link and real capacity in its own first
+ * bytes, so the pool needs no memory beyond the blocks it holds. A block is
+ * filed under the largest class not above its capacity, which lets acquire
+ * pop the head of a single list without searching.
+ *
+ * Buffers released on other threads are pushed onto the owner's inbox, a
+ * lock-free stack (compare-and-swap push). Only the owner takes from it,
+ * and it takes the whole stack with one exchange, so pops never race and
+ * the stack has no ABA problem. The owner refiles the blocks when a class
+ * runs empty.
+ *
+ * MSVC only offers C11 atomics behind /experimental:c11atomics, so there the
+ * inbox uses the Interlocked intrinsics instead of <stdatomic.h>.
+ */
+
+#include "bond_pool.h"
+#include "bond_stats.h"
+#include <stdlib.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BOND_POOL_MSVC_ATOMICS 1
+#define BOND_POOL_THREAD_LOCAL __declspec(thread)
+#else
+#include <stdatomic.h>
+#define BOND_POOL_THREAD_LOCAL _Thread_local
+#endif
+
+#define MIN_CLASS_SHIFT 8                                       // 256 B
+#define MAX_CLASS_SHIFT 22                                      // 4 MiB
+#define CLASS_COUNT (MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1)
+
+// Shrink the learned size by 1/2^SITE_DECAY_SHIFT per smaller release
+#define SITE_DECAY_SHIFT 3
+
+typedef struct pool_block {
+    struct pool_block *next;
+    size_t capacity;
+} pool_block;
+
+struct bond_buffer_pool {
+    pool_block *heads[CLASS_COUNT];
+    size_t retained;
+#ifdef BOND_POOL_MSVC_ATOMICS
+    pool_block *volatile inbox;         // Pushed by other threads
+#else
+    _Atomic(pool_block *) inbox;        // Pushed by other threads
+#endif
+};
+
+static BOND_POOL_THREAD_LOCAL bond_buffer_pool pool;
+
+static size_t pool_limit = BOND_POOL_DEFAULT_LIMIT;
+
+// ============================================================================
+// Inbox Atomics
+// ============================================================================
+
+#ifdef BOND_POOL_MSVC_ATOMICS
+
+// Aligned pointer reads are atomic on every MSVC target
+static pool_block *inbox_peek(bond_buffer_pool *owner)
+{
+    return owner->inbox;
+}
+
+// Push `block` if the head is still `*head`; otherwise reload `*head`
+static bool inbox_push(bond_buffer_pool *owner, pool_block **head, pool_block *block)
+{
+    pool_block *seen = (pool_block *)_InterlockedCompareExchangePointer(
+        (void *volatile *)&owner->inbox, block, *head);
+    if (seen == *head)
+    {
+        return true;
+    }
+    *head = seen;
+    return false;
+}
+
+static pool_block *inbox_take(bond_buffer_pool *owner)
+{
+    return (pool_block *)_InterlockedExchangePointer((void *volatile *)&owner->inbox, NULL);
+}
+
+#else
+
+static pool_block *inbox_peek(bond_buffer_pool *owner)
+{
+    return atomic_load_explicit(&owner->inbox, memory_order_relaxed);
+}
+
+// Push `block` if the head is still `*head`; otherwise reload `*head`
+static bool inbox_push(bond_buffer_pool *owner, pool_block **head, pool_block *block)
+{
+    return atomic_compare_exchange_weak_explicit(&owner->inbox, head, block,
+                                                 memory_order_release,
+                                                 memory_order_relaxed);
+}
+
+static pool_block *inbox_take(bond_buffer_pool *owner)
+{
+    return atomic_exchange_explicit(&owner->inbox, NULL, memory_order_acquire);
+}
+
+#endif
+
+// ============================================================================
+// Capacity Classes
+// ============================================================================
+
+// Smallest class holding `size` bytes; caller ensures size <= MAX_CAPACITY
+static int class_ceil(size_t size)
+{
+    int index = 0;
+    while (((size_t)1 << (index + MIN_CLASS_SHIFT)) < size)
+    {
+        index++;
+    }
+    return index;
+}
+
+// Largest class not above `capacity`; caller ensures capacity >= MIN_CAPACITY
+static int class_floor(size_t capacity)
+{
+    int index = 0;
+    while (index + 1 < CLASS_COUNT &&
+           ((size_t)1 << (index + 1 + MIN_CLASS_SHIFT)) <= capacity)
+    {
+        index++;
+    }
+    return index;
+}
+
+static size_t class_size(int index)
+{
+    return (size_t)1 << (index + MIN_CLASS_SHIFT);
+}
+
+// ============================================================================
+// Acquire / Release
+// ============================================================================
+
+int bond_buffer_acquire(bond_buffer *buf, size_t size_hint)
+{
+    if (size_hint > BOND_POOL_MAX_CAPACITY)
+    {
+        BOND_STATS_ADD(pool_misses, 1);
+        return bond_buffer_init(buf, size_hint);
+    }
+
+    int index = class_ceil(size_hint);
+    pool_block *block = pool.heads[index];
+    if (block == NULL && inbox_peek(&pool) != NULL)
+    {
+        bond_buffer_pool_collect();
+        block = pool.heads[index];
+    }
+    if (block == NULL)
+    {
+        BOND_STATS_ADD(pool_misses, 1);
+        return bond_buffer_init(buf, class_size(index));
+    }
+
+    pool.heads[index] = block->next;
+    pool.retained -= block->capacity;
+    BOND_STATS_ADD(pool_hits, 1);
+
+    buf->data = (uint8_t *)block;
+    buf->size = 0;
+    buf->capacity = block->capacity;
+    buf->read_pos = 0;
+    buf->owns_memory = true;
+    return 0;
+}
+
+static bool poolable(const bond_buffer *buf)
+{
+    return buf->owns_memory && buf->data != NULL &&
+           buf->capacity >= BOND_POOL_MIN_CAPACITY &&
+           buf->capacity <= BOND_POOL_MAX_CAPACITY;
+}
+
+// Take the memory out of `buf` as a block, leaving `buf` reset
+static pool_block *detach_block(bond_buffer *buf)
+{
+    pool_block *block = (pool_block *)buf->data;
+    block->capacity = buf->capacity;
+    buf->data = NULL;
+    buf->size = 0;
+    buf->capacity = 0;
+    buf->read_pos = 0;
+    buf->owns_memory = false;
+    return block;
+}
+
+// File a block in the calling thread's pool, or free it over the limit
+static void file_block(pool_block *block)
+{
+    if (pool.retained + block->capacity > pool_limit)
+    {
+        free(block);
+        return;
+    }
+    int index = class_floor(block->capacity);
+    block->next = pool.heads[index];
+    pool.heads[index] = block;
+    pool.retained += block->capacity;
+}
+
+void bond_buffer_release(bond_buffer *buf)
+{
+    if (!poolable(buf) || pool.retained + buf->capacity > pool_limit)
+    {
+        bond_buffer_destroy(buf);
+        return;
+    }
+    file_block(detach_block(buf));
+}
+
+void bond_buffer_release_to(bond_buffer *buf, bond_buffer_pool *owner)
+{
+    if (owner == NULL || owner == &pool)
+    {
+        bond_buffer_release(buf);
+        return;
+    }
+    if (!poolable(buf))
+    {
+        bond_buffer_destroy(buf);
+        return;
+    }
+
+    pool_block *block = detach_block(buf);
+    pool_block *head = inbox_peek(owner);
+    do
+    {
+        block->next = head;
+    } while (!inbox_push(owner, &head, block));
+    BOND_STATS_ADD(pool_remote_releases, 1);
+}
+
+// ============================================================================
+// Call-Site Learning
+// ============================================================================
+
+// Sites are shared between threads and `typical` is a plain size_t in the
+// public struct. It is only a hint, so a relaxed access that cannot tear is
+// enough: the GCC/Clang builtins work on ordinary objects, and elsewhere an
+// aligned volatile word access is used.
+static size_t site_load(bond_buffer_site *site)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(&site->typical, __ATOMIC_RELAXED);
+#else
+    return *(volatile size_t *)&site->typical;
+#endif
+}
+
+static void site_store(bond_buffer_site *site, size_t typical)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(&site->typical, typical, __ATOMIC_RELAXED);
+#else
+    *(volatile size_t *)&site->typical = typical;
+#endif
+}
+
+int bond_buffer_acquire_at(bond_buffer *buf, bond_buffer_site *site)
+{
+    return bond_buffer_acquire(buf, site_load(site));
+}
+
+void bond_buffer_release_at(bond_buffer *buf, bond_buffer_site *site)
+{
+    size_t used = buf->size;
+    size_t typical = site_load(site);
+    if (used > typical)
+    {
+        site_store(site, used);
+    }
+    else if (used < typical)
+    {
+        size_t decayed = typical - (typical >> SITE_DECAY_SHIFT);
+        site_store(site, decayed > used ? decayed : used);
+    }
+    bond_buffer_release(buf);
+}
+
+// ============================================================================
+// Pool Control
+// ============================================================================
+
+bond_buffer_pool *bond_buffer_pool_current(void)
+{
+    return &pool;
+}
+
+size_t bond_buffer_pool_collect(void)
+{
+    pool_block *block = inbox_take(&pool);
+    size_t count = 0;
+    while (block != NULL)
+    {
+        pool_block *next = block->next;
+        file_block(block);
+        block = next;
+        count++;
+    }
+    return count;
+}
+
+void bond_buffer_pool_set_limit(size_t bytes)
+{
+    pool_limit = bytes;
+}
+
+size_t bond_buffer_pool_retained(void)
+{
+    return pool.retained;
+}
+
+void bond_buffer_pool_trim(void)
+{
+    bond_buffer_pool_collect();
+    for (int index = 0; index < CLASS_COUNT; index++)
+    {
+        pool_block *block = pool.heads[index];
+        while (block != NULL)
+        {
+            pool_block *next = block->next;
+            free(block);
+            block = next;
+        }
+        pool.heads[index] = NULL;
+    }
+    pool.retained = 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file bond_probes.h
+ * @brief Optional USDT probes (library internal)
+ *
+ * Build with -DBOND_LITE_USDT=ON (needs <sys/sdt.h>) to place static
+ * tracepoints under the `bond_lite` provider:
+ *
+ *   writer_struct_begin(pos)            writer_struct_end(pos)
+ *   reader_struct_begin(pos)            reader_struct_end(pos)
+ *   writer_container_begin(type, element_type, count, pos)
+ *   reader_container_begin(type, element_type, count, pos)
+ *   buffer_grow(buffer, size, old_capacity, new_capacity)
+ *   skip_entry(type, pos)               skip_exit(type, pos, bytes, ok)
+ *
+ * `pos` is the buffer size (writer) or read position (reader) at the probe;
+ * a map's element_type is its key type. An unattached probe is a single
+ * nop; without the option the macros generate no code at all.
+ */
+
+#ifndef BOND_PROBES_H
+#define BOND_PROBES_H
+
+#ifdef BOND_LITE_USDT
+
+#include <sys/sdt.h>
+
+#define BOND_PROBE1(name, a) DTRACE_PROBE1(bond_lite, name, a)
+#define BOND_PROBE2(name, a, b) DTRACE_PROBE2(bond_lite, name, a, b)
+#define BOND_PROBE4(name, a, b, c, d) DTRACE_PROBE4(bond_lite, name, a, b, c, d)
+
+#else
+
+// sizeof keeps the arguments "used" without evaluating them
+#define BOND_PROBE1(name, a) ((void)sizeof(a))
+#define BOND_PROBE2(name, a, b) ((void)sizeof(a), (void)sizeof(b))
+#define BOND_PROBE4(name, a, b, c, d) \
+    ((void)sizeof(a), (void)sizeof(b), (void)sizeof(c), (void)sizeof(d))
+
+#endif // BOND_LITE_USDT
+
+#endif // BOND_PROBES_H
@@ -5,6 +5,9 @@
 
 #include "bond_reader.h"
 #include "bond_encoding.h"
+#include "bond_probes.h"
+#include "bond_stats.h"
+#include "bond_unicode.h"
 #include <string.h>
 
 // ============================================================================
@@ -14,6 +17,12 @@
 void bond_reader_init(BondReader *reader, bond_buffer *buffer)
 {
     reader->buffer = buffer;
+    reader->flags = 0;
+}
+
+void bond_reader_set_flags(BondReader *reader, uint32_t flags)
+{
+    reader->flags = flags;
 }
 
 // ============================================================================
@@ -22,12 +31,14 @@ void bond_reader_init(BondReader *reader, bond_buffer *buffer)
 
 void bond_reader_struct_begin(BondReader *reader)
 {
-    (void)reader;
+    BOND_STATS_ENTER();
+    BOND_PROBE1(reader_struct_begin, reader->buffer->read_pos);
 }
 
 void bond_reader_struct_end(BondReader *reader)
 {
-    (void)reader;
+    BOND_STATS_LEAVE();
+    BOND_PROBE1(reader_struct_end, reader->buffer->read_pos);
 }
 
 // ============================================================================
@@ -97,6 +108,45 @@ static size_t read_varint_bytes(BondReader *reader, uint8_t *buf, size_t max_byt
     return len;
 }
 
+static bool read_varint16(BondReader *reader, uint16_t *value, bond_stats_varint_kind kind)
+{
+    uint8_t buf[3];
+    size_t len = read_varint_bytes(reader, buf, 3);
+    if (len == 0)
+    {
+        return false;
+    }
+    BOND_STATS_VARINT(varint_read, kind, len);
+    size_t consumed = bond_decode_varint16(buf, value);
+    return (consumed != 0 && consumed == len);
+}
+
+static bool read_varint32(BondReader *reader, uint32_t *value, bond_stats_varint_kind kind)
+{
+    uint8_t buf[5];
+    size_t len = read_varint_bytes(reader, buf, 5);
+    if (len == 0)
+    {
+        return false;
+    }
+    BOND_STATS_VARINT(varint_read, kind, len);
+    size_t consumed = bond_decode_varint32(buf, value);
+    return (consumed != 0 && consumed == len);
+}
+
+static bool read_varint64(BondReader *reader, uint64_t *value, bond_stats_varint_kind kind)
+{
+    uint8_t buf[10];
+    size_t len = read_varint_bytes(reader, buf, 10);
+    if (len == 0)
+    {
+        return false;
+    }
+    BOND_STATS_VARINT(varint_read, kind, len);
+    size_t consumed = bond_decode_varint64(buf, value);
+    return (consumed != 0 && consumed == len);
+}
+
 // ============================================================================
 // Primitive Value Readers
 // ============================================================================
@@ -133,44 +183,23 @@ bool bond_reader_read_int8_value(BondReader *reader, int8_t *value)
 
 bool bond_reader_read_uint16_value(BondReader *reader, uint16_t *value)
 {
-    uint8_t buf[3];
-    size_t len = read_varint_bytes(reader, buf, 3);
-    if (len == 0)
-    {
-        return false;
-    }
-    size_t consumed = bond_decode_varint16(buf, value);
-    return (consumed != 0 && consumed == len);
+    return read_varint16(reader, value, BOND_STATS_VARINT_UINT16);
 }
 
 bool bond_reader_read_uint32_value(BondReader *reader, uint32_t *value)
 {
-    uint8_t buf[5];
-    size_t len = read_varint_bytes(reader, buf, 5);
-    if (len == 0)
-    {
-        return false;
-    }
-    size_t consumed = bond_decode_varint32(buf, value);
-    return (consumed != 0 && consumed == len);
+    return read_varint32(reader, value, BOND_STATS_VARINT_UINT32);
 }
 
 bool bond_reader_read_uint64_value(BondReader *reader, uint64_t *value)
 {
-    uint8_t buf[10];
-    size_t len = read_varint_bytes(reader, buf, 10);
-    if (len == 0)
-    {
-        return false;
-    }
-    size_t consumed = bond_decode_varint64(buf, value);
-    return (consumed != 0 && consumed == len);
+    return read_varint64(reader, value, BOND_STATS_VARINT_UINT64);
 }
 
 bool bond_reader_read_int16_value(BondReader *reader, int16_t *value)
 {
     uint16_t uvalue;
-    if (!bond_reader_read_uint16_value(reader, &uvalue))
+    if (!read_varint16(reader, &uvalue, BOND_STATS_VARINT_INT16))
     {
         return false;
     }
@@ -181,7 +210,7 @@ bool bond_reader_read_int16_value(BondReader *reader, int16_t *value)
 bool bond_reader_read_int32_value(BondReader *reader, int32_t *value)
 {
     uint32_t uvalue;
-    if (!bond_reader_read_uint32_value(reader, &uvalue))
+    if (!read_varint32(reader, &uvalue, BOND_STATS_VARINT_INT32))
     {
         return false;
     }
@@ -192,7 +221,7 @@ bool bond_reader_read_int32_value(BondReader *reader, int32_t *value)
 bool bond_reader_read_int64_value(BondReader *reader, int64_t *value)
 {
     uint64_t uvalue;
-    if (!bond_reader_read_uint64_value(reader, &uvalue))
+    if (!read_varint64(reader, &uvalue, BOND_STATS_VARINT_INT64))
     {
         return false;
     }
@@ -227,7 +256,7 @@ bool bond_reader_read_double_value(BondReader *reader, double *value)
 bool bond_reader_read_string_value(BondReader *reader, const char **str, uint32_t *len)
 {
     uint32_t str_len;
-    if (!bond_reader_read_uint32_value(reader, &str_len))
+    if (!read_varint32(reader, &str_len, BOND_STATS_VARINT_LENGTH))
     {
         return false;
     }
@@ -235,12 +264,36 @@ bool bond_reader_read_string_value(BondReader *reader, const char **str, uint32_
     {
         return false;
     }
-    *str = (const char *)(reader->buffer->data + reader->buffer->read_pos);
+    const uint8_t *bytes = reader->buffer->data + reader->buffer->read_pos;
+    if ((reader->flags & BOND_READER_VALIDATE_UTF8) && !bond_utf8_validate(bytes, str_len))
+    {
+        return false;
+    }
+    *str = (const char *)bytes;
     reader->buffer->read_pos += str_len;
+    BOND_STATS_ADD(bytes_read, str_len);
     *len = str_len;
     return true;
 }
 
+bool bond_reader_read_wstring_value(BondReader *reader, const uint8_t **units, uint32_t *length)
+{
+    uint32_t unit_count;
+    if (!read_varint32(reader, &unit_count, BOND_STATS_VARINT_LENGTH))
+    {
+        return false;
+    }
+    if (bond_buffer_remaining(reader->buffer) / 2 < unit_count)
+    {
+        return false;
+    }
+    *units = reader->buffer->data + reader->buffer->read_pos;
+    reader->buffer->read_pos += (size_t)unit_count * 2;
+    BOND_STATS_ADD(bytes_read, (size_t)unit_count * 2);
+    *length = unit_count;
+    return true;
+}
+
 // ============================================================================
 // Container Header Readers
 // ============================================================================
@@ -253,13 +306,76 @@ bool bond_reader_read_list_begin(BondReader *reader, uint8_t *element_type, uint
         return false;
     }
     *element_type = (uint8_t)byte;
-    if (!bond_reader_read_uint32_value(reader, count))
+    if (!read_varint32(reader, count, BOND_STATS_VARINT_LENGTH))
     {
         return false;
     }
+    BOND_PROBE4(reader_container_begin, BOND_TYPE_LIST, *element_type, *count,
+                reader->buffer->read_pos);
     return true;
 }
 
+bool bond_reader_read_blob(BondReader *reader, const uint8_t **data, uint32_t *len)
+{
+    uint8_t element_type;
+    uint32_t count;
+    if (!bond_reader_read_list_begin(reader, &element_type, &count))
+    {
+        return false;
+    }
+    if (element_type != BOND_TYPE_INT8 && element_type != BOND_TYPE_UINT8)
+    {
+        return false;
+    }
+    if (bond_buffer_remaining(reader->buffer) < count)
+    {
+        return false;
+    }
+    *data = reader->buffer->data + reader->buffer->read_pos;
+    reader->buffer->read_pos += count;
+    BOND_STATS_ADD(bytes_read, count);
+    *len = count;
+    return true;
+}
+
+// Shared body of the bulk fixed-width list readers
+static bool read_list_bulk(BondReader *reader, uint8_t expected_type, size_t width,
+                           void *values, uint32_t max_count, uint32_t *count,
+                           void (*copy)(void *dst, const void *src, size_t count))
+{
+    size_t start = reader->buffer->read_pos;
+    uint8_t element_type;
+    uint32_t n;
+    if (!bond_reader_read_list_begin(reader, &element_type, &n) ||
+        element_type != expected_type)
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    *count = n;
+    if (n > max_count || bond_buffer_remaining(reader->buffer) / width < n)
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    copy(values, reader->buffer->data + reader->buffer->read_pos, n);
+    reader->buffer->read_pos += (size_t)n * width;
+    BOND_STATS_ADD(bytes_read, (size_t)n * width);
+    return true;
+}
+
+bool bond_reader_read_float_list(BondReader *reader, float *values,
+                                 uint32_t max_count, uint32_t *count)
+{
+    return read_list_bulk(reader, BOND_TYPE_FLOAT, 4, values, max_count, count, bond_copy_le32);
+}
+
+bool bond_reader_read_double_list(BondReader *reader, double *values,
+                                  uint32_t max_count, uint32_t *count)
+{
+    return read_list_bulk(reader, BOND_TYPE_DOUBLE, 8, values, max_count, count, bond_copy_le64);
+}
+
 bool bond_reader_read_set_begin(BondReader *reader, uint8_t *element_type, uint32_t *count)
 {
     // Same wire format as list
@@ -282,10 +398,12 @@ bool bond_reader_read_map_begin(BondReader *reader, uint8_t *key_type, uint8_t *
     }
     *value_type = (uint8_t)byte;
 
-    if (!bond_reader_read_uint32_value(reader, count))
+    if (!read_varint32(reader, count, BOND_STATS_VARINT_LENGTH))
     {
         return false;
     }
+    BOND_PROBE4(reader_container_begin, BOND_TYPE_MAP, *key_type, *count,
+                reader->buffer->read_pos);
     return true;
 }
 
@@ -308,7 +426,7 @@ static bool skip_varint(BondReader *reader)
     return true;
 }
 
-bool bond_reader_skip(BondReader *reader, uint8_t type)
+static bool skip_value(BondReader *reader, uint8_t type)
 {
     switch (type)
     {
@@ -330,19 +448,18 @@ bool bond_reader_skip(BondReader *reader, uint8_t type)
         case BOND_TYPE_FLOAT:
             // Skip 4 bytes
             return bond_buffer_remaining(reader->buffer) >= 4 &&
-                   (reader->buffer->read_pos += 4, true);
+                   (reader->buffer->read_pos += 4, BOND_STATS_ADD(bytes_read, 4), true);
 
         case BOND_TYPE_DOUBLE:
             // Skip 8 bytes
             return bond_buffer_remaining(reader->buffer) >= 8 &&
-                   (reader->buffer->read_pos += 8, true);
+                   (reader->buffer->read_pos += 8, BOND_STATS_ADD(bytes_read, 8), true);
 
         case BOND_TYPE_STRING:
-        case BOND_TYPE_WSTRING:
         {
             // Read length, skip that many bytes
             uint32_t len;
-            if (!bond_reader_read_uint32_value(reader, &len))
+            if (!read_varint32(reader, &len, BOND_STATS_VARINT_LENGTH))
             {
                 return false;
             }
@@ -351,29 +468,46 @@ bool bond_reader_skip(BondReader *reader, uint8_t type)
                 return false;
             }
             reader->buffer->read_pos += len;
+            BOND_STATS_ADD(bytes_read, len);
             return true;
         }
 
+        case BOND_TYPE_WSTRING:
+        {
+            // Length counts UTF-16 code units (2 bytes each)
+            const uint8_t *units;
+            uint32_t length;
+            return bond_reader_read_wstring_value(reader, &units, &length);
+        }
+
         case BOND_TYPE_STRUCT:
         {
-            // Read fields until STOP, skip each
+            // Read fields until STOP, skip each; STOP_BASE only ends a
+            // base section
             uint16_t field_id;
             uint8_t field_type;
+            bool ok;
+            BOND_STATS_ENTER();
             while (true)
             {
                 if (!bond_reader_read_field_header(reader, &field_id, &field_type))
                 {
-                    return false;
+                    ok = false;
+                    break;
                 }
-                if (field_type == BOND_TYPE_STOP || field_type == BOND_TYPE_STOP_BASE)
+                if (field_type == BOND_TYPE_STOP)
                 {
-                    return true;
+                    ok = true;
+                    break;
                 }
-                if (!bond_reader_skip(reader, field_type))
+                if (field_type != BOND_TYPE_STOP_BASE && !skip_value(reader, field_type))
                 {
-                    return false;
+                    ok = false;
+                    break;
                 }
             }
+            BOND_STATS_LEAVE();
+            return ok;
         }
 
         case BOND_TYPE_LIST:
@@ -388,7 +522,7 @@ bool bond_reader_skip(BondReader *reader, uint8_t type)
             }
             for (uint32_t i = 0; i < count; i++)
             {
-                if (!bond_reader_skip(reader, element_type))
+                if (!skip_value(reader, element_type))
                 {
                     return false;
                 }
@@ -407,11 +541,11 @@ bool bond_reader_skip(BondReader *reader, uint8_t type)
             }
             for (uint32_t i = 0; i < count; i++)
             {
-                if (!bond_reader_skip(reader, key_type))
+                if (!skip_value(reader, key_type))
                 {
                     return false;
                 }
-                if (!bond_reader_skip(reader, value_type))
+                if (!skip_value(reader, value_type))
                 {
                     return false;
                 }
@@ -424,3 +558,115 @@ bool bond_reader_skip(BondReader *reader, uint8_t type)
             return false;
     }
 }
+
+bool bond_reader_skip(BondReader *reader, uint8_t type)
+{
+    size_t start = reader->buffer->read_pos;
+    BOND_PROBE2(skip_entry, type, start);
+    bool ok = skip_value(reader, type);
+    BOND_STATS_ADD(bytes_skipped, reader->buffer->read_pos - start);
+    BOND_PROBE4(skip_exit, type, start, reader->buffer->read_pos - start, ok);
+    return ok;
+}
+
+// ============================================================================
+// List Element Offsets
+// ============================================================================
+
+static size_t fixed_width(uint8_t type)
+{
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_INT8:
+        case BOND_TYPE_UINT8:
+            return 1;
+        case BOND_TYPE_FLOAT:
+            return 4;
+        case BOND_TYPE_DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// Walk string lengths straight off the bytes; no per-byte buffer calls
+static bool scan_strings(const uint8_t *data, size_t pos, size_t size,
+                         uint32_t count, size_t *offsets)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        offsets[i] = pos;
+        uint32_t len = 0;
+        int shift = 0;
+        uint8_t byte;
+        do
+        {
+            if (pos == size || shift > 28)
+            {
+                return false;
+            }
+            byte = data[pos++];
+            if (shift == 28 && byte > 0x0F)
+            {
+                return false;       // 5th byte carries more than 32 bits
+            }
+            len |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while ((byte & 0x80) != 0);
+        if (size - pos < len)
+        {
+            return false;
+        }
+        pos += len;
+    }
+    offsets[count] = pos;
+    return true;
+}
+
+bool bond_reader_list_offsets(BondReader *reader, uint8_t element_type,
+                              uint32_t count, size_t *offsets)
+{
+    bond_buffer *buffer = reader->buffer;
+    size_t start = buffer->read_pos;
+    size_t width = fixed_width(element_type);
+    bool ok = true;
+
+    if (width != 0)
+    {
+        if (bond_buffer_remaining(buffer) / width < count)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i <= count; i++)
+        {
+            offsets[i] = start + (size_t)i * width;
+        }
+    }
+    else if (element_type == BOND_TYPE_STRING)
+    {
+        ok = scan_strings(buffer->data, start, buffer->size, count, offsets);
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count && ok; i++)
+        {
+            offsets[i] = buffer->read_pos;
+            ok = skip_value(reader, element_type);
+        }
+        offsets[count] = buffer->read_pos;
+    }
+
+    if (!ok)
+    {
+        buffer->read_pos = start;
+        return false;
+    }
+    if (buffer->read_pos != offsets[count])
+    {
+        // Fast paths bypass the buffer reads that count bytes
+        BOND_STATS_ADD(bytes_read, offsets[count] - start);
+        buffer->read_pos = offsets[count];
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file bond_schema.c
+ * @brief Runtime schema descriptor helpers
+ */
+
+#include "bond_schema.h"
+#include <string.h>
+
+const BondSchemaField *bond_schema_find_field(const BondSchemaStruct *def, uint16_t id)
+{
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        if (def->fields[i].id == id)
+        {
+            return &def->fields[i];
+        }
+    }
+    return NULL;
+}
+
+const BondSchemaField *bond_schema_find_field_by_name(const BondSchemaStruct *def,
+                                                      const char *name, size_t len)
+{
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        const char *field_name = def->fields[i].name;
+        if (field_name != NULL && strlen(field_name) == len && memcmp(field_name, name, len) == 0)
+        {
+            return &def->fields[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,832 @@
+/**
+ * @file bond_simple.c
+ * @brief SimpleBinary writer, reader and schema-driven transcoding
+ */
+
+#include "bond_simple.h"
+#include "bond_fast.h"
+#include <stdlib.h>
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+//
+// Scalars are encoded exactly as in FastBinary, so they go through a
+// FastBinary writer/reader over the same buffer.
+
+static bond_fast_writer fast_writer(bond_simple_writer *writer)
+{
+    bond_fast_writer fast = { writer->buffer };
+    return fast;
+}
+
+static BondFastReader fast_reader(BondSimpleReader *reader)
+{
+    BondFastReader fast = { reader->buffer };
+    return fast;
+}
+
+// Lengths and counts: uint32 in v1, varint32 in v2
+static void write_length(bond_simple_writer *writer, uint32_t value)
+{
+    if (writer->version == BOND_SIMPLE_VERSION_1)
+    {
+        bond_simple_writer_write_uint32_value(writer, value);
+    }
+    else
+    {
+        bond_writer compact = { writer->buffer };
+        bond_writer_write_uint32_value(&compact, value);
+    }
+}
+
+static bool read_length(BondSimpleReader *reader, uint32_t *value)
+{
+    if (reader->version == BOND_SIMPLE_VERSION_1)
+    {
+        return bond_simple_reader_read_uint32_value(reader, value);
+    }
+    BondReader compact = { reader->buffer, 0 };
+    return bond_reader_read_uint32_value(&compact, value);
+}
+
+// Consume `len` bytes, returning a pointer to them (NULL if truncated)
+static const uint8_t *take(BondSimpleReader *reader, size_t len)
+{
+    if (bond_buffer_remaining(reader->buffer) < len)
+    {
+        return NULL;
+    }
+    const uint8_t *p = reader->buffer->data + reader->buffer->read_pos;
+    reader->buffer->read_pos += len;
+    return p;
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+void bond_simple_writer_init(bond_simple_writer *writer, bond_buffer *buffer, uint16_t version)
+{
+    writer->buffer = buffer;
+    writer->version = version;
+}
+
+void bond_simple_writer_write_bool_value(bond_simple_writer *writer, bool value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_bool_value(&fast, value);
+}
+
+void bond_simple_writer_write_uint8_value(bond_simple_writer *writer, uint8_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_uint8_value(&fast, value);
+}
+
+void bond_simple_writer_write_uint16_value(bond_simple_writer *writer, uint16_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_uint16_value(&fast, value);
+}
+
+void bond_simple_writer_write_uint32_value(bond_simple_writer *writer, uint32_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_uint32_value(&fast, value);
+}
+
+void bond_simple_writer_write_uint64_value(bond_simple_writer *writer, uint64_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_uint64_value(&fast, value);
+}
+
+void bond_simple_writer_write_int8_value(bond_simple_writer *writer, int8_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_int8_value(&fast, value);
+}
+
+void bond_simple_writer_write_int16_value(bond_simple_writer *writer, int16_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_int16_value(&fast, value);
+}
+
+void bond_simple_writer_write_int32_value(bond_simple_writer *writer, int32_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_int32_value(&fast, value);
+}
+
+void bond_simple_writer_write_int64_value(bond_simple_writer *writer, int64_t value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_int64_value(&fast, value);
+}
+
+void bond_simple_writer_write_float_value(bond_simple_writer *writer, float value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_float_value(&fast, value);
+}
+
+void bond_simple_writer_write_double_value(bond_simple_writer *writer, double value)
+{
+    bond_fast_writer fast = fast_writer(writer);
+    bond_fast_writer_write_double_value(&fast, value);
+}
+
+void bond_simple_writer_write_string_value(bond_simple_writer *writer, const char *value,
+                                           uint32_t len)
+{
+    write_length(writer, len);
+    bond_buffer_write(writer->buffer, value, len);
+}
+
+void bond_simple_writer_write_wstring_value(bond_simple_writer *writer, const uint16_t *value,
+                                            uint32_t length)
+{
+    write_length(writer, length);
+    if (bond_buffer_reserve(writer->buffer, (size_t)length * 2) != 0)
+    {
+        return;
+    }
+    uint8_t *out = writer->buffer->data + writer->buffer->size;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        out[2 * i] = (uint8_t)value[i];
+        out[2 * i + 1] = (uint8_t)(value[i] >> 8);
+    }
+    writer->buffer->size += (size_t)length * 2;
+}
+
+void bond_simple_writer_write_container_begin(bond_simple_writer *writer, uint32_t count)
+{
+    write_length(writer, count);
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+void bond_simple_reader_init(BondSimpleReader *reader, bond_buffer *buffer, uint16_t version)
+{
+    reader->buffer = buffer;
+    reader->version = version;
+}
+
+bool bond_simple_reader_read_bool_value(BondSimpleReader *reader, bool *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_bool_value(&fast, value);
+}
+
+bool bond_simple_reader_read_uint8_value(BondSimpleReader *reader, uint8_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_uint8_value(&fast, value);
+}
+
+bool bond_simple_reader_read_uint16_value(BondSimpleReader *reader, uint16_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_uint16_value(&fast, value);
+}
+
+bool bond_simple_reader_read_uint32_value(BondSimpleReader *reader, uint32_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_uint32_value(&fast, value);
+}
+
+bool bond_simple_reader_read_uint64_value(BondSimpleReader *reader, uint64_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_uint64_value(&fast, value);
+}
+
+bool bond_simple_reader_read_int8_value(BondSimpleReader *reader, int8_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_int8_value(&fast, value);
+}
+
+bool bond_simple_reader_read_int16_value(BondSimpleReader *reader, int16_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_int16_value(&fast, value);
+}
+
+bool bond_simple_reader_read_int32_value(BondSimpleReader *reader, int32_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_int32_value(&fast, value);
+}
+
+bool bond_simple_reader_read_int64_value(BondSimpleReader *reader, int64_t *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_int64_value(&fast, value);
+}
+
+bool bond_simple_reader_read_float_value(BondSimpleReader *reader, float *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_float_value(&fast, value);
+}
+
+bool bond_simple_reader_read_double_value(BondSimpleReader *reader, double *value)
+{
+    BondFastReader fast = fast_reader(reader);
+    return bond_fast_reader_read_double_value(&fast, value);
+}
+
+bool bond_simple_reader_read_string_value(BondSimpleReader *reader, const char **str, uint32_t *len)
+{
+    size_t start = reader->buffer->read_pos;
+    uint32_t n;
+    const uint8_t *p;
+    if (!read_length(reader, &n) || (p = take(reader, n)) == NULL)
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    *str = (const char *)p;
+    *len = n;
+    return true;
+}
+
+bool bond_simple_reader_read_wstring_value(BondSimpleReader *reader, const uint8_t **units,
+                                           uint32_t *length)
+{
+    size_t start = reader->buffer->read_pos;
+    uint32_t n;
+    const uint8_t *p;
+    if (!read_length(reader, &n) || (p = take(reader, (size_t)n * 2)) == NULL)
+    {
+        reader->buffer->read_pos = start;
+        return false;
+    }
+    *units = p;
+    *length = n;
+    return true;
+}
+
+bool bond_simple_reader_read_container_begin(BondSimpleReader *reader, uint32_t *count)
+{
+    return read_length(reader, count);
+}
+
+static bool skip_struct(BondSimpleReader *reader, const BondSchemaStruct *def)
+{
+    if (def->base != NULL && !skip_struct(reader, def->base))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        if (!bond_simple_reader_skip(reader, &def->fields[i].type))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bond_simple_reader_skip(BondSimpleReader *reader, const BondSchemaType *type)
+{
+    switch (type->id)
+    {
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            return bond_simple_reader_read_string_value(reader, &str, &len);
+        }
+
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t length;
+            return bond_simple_reader_read_wstring_value(reader, &units, &length);
+        }
+
+        case BOND_TYPE_STRUCT:
+            return skip_struct(reader, type->struct_def);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        case BOND_TYPE_MAP:
+        {
+            uint32_t count;
+            if (!read_length(reader, &count))
+            {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if ((type->id == BOND_TYPE_MAP && !bond_simple_reader_skip(reader, type->key)) ||
+                    !bond_simple_reader_skip(reader, type->element))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        default:
+        {
+            // Scalars: same fixed widths as FastBinary
+            BondFastReader fast = fast_reader(reader);
+            return bond_fast_reader_skip(&fast, type->id);
+        }
+    }
+}
+
+// ============================================================================
+// SimpleBinary -> CompactBinary
+// ============================================================================
+
+static bool simple_to_compact_value(BondSimpleReader *reader, const BondSchemaType *type,
+                                    bond_writer *writer);
+
+static bool simple_to_compact_fields(BondSimpleReader *reader, const BondSchemaStruct *def,
+                                     bond_writer *writer)
+{
+    if (def->base != NULL)
+    {
+        if (!simple_to_compact_fields(reader, def->base, writer))
+        {
+            return false;
+        }
+        bond_buffer_write_byte(writer->buffer, BOND_TYPE_STOP_BASE);
+    }
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        const BondSchemaField *field = &def->fields[i];
+        bond_writer_write_field_header(writer, field->id, (BondDataType)field->type.id);
+        if (!simple_to_compact_value(reader, &field->type, writer))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool simple_to_compact_value(BondSimpleReader *reader, const BondSchemaType *type,
+                                    bond_writer *writer)
+{
+    switch (type->id)
+    {
+        case BOND_TYPE_BOOL:
+        {
+            bool value;
+            if (!bond_simple_reader_read_bool_value(reader, &value)) return false;
+            bond_writer_write_bool_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT8:
+        {
+            uint8_t value;
+            if (!bond_simple_reader_read_uint8_value(reader, &value)) return false;
+            bond_writer_write_uint8_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT16:
+        {
+            uint16_t value;
+            if (!bond_simple_reader_read_uint16_value(reader, &value)) return false;
+            bond_writer_write_uint16_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT32:
+        {
+            uint32_t value;
+            if (!bond_simple_reader_read_uint32_value(reader, &value)) return false;
+            bond_writer_write_uint32_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT64:
+        {
+            uint64_t value;
+            if (!bond_simple_reader_read_uint64_value(reader, &value)) return false;
+            bond_writer_write_uint64_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT8:
+        {
+            int8_t value;
+            if (!bond_simple_reader_read_int8_value(reader, &value)) return false;
+            bond_writer_write_int8_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT16:
+        {
+            int16_t value;
+            if (!bond_simple_reader_read_int16_value(reader, &value)) return false;
+            bond_writer_write_int16_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT32:
+        {
+            int32_t value;
+            if (!bond_simple_reader_read_int32_value(reader, &value)) return false;
+            bond_writer_write_int32_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT64:
+        {
+            int64_t value;
+            if (!bond_simple_reader_read_int64_value(reader, &value)) return false;
+            bond_writer_write_int64_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_FLOAT:
+        {
+            float value;
+            if (!bond_simple_reader_read_float_value(reader, &value)) return false;
+            bond_writer_write_float_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_DOUBLE:
+        {
+            double value;
+            if (!bond_simple_reader_read_double_value(reader, &value)) return false;
+            bond_writer_write_double_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            if (!bond_simple_reader_read_string_value(reader, &str, &len)) return false;
+            bond_writer_write_uint32_value(writer, len);
+            bond_buffer_write(writer->buffer, str, len);
+            return true;
+        }
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t length;
+            if (!bond_simple_reader_read_wstring_value(reader, &units, &length)) return false;
+            bond_writer_write_uint32_value(writer, length);
+            bond_buffer_write(writer->buffer, units, (size_t)length * 2);
+            return true;
+        }
+        case BOND_TYPE_STRUCT:
+            if (!simple_to_compact_fields(reader, type->struct_def, writer))
+            {
+                return false;
+            }
+            bond_writer_struct_end(writer);
+            return true;
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        case BOND_TYPE_MAP:
+        {
+            uint32_t count;
+            if (!read_length(reader, &count))
+            {
+                return false;
+            }
+            if (type->id == BOND_TYPE_MAP)
+            {
+                bond_buffer_write_byte(writer->buffer, type->key->id);
+            }
+            bond_buffer_write_byte(writer->buffer, type->element->id);
+            bond_writer_write_uint32_value(writer, count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if ((type->id == BOND_TYPE_MAP &&
+                     !simple_to_compact_value(reader, type->key, writer)) ||
+                    !simple_to_compact_value(reader, type->element, writer))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool bond_simple_to_compact(BondSimpleReader *reader, const BondSchemaStruct *schema,
+                            bond_writer *writer)
+{
+    size_t read_start = reader->buffer->read_pos;
+    size_t write_start = writer->buffer->size;
+    BondSchemaType type = BOND_SCHEMA_STRUCT(schema);
+    if (!simple_to_compact_value(reader, &type, writer))
+    {
+        reader->buffer->read_pos = read_start;
+        writer->buffer->size = write_start;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// CompactBinary -> SimpleBinary
+// ============================================================================
+
+// Where a schema field was found in the CompactBinary input
+typedef struct {
+    size_t offset;          // Start of the value bytes
+    uint8_t type;           // Wire type
+    bool present;           // False if the field was not on the wire
+} field_slot;
+
+static bool compact_to_simple_value(BondReader *reader, const BondSchemaType *type,
+                                    bond_simple_writer *writer);
+
+static void write_default(const BondSchemaType *type, bond_simple_writer *writer);
+
+static void write_default_fields(const BondSchemaStruct *def, bond_simple_writer *writer)
+{
+    if (def->base != NULL)
+    {
+        write_default_fields(def->base, writer);
+    }
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        write_default(&def->fields[i].type, writer);
+    }
+}
+
+static void write_default(const BondSchemaType *type, bond_simple_writer *writer)
+{
+    static const uint8_t zeros[8] = {0};
+    switch (type->id)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            bond_buffer_write(writer->buffer, zeros, 1);
+            break;
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_INT16:
+            bond_buffer_write(writer->buffer, zeros, 2);
+            break;
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_FLOAT:
+            bond_buffer_write(writer->buffer, zeros, 4);
+            break;
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT64:
+        case BOND_TYPE_DOUBLE:
+            bond_buffer_write(writer->buffer, zeros, 8);
+            break;
+        case BOND_TYPE_STRUCT:
+            write_default_fields(type->struct_def, writer);
+            break;
+        default:
+            // Strings, wstrings and containers: empty
+            write_length(writer, 0);
+            break;
+    }
+}
+
+// Scan one section of a CompactBinary struct (the fields declared by one
+// level of the inheritance chain, up to STOP_BASE or STOP), recording where
+// each schema field starts.
+static bool scan_section(BondReader *reader, const BondSchemaStruct *def,
+                         uint8_t terminator, field_slot *slots)
+{
+    while (true)
+    {
+        uint16_t field_id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(reader, &field_id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP || type == BOND_TYPE_STOP_BASE)
+        {
+            return type == terminator;
+        }
+        const BondSchemaField *field = bond_schema_find_field(def, field_id);
+        if (field != NULL)
+        {
+            field_slot *slot = &slots[field - def->fields];
+            slot->offset = reader->buffer->read_pos;
+            slot->type = type;
+            slot->present = true;
+        }
+        if (!bond_reader_skip(reader, type))
+        {
+            return false;
+        }
+    }
+}
+
+// Convert the scanned fields in schema order, then leave the reader after
+// the section
+static bool convert_section(BondReader *reader, const BondSchemaStruct *def,
+                            const field_slot *slots, bond_simple_writer *writer)
+{
+    size_t end = reader->buffer->read_pos;
+    for (uint32_t i = 0; i < def->field_count; i++)
+    {
+        const BondSchemaField *field = &def->fields[i];
+        if (!slots[i].present)
+        {
+            write_default(&field->type, writer);
+            continue;
+        }
+        if (slots[i].type != field->type.id)
+        {
+            return false;
+        }
+        reader->buffer->read_pos = slots[i].offset;
+        if (!compact_to_simple_value(reader, &field->type, writer))
+        {
+            return false;
+        }
+    }
+    reader->buffer->read_pos = end;
+    return true;
+}
+
+static bool compact_to_simple_section(BondReader *reader, const BondSchemaStruct *def,
+                                      uint8_t terminator, bond_simple_writer *writer)
+{
+    field_slot *slots = NULL;
+    if (def->field_count > 0)
+    {
+        slots = (field_slot *)calloc(def->field_count, sizeof(field_slot));
+        if (slots == NULL)
+        {
+            return false;
+        }
+    }
+    bool ok = scan_section(reader, def, terminator, slots) &&
+              convert_section(reader, def, slots, writer);
+    free(slots);
+    return ok;
+}
+
+static bool compact_to_simple_fields(BondReader *reader, const BondSchemaStruct *def,
+                                     uint8_t terminator, bond_simple_writer *writer)
+{
+    if (def->base != NULL &&
+        !compact_to_simple_fields(reader, def->base, BOND_TYPE_STOP_BASE, writer))
+    {
+        return false;
+    }
+    return compact_to_simple_section(reader, def, terminator, writer);
+}
+
+static bool compact_to_simple_value(BondReader *reader, const BondSchemaType *type,
+                                    bond_simple_writer *writer)
+{
+    switch (type->id)
+    {
+        case BOND_TYPE_BOOL:
+        {
+            bool value;
+            if (!bond_reader_read_bool_value(reader, &value)) return false;
+            bond_simple_writer_write_bool_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT8:
+        {
+            uint8_t value;
+            if (!bond_reader_read_uint8_value(reader, &value)) return false;
+            bond_simple_writer_write_uint8_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT16:
+        {
+            uint16_t value;
+            if (!bond_reader_read_uint16_value(reader, &value)) return false;
+            bond_simple_writer_write_uint16_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT32:
+        {
+            uint32_t value;
+            if (!bond_reader_read_uint32_value(reader, &value)) return false;
+            bond_simple_writer_write_uint32_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_UINT64:
+        {
+            uint64_t value;
+            if (!bond_reader_read_uint64_value(reader, &value)) return false;
+            bond_simple_writer_write_uint64_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT8:
+        {
+            int8_t value;
+            if (!bond_reader_read_int8_value(reader, &value)) return false;
+            bond_simple_writer_write_int8_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT16:
+        {
+            int16_t value;
+            if (!bond_reader_read_int16_value(reader, &value)) return false;
+            bond_simple_writer_write_int16_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT32:
+        {
+            int32_t value;
+            if (!bond_reader_read_int32_value(reader, &value)) return false;
+            bond_simple_writer_write_int32_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_INT64:
+        {
+            int64_t value;
+            if (!bond_reader_read_int64_value(reader, &value)) return false;
+            bond_simple_writer_write_int64_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_FLOAT:
+        {
+            float value;
+            if (!bond_reader_read_float_value(reader, &value)) return false;
+            bond_simple_writer_write_float_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_DOUBLE:
+        {
+            double value;
+            if (!bond_reader_read_double_value(reader, &value)) return false;
+            bond_simple_writer_write_double_value(writer, value);
+            return true;
+        }
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            if (!bond_reader_read_string_value(reader, &str, &len)) return false;
+            bond_simple_writer_write_string_value(writer, str, len);
+            return true;
+        }
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t length;
+            if (!bond_reader_read_wstring_value(reader, &units, &length)) return false;
+            write_length(writer, length);
+            bond_buffer_write(writer->buffer, units, (size_t)length * 2);
+            return true;
+        }
+        case BOND_TYPE_STRUCT:
+            return compact_to_simple_fields(reader, type->struct_def, BOND_TYPE_STOP, writer);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        case BOND_TYPE_MAP:
+        {
+            uint8_t key_type = 0;
+            uint8_t element_type;
+            uint32_t count;
+            bool ok = (type->id == BOND_TYPE_MAP)
+                ? bond_reader_read_map_begin(reader, &key_type, &element_type, &count)
+                : bond_reader_read_list_begin(reader, &element_type, &count);
+            if (!ok || element_type != type->element->id ||
+                (type->id == BOND_TYPE_MAP && key_type != type->key->id))
+            {
+                return false;
+            }
+            write_length(writer, count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if ((type->id == BOND_TYPE_MAP &&
+                     !compact_to_simple_value(reader, type->key, writer)) ||
+                    !compact_to_simple_value(reader, type->element, writer))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool bond_simple_from_compact(BondReader *reader, const BondSchemaStruct *schema,
+                              bond_simple_writer *writer)
+{
+    size_t read_start = reader->buffer->read_pos;
+    size_t write_start = writer->buffer->size;
+    if (!compact_to_simple_fields(reader, schema, BOND_TYPE_STOP, writer))
+    {
+        reader->buffer->read_pos = read_start;
+        writer->buffer->size = write_start;
+        return false;
+    }
+    return true;
+}
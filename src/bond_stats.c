@@ -0,0 +1,60 @@
+/**
+ * @file bond_stats.c
+ * @brief Per-thread encode/decode counters
+ */
+
+#include "bond_stats.h"
+#include <string.h>
+
+#ifdef BOND_LITE_STATS
+BOND_STATS_THREAD_LOCAL bond_stats bond_stats_current;
+#endif
+
+bool bond_stats_enabled(void)
+{
+#ifdef BOND_LITE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void bond_stats_snapshot(bond_stats *out)
+{
+#ifdef BOND_LITE_STATS
+    *out = bond_stats_current;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+void bond_stats_reset(void)
+{
+#ifdef BOND_LITE_STATS
+    memset(&bond_stats_current, 0, sizeof(bond_stats_current));
+#endif
+}
+
+void bond_stats_merge(bond_stats *total, const bond_stats *stats)
+{
+    total->bytes_written += stats->bytes_written;
+    total->bytes_read += stats->bytes_read;
+    total->bytes_skipped += stats->bytes_skipped;
+    total->reserve_reallocs += stats->reserve_reallocs;
+    total->reserve_bytes_copied += stats->reserve_bytes_copied;
+    total->pool_hits += stats->pool_hits;
+    total->pool_misses += stats->pool_misses;
+    total->pool_remote_releases += stats->pool_remote_releases;
+    for (int kind = 0; kind < BOND_STATS_VARINT_KIND_COUNT; kind++)
+    {
+        for (int len = 0; len < BOND_STATS_VARINT_MAX_BYTES; len++)
+        {
+            total->varint_written[kind][len] += stats->varint_written[kind][len];
+            total->varint_read[kind][len] += stats->varint_read[kind][len];
+        }
+    }
+    if (stats->max_depth > total->max_depth)
+    {
+        total->max_depth = stats->max_depth;
+    }
+}
@@ -0,0 +1,750 @@
+/**
+ * @file bond_transcode.c
+ * @brief CompactBinary v1 <-> v2 re-encoding implementation
+ */
+
+#include "bond_transcode.h"
+#include "bond_encoding.h"
+#include "bond_types.h"
+#include <string.h>
+
+// ============================================================================
+// Re-encoder Internals
+// ============================================================================
+
+// Room left for a v2 struct length before its size is known
+#define LENGTH_PLACEHOLDER_SIZE 5
+
+typedef struct {
+    const uint8_t *pos;     // Next input byte
+    const uint8_t *end;     // One past the input
+    const uint8_t *run;     // First input byte not yet copied to out
+    bond_buffer *out;
+    uint16_t from_version;
+    uint16_t to_version;
+    bool truncated;         // Failed for lack of input, not bad input
+    bool out_failed;        // Output allocation failed
+} transcode_ctx;
+
+static bool is_value_type(uint8_t type)
+{
+    return type >= BOND_TYPE_BOOL && type <= BOND_TYPE_WSTRING;
+}
+
+static bool need(transcode_ctx *ctx, uint64_t len)
+{
+    if ((uint64_t)(ctx->end - ctx->pos) < len)
+    {
+        ctx->truncated = true;
+        return false;
+    }
+    return true;
+}
+
+static bool skip_bytes(transcode_ctx *ctx, uint64_t len)
+{
+    if (!need(ctx, len))
+    {
+        return false;
+    }
+    ctx->pos += len;
+    return true;
+}
+
+static bool skip_varint(transcode_ctx *ctx, size_t max_bytes, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < max_bytes; i++)
+    {
+        if (!need(ctx, 1))
+        {
+            return false;
+        }
+        uint8_t byte = *ctx->pos++;
+        result |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0)
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;  // Too many continuation bytes
+}
+
+static void emit(transcode_ctx *ctx, const void *data, size_t len)
+{
+    if (bond_buffer_write(ctx->out, data, len) != 0)
+    {
+        ctx->out_failed = true;
+    }
+}
+
+// Copy the unchanged input up to `upto`
+static void flush_run(transcode_ctx *ctx, const uint8_t *upto)
+{
+    emit(ctx, ctx->run, (size_t)(upto - ctx->run));
+    ctx->run = upto;
+}
+
+// Input from `from` up to the current position is replaced by `data`
+static void replace(transcode_ctx *ctx, const uint8_t *from, const uint8_t *data, size_t len)
+{
+    if (len == (size_t)(ctx->pos - from) && memcmp(from, data, len) == 0)
+    {
+        return;
+    }
+    flush_run(ctx, from);
+    emit(ctx, data, len);
+    ctx->run = ctx->pos;
+}
+
+/**
+ * Fill in a v2 struct length left as a placeholder at `mark`.
+ *
+ * Shorter lengths slide the struct body down so the output is the same as
+ * if the length had been known up front.
+ */
+static bool patch_length(transcode_ctx *ctx, size_t mark)
+{
+    bond_buffer *out = ctx->out;
+    size_t body = mark + LENGTH_PLACEHOLDER_SIZE;
+    size_t length = out->size - body;
+    if (length > UINT32_MAX)
+    {
+        return false;
+    }
+    uint8_t encoded[LENGTH_PLACEHOLDER_SIZE];
+    size_t len = bond_encode_varint32(encoded, (uint32_t)length);
+    memmove(out->data + mark + len, out->data + body, length);
+    memcpy(out->data + mark, encoded, len);
+    out->size -= LENGTH_PLACEHOLDER_SIZE - len;
+    return true;
+}
+
+static bool convert_value(transcode_ctx *ctx, uint8_t type, uint32_t depth);
+
+static bool convert_struct(transcode_ctx *ctx, uint32_t depth)
+{
+    if (depth >= BOND_TRANSCODE_MAX_DEPTH)
+    {
+        return false;
+    }
+
+    // Drop the v2 length; it is checked against the body at the end
+    const uint8_t *body = ctx->pos;
+    uint64_t length = 0;
+    if (ctx->from_version == BOND_COMPACT_VERSION_2)
+    {
+        if (!skip_varint(ctx, 5, &length))
+        {
+            return false;
+        }
+        flush_run(ctx, body);
+        ctx->run = ctx->pos;
+        body = ctx->pos;
+        if (!need(ctx, length))
+        {
+            return false;
+        }
+    }
+
+    // Reserve the v2 length; the stack of open marks is the recursion itself
+    size_t mark = 0;
+    if (ctx->to_version == BOND_COMPACT_VERSION_2)
+    {
+        static const uint8_t placeholder[LENGTH_PLACEHOLDER_SIZE] = {0};
+        flush_run(ctx, ctx->pos);
+        mark = ctx->out->size;
+        emit(ctx, placeholder, sizeof(placeholder));
+    }
+
+    while (true)
+    {
+        if (!need(ctx, 1))
+        {
+            return false;
+        }
+        uint8_t header = *ctx->pos++;
+        uint8_t type = header & 0x1F;
+        uint8_t id_hint = header >> 5;
+        if ((id_hint == 6 && !skip_bytes(ctx, 1)) || (id_hint == 7 && !skip_bytes(ctx, 2)))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            break;
+        }
+        if (type == BOND_TYPE_STOP_BASE)
+        {
+            continue;
+        }
+        if (!convert_value(ctx, type, depth + 1))
+        {
+            return false;
+        }
+    }
+
+    if (ctx->from_version == BOND_COMPACT_VERSION_2 && (uint64_t)(ctx->pos - body) != length)
+    {
+        return false;
+    }
+    if (ctx->to_version == BOND_COMPACT_VERSION_2)
+    {
+        flush_run(ctx, ctx->pos);
+        return !ctx->out_failed && patch_length(ctx, mark);
+    }
+    return true;
+}
+
+static bool convert_elements(transcode_ctx *ctx, uint8_t key_type, uint8_t value_type,
+                             bool is_map, uint32_t count, uint32_t depth)
+{
+    if (depth >= BOND_TRANSCODE_MAX_DEPTH)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (is_map && !convert_value(ctx, key_type, depth + 1))
+        {
+            return false;
+        }
+        if (!convert_value(ctx, value_type, depth + 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool convert_value(transcode_ctx *ctx, uint8_t type, uint32_t depth)
+{
+    uint64_t value;
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            return skip_bytes(ctx, 1);
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_INT16:
+            return skip_varint(ctx, 3, &value);
+
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_INT32:
+            return skip_varint(ctx, 5, &value);
+
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT64:
+            return skip_varint(ctx, 10, &value);
+
+        case BOND_TYPE_FLOAT:
+            return skip_bytes(ctx, 4);
+
+        case BOND_TYPE_DOUBLE:
+            return skip_bytes(ctx, 8);
+
+        case BOND_TYPE_STRING:
+            return skip_varint(ctx, 5, &value) && skip_bytes(ctx, value);
+
+        case BOND_TYPE_WSTRING:
+            return skip_varint(ctx, 5, &value) && skip_bytes(ctx, value * 2);
+
+        case BOND_TYPE_STRUCT:
+            return convert_struct(ctx, depth);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            const uint8_t *header = ctx->pos;
+            if (!need(ctx, 1))
+            {
+                return false;
+            }
+            uint8_t raw = *ctx->pos++;
+            uint8_t element_type = raw;
+            uint32_t count;
+            if (ctx->from_version == BOND_COMPACT_VERSION_2 && (raw >> 5) != 0)
+            {
+                element_type = raw & 0x1F;
+                count = (uint32_t)(raw >> 5) - 1;
+            }
+            else
+            {
+                if (ctx->from_version == BOND_COMPACT_VERSION_2)
+                {
+                    element_type = raw & 0x1F;
+                }
+                if (!skip_varint(ctx, 5, &value) || value > UINT32_MAX)
+                {
+                    return false;
+                }
+                count = (uint32_t)value;
+            }
+            if (!is_value_type(element_type))
+            {
+                return false;
+            }
+
+            uint8_t encoded[1 + 5];
+            size_t len;
+            if (ctx->to_version == BOND_COMPACT_VERSION_2 && count < 7)
+            {
+                encoded[0] = (uint8_t)(element_type | ((count + 1) << 5));
+                len = 1;
+            }
+            else
+            {
+                encoded[0] = element_type;
+                len = 1 + bond_encode_varint32(encoded + 1, count);
+            }
+            replace(ctx, header, encoded, len);
+            return convert_elements(ctx, 0, element_type, false, count, depth);
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            // Map headers are the same in both versions
+            if (!need(ctx, 2))
+            {
+                return false;
+            }
+            uint8_t key_type = *ctx->pos++;
+            uint8_t value_type = *ctx->pos++;
+            if (!is_value_type(key_type) || !is_value_type(value_type) ||
+                !skip_varint(ctx, 5, &value) || value > UINT32_MAX)
+            {
+                return false;
+            }
+            return convert_elements(ctx, key_type, value_type, true, (uint32_t)value, depth);
+        }
+
+        default:
+            return false;
+    }
+}
+
+static bool supported_version(uint16_t version)
+{
+    return version == BOND_COMPACT_VERSION_1 || version == BOND_COMPACT_VERSION_2;
+}
+
+/**
+ * Convert one struct from `data`.
+ *
+ * On success `*consumed` is its input length. On failure the output is
+ * rolled back and `*truncated` tells whether more input could fix it.
+ */
+static bool convert_record(const uint8_t *data, size_t len, uint16_t from_version,
+                           uint16_t to_version, bond_buffer *out, size_t *consumed,
+                           bool *truncated)
+{
+    transcode_ctx ctx;
+    ctx.pos = data;
+    ctx.end = data + len;
+    ctx.run = data;
+    ctx.out = out;
+    ctx.from_version = from_version;
+    ctx.to_version = to_version;
+    ctx.truncated = false;
+    ctx.out_failed = false;
+
+    size_t start = out->size;
+    bool ok = convert_struct(&ctx, 0);
+    if (ok)
+    {
+        flush_run(&ctx, ctx.pos);
+    }
+    if (!ok || ctx.out_failed)
+    {
+        out->size = start;
+        *truncated = ctx.truncated && !ctx.out_failed;
+        return false;
+    }
+    *consumed = (size_t)(ctx.pos - data);
+    return true;
+}
+
+// ============================================================================
+// One-shot
+// ============================================================================
+
+bool bond_compact_transcode(BondReader *reader, uint16_t from_version, uint16_t to_version,
+                            bond_buffer *out)
+{
+    if (!supported_version(from_version) || !supported_version(to_version))
+    {
+        return false;
+    }
+    bond_buffer *in = reader->buffer;
+    size_t consumed;
+    bool truncated;
+    if (!convert_record(in->data + in->read_pos, in->size - in->read_pos,
+                        from_version, to_version, out, &consumed, &truncated))
+    {
+        return false;
+    }
+    in->read_pos += consumed;
+    return true;
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+// Outcome of a step of the boundary scan
+#define SCAN_BAD  (-1)      // Malformed input
+#define SCAN_MORE 0         // Needs bytes past the end of the input
+#define SCAN_OK   1
+
+// Read a varint of at most `max_bytes` at data[pos]; advances *pos on success
+static int scan_varint(const uint8_t *data, size_t len, size_t *pos, size_t max_bytes,
+                       uint64_t *value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < max_bytes; i++)
+    {
+        if (*pos + i == len)
+        {
+            return SCAN_MORE;
+        }
+        uint8_t byte = data[*pos + i];
+        result |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0)
+        {
+            *pos += i + 1;
+            *value = result;
+            return SCAN_OK;
+        }
+    }
+    return SCAN_BAD;
+}
+
+static int push_frame(BondCompactTranscoder *t, uint8_t key_type, uint8_t value_type,
+                      uint32_t remaining)
+{
+    if (t->depth == BOND_TRANSCODE_MAX_DEPTH)
+    {
+        return SCAN_BAD;
+    }
+    BondCompactScanFrame *frame = &t->frames[t->depth++];
+    frame->key_type = key_type;
+    frame->value_type = value_type;
+    frame->at_value = false;
+    frame->remaining = remaining;
+    return SCAN_OK;
+}
+
+/**
+ * Step over the header of a value of `type` at data[*pos].
+ *
+ * Payload bytes are left in t->skip and nested structs and containers are
+ * pushed as frames. Nothing changes unless the whole header is present.
+ */
+static int scan_value(BondCompactTranscoder *t, const uint8_t *data, size_t len,
+                      size_t *pos, uint8_t type)
+{
+    size_t p = *pos;
+    uint64_t value;
+    int r;
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            t->skip = 1;
+            return SCAN_OK;
+
+        case BOND_TYPE_FLOAT:
+            t->skip = 4;
+            return SCAN_OK;
+
+        case BOND_TYPE_DOUBLE:
+            t->skip = 8;
+            return SCAN_OK;
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_INT16:
+            r = scan_varint(data, len, &p, 3, &value);
+            break;
+
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_INT32:
+            r = scan_varint(data, len, &p, 5, &value);
+            break;
+
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT64:
+            r = scan_varint(data, len, &p, 10, &value);
+            break;
+
+        case BOND_TYPE_STRING:
+        case BOND_TYPE_WSTRING:
+            r = scan_varint(data, len, &p, 5, &value);
+            if (r == SCAN_OK)
+            {
+                t->skip = type == BOND_TYPE_WSTRING ? value * 2 : value;
+            }
+            break;
+
+        case BOND_TYPE_STRUCT:
+            if (t->from_version == BOND_COMPACT_VERSION_2)
+            {
+                // The length prefix covers the whole body
+                r = scan_varint(data, len, &p, 5, &value);
+                if (r == SCAN_OK)
+                {
+                    t->skip = value;
+                }
+                break;
+            }
+            r = push_frame(t, BOND_TYPE_STOP, BOND_TYPE_STOP, 0);
+            break;
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            if (p == len)
+            {
+                return SCAN_MORE;
+            }
+            uint8_t raw = data[p++];
+            uint8_t element_type = raw;
+            if (t->from_version == BOND_COMPACT_VERSION_2)
+            {
+                element_type = raw & 0x1F;
+            }
+            if (t->from_version == BOND_COMPACT_VERSION_2 && (raw >> 5) != 0)
+            {
+                value = (uint64_t)(raw >> 5) - 1;
+                r = SCAN_OK;
+            }
+            else
+            {
+                r = scan_varint(data, len, &p, 5, &value);
+            }
+            if (r == SCAN_OK)
+            {
+                if (value > UINT32_MAX || !is_value_type(element_type))
+                {
+                    return SCAN_BAD;
+                }
+                r = push_frame(t, BOND_TYPE_STOP, element_type, (uint32_t)value);
+            }
+            break;
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            if (len - p < 2)
+            {
+                return SCAN_MORE;
+            }
+            uint8_t key_type = data[p++];
+            uint8_t value_type = data[p++];
+            if (!is_value_type(key_type) || !is_value_type(value_type))
+            {
+                return SCAN_BAD;
+            }
+            r = scan_varint(data, len, &p, 5, &value);
+            if (r == SCAN_OK)
+            {
+                if (value > UINT32_MAX)
+                {
+                    return SCAN_BAD;
+                }
+                r = push_frame(t, key_type, value_type, (uint32_t)value);
+            }
+            break;
+        }
+
+        default:
+            return SCAN_BAD;
+    }
+    if (r == SCAN_OK)
+    {
+        *pos = p;
+    }
+    return r;
+}
+
+/**
+ * Continue looking for the end of the struct at `data`.
+ *
+ * Picks up at t->scanned and leaves it at the first byte not yet accounted
+ * for; on SCAN_OK that is the struct's length.
+ */
+static int scan_struct(BondCompactTranscoder *t, const uint8_t *data, size_t len)
+{
+    size_t pos = t->scanned;
+    int r = SCAN_OK;
+    while (r == SCAN_OK)
+    {
+        if (t->skip > 0)
+        {
+            size_t step = len - pos < t->skip ? len - pos : (size_t)t->skip;
+            pos += step;
+            t->skip -= step;
+            if (t->skip > 0)
+            {
+                r = SCAN_MORE;
+                break;
+            }
+        }
+
+        if (t->depth == 0)
+        {
+            if (pos > 0)
+            {
+                break;      // Top-level struct closed
+            }
+            r = scan_value(t, data, len, &pos, BOND_TYPE_STRUCT);
+            continue;
+        }
+
+        uint32_t index = t->depth - 1;
+        BondCompactScanFrame *frame = &t->frames[index];
+        if (frame->key_type == BOND_TYPE_STOP && frame->value_type == BOND_TYPE_STOP)
+        {
+            // Struct: field header and the value's own header as one step
+            size_t p = pos;
+            if (p == len)
+            {
+                r = SCAN_MORE;
+                break;
+            }
+            uint8_t header = data[p++];
+            uint8_t type = header & 0x1F;
+            size_t id_bytes = (header >> 5) == 6 ? 1 : (header >> 5) == 7 ? 2 : 0;
+            if (len - p < id_bytes)
+            {
+                r = SCAN_MORE;
+                break;
+            }
+            p += id_bytes;
+            if (type == BOND_TYPE_STOP)
+            {
+                t->depth--;
+            }
+            else if (type != BOND_TYPE_STOP_BASE)
+            {
+                r = scan_value(t, data, len, &p, type);
+                if (r != SCAN_OK)
+                {
+                    break;
+                }
+            }
+            pos = p;
+            continue;
+        }
+
+        if (frame->remaining == 0)
+        {
+            t->depth--;
+            continue;
+        }
+        bool is_key = frame->key_type != BOND_TYPE_STOP && !frame->at_value;
+        r = scan_value(t, data, len, &pos, is_key ? frame->key_type : frame->value_type);
+        if (r == SCAN_OK)
+        {
+            frame = &t->frames[index];
+            if (is_key)
+            {
+                frame->at_value = true;
+            }
+            else
+            {
+                frame->at_value = false;
+                frame->remaining--;
+            }
+        }
+    }
+    t->scanned = pos;
+    return r;
+}
+
+static void reset_scan(BondCompactTranscoder *transcoder)
+{
+    transcoder->scanned = 0;
+    transcoder->skip = 0;
+    transcoder->depth = 0;
+}
+
+bool bond_compact_transcoder_init(BondCompactTranscoder *transcoder,
+                                  uint16_t from_version, uint16_t to_version)
+{
+    if (!supported_version(from_version) || !supported_version(to_version))
+    {
+        return false;
+    }
+    transcoder->from_version = from_version;
+    transcoder->to_version = to_version;
+    reset_scan(transcoder);
+    return bond_buffer_init(&transcoder->pending, 256) == 0;
+}
+
+void bond_compact_transcoder_destroy(BondCompactTranscoder *transcoder)
+{
+    bond_buffer_destroy(&transcoder->pending);
+}
+
+bool bond_compact_transcoder_feed(BondCompactTranscoder *transcoder,
+                                  const uint8_t *data, size_t len, bond_buffer *out)
+{
+    bond_buffer *pending = &transcoder->pending;
+
+    // Convert straight from the chunk unless a struct is already half-way in
+    bool buffered = pending->size > 0;
+    if (buffered)
+    {
+        if (bond_buffer_write(pending, data, len) != 0)
+        {
+            return false;
+        }
+        data = pending->data;
+        len = pending->size;
+    }
+
+    // Convert each struct once its end has been found
+    size_t offset = 0;
+    while (offset < len)
+    {
+        int r = scan_struct(transcoder, data + offset, len - offset);
+        if (r == SCAN_BAD)
+        {
+            return false;
+        }
+        if (r == SCAN_MORE)
+        {
+            break;
+        }
+        size_t record = transcoder->scanned;
+        reset_scan(transcoder);
+
+        size_t consumed;
+        bool truncated;
+        if (!convert_record(data + offset, record, transcoder->from_version,
+                            transcoder->to_version, out, &consumed, &truncated) ||
+            consumed != record)
+        {
+            return false;
+        }
+        offset += record;
+    }
+
+    // Keep the incomplete tail for the next chunk
+    if (buffered)
+    {
+        memmove(pending->data, pending->data + offset, len - offset);
+        pending->size = len - offset;
+        return true;
+    }
+    return bond_buffer_write(pending, data + offset, len - offset) == 0;
+}
+
+bool bond_compact_transcoder_finish(BondCompactTranscoder *transcoder)
+{
+    return transcoder->pending.size == 0;
+}
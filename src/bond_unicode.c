@@ -0,0 +1,614 @@
+/**
+ * @file bond_unicode.c
+ * @brief UTF-8 validation and UTF-16 transcoding with runtime SIMD dispatch
+ *
+ * The SIMD paths implement the lookup algorithm from Keiser & Lemire,
+ * "Validating UTF-8 In Less Than One Instruction Per Byte" (2021): three
+ * 16-entry nibble tables classify every (previous byte, current byte) pair,
+ * and a saturating subtract finds bytes that must be 3rd/4th continuations.
+ */
+
+#include "bond_unicode.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BOND_UNICODE_X86 1
+#include <immintrin.h>
+#endif
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+bool bond_utf8_validate_scalar(const uint8_t *data, size_t len)
+{
+    size_t i = 0;
+    while (i < len)
+    {
+        // ASCII run, 8 bytes at a time
+        while (i + 8 <= len)
+        {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            if (word & 0x8080808080808080ULL)
+            {
+                break;
+            }
+            i += 8;
+        }
+        if (i == len)
+        {
+            break;
+        }
+
+        uint8_t lead = data[i];
+        if (lead < 0x80)
+        {
+            i++;
+            continue;
+        }
+
+        size_t need;
+        uint8_t lo = 0x80, hi = 0xBF;  // Allowed range of the 2nd byte
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            need = 1;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            need = 2;
+            if (lead == 0xE0) lo = 0xA0;  // Overlong
+            if (lead == 0xED) hi = 0x9F;  // Surrogates
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            need = 3;
+            if (lead == 0xF0) lo = 0x90;  // Overlong
+            if (lead == 0xF4) hi = 0x8F;  // Above U+10FFFF
+        }
+        else
+        {
+            return false;  // Continuation, overlong 2-byte lead, or 0xF5+
+        }
+
+        if (len - i - 1 < need)
+        {
+            return false;
+        }
+        if (data[i + 1] < lo || data[i + 1] > hi)
+        {
+            return false;
+        }
+        for (size_t k = 2; k <= need; k++)
+        {
+            if ((data[i + k] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        i += need + 1;
+    }
+    return true;
+}
+
+#ifdef BOND_UNICODE_X86
+
+// ============================================================================
+// Lookup Tables
+// ============================================================================
+
+#define TOO_SHORT   (1 << 0)  // 11______ 0_______ or 11______ 11______
+#define TOO_LONG    (1 << 1)  // 0_______ 10______
+#define OVERLONG_3  (1 << 2)  // 11100000 100_____
+#define TOO_LARGE   (1 << 3)  // 11110100 1001____ and above
+#define SURROGATE   (1 << 4)  // 11101101 101_____
+#define OVERLONG_2  (1 << 5)  // 1100000_ 10______
+#define TOO_LARGE_1000 (1 << 6)  // 11110101 1000____ and above
+#define OVERLONG_4  (1 << 6)  // 11110000 1000____
+#define TWO_CONTS   (1 << 7)  // 10______ 10______
+#define CARRY       (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+// Indexed by the high nibble of the previous byte
+static const uint8_t byte_1_high_table[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+// Indexed by the low nibble of the previous byte
+static const uint8_t byte_1_low_table[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+// Indexed by the high nibble of the current byte
+static const uint8_t byte_2_high_table[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+// A block ending in a lead byte whose sequence continues into the next block
+// has at least one of its last three bytes above these limits.
+static const uint8_t max_complete_tail[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+// ============================================================================
+// SSSE3 (16 bytes per step)
+// ============================================================================
+
+__attribute__((target("ssse3")))
+static bool utf8_validate_ssse3(const uint8_t *data, size_t len)
+{
+    const __m128i t1 = _mm_loadu_si128((const __m128i *)byte_1_high_table);
+    const __m128i t2 = _mm_loadu_si128((const __m128i *)byte_1_low_table);
+    const __m128i t3 = _mm_loadu_si128((const __m128i *)byte_2_high_table);
+    const __m128i max_tail = _mm_loadu_si128((const __m128i *)(max_complete_tail + 16));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i third_limit = _mm_set1_epi8((char)(0xE0 - 0x80));
+    const __m128i fourth_limit = _mm_set1_epi8((char)(0xF0 - 0x80));
+    const __m128i high_bit = _mm_set1_epi8((char)0x80);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+
+    size_t i = 0;
+    while (i < len)
+    {
+        __m128i input;
+        if (len - i >= 16)
+        {
+            input = _mm_loadu_si128((const __m128i *)(data + i));
+        }
+        else
+        {
+            // Zero padding is ASCII and cannot hide an error
+            uint8_t tail[16] = {0};
+            memcpy(tail, data + i, len - i);
+            input = _mm_loadu_si128((const __m128i *)tail);
+        }
+        i += 16;
+
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            // Pure ASCII: only a sequence left open by the last block can fail
+            error = _mm_or_si128(error, prev_incomplete);
+        }
+        else
+        {
+            __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+            __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+
+            __m128i b1h = _mm_shuffle_epi8(t1, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            __m128i b1l = _mm_shuffle_epi8(t2, _mm_and_si128(prev1, nibble));
+            __m128i b2h = _mm_shuffle_epi8(t3, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+            __m128i special = _mm_and_si128(_mm_and_si128(b1h, b1l), b2h);
+
+            __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, third_limit),
+                                          _mm_subs_epu8(prev3, fourth_limit));
+            __m128i must23_80 = _mm_and_si128(must23, high_bit);
+
+            error = _mm_or_si128(error, _mm_xor_si128(must23_80, special));
+            prev_incomplete = _mm_subs_epu8(input, max_tail);
+        }
+        prev_input = input;
+    }
+    error = _mm_or_si128(error, prev_incomplete);
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+
+// ============================================================================
+// AVX2 (32 bytes per step)
+// ============================================================================
+
+__attribute__((target("avx2")))
+static bool utf8_validate_avx2(const uint8_t *data, size_t len)
+{
+    const __m256i t1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_1_high_table));
+    const __m256i t2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_1_low_table));
+    const __m256i t3 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte_2_high_table));
+    const __m256i max_tail = _mm256_loadu_si256((const __m256i *)max_complete_tail);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i third_limit = _mm256_set1_epi8((char)(0xE0 - 0x80));
+    const __m256i fourth_limit = _mm256_set1_epi8((char)(0xF0 - 0x80));
+    const __m256i high_bit = _mm256_set1_epi8((char)0x80);
+
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+
+    size_t i = 0;
+    while (i < len)
+    {
+        __m256i input;
+        if (len - i >= 32)
+        {
+            input = _mm256_loadu_si256((const __m256i *)(data + i));
+        }
+        else
+        {
+            uint8_t tail[32] = {0};
+            memcpy(tail, data + i, len - i);
+            input = _mm256_loadu_si256((const __m256i *)tail);
+        }
+        i += 32;
+
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            error = _mm256_or_si256(error, prev_incomplete);
+        }
+        else
+        {
+            // Shift in the tail of the previous block across the lane boundary
+            __m256i carried = _mm256_permute2x128_si256(prev_input, input, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+            __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+            __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+            __m256i b1h = _mm256_shuffle_epi8(t1, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            __m256i b1l = _mm256_shuffle_epi8(t2, _mm256_and_si256(prev1, nibble));
+            __m256i b2h = _mm256_shuffle_epi8(t3, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+
+            __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, third_limit),
+                                             _mm256_subs_epu8(prev3, fourth_limit));
+            __m256i must23_80 = _mm256_and_si256(must23, high_bit);
+
+            error = _mm256_or_si256(error, _mm256_xor_si256(must23_80, special));
+            prev_incomplete = _mm256_subs_epu8(input, max_tail);
+        }
+        prev_input = input;
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+#endif // BOND_UNICODE_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+bool bond_utf8_validate(const uint8_t *data, size_t len)
+{
+#ifdef BOND_UNICODE_X86
+    // Short strings are not worth a vector setup
+    if (len >= 16)
+    {
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return utf8_validate_avx2(data, len);
+        }
+        if (__builtin_cpu_supports("ssse3"))
+        {
+            return utf8_validate_ssse3(data, len);
+        }
+    }
+#endif
+    return bond_utf8_validate_scalar(data, len);
+}
+
+// ============================================================================
+// UTF-16 Transcoding - ASCII Runs
+// ============================================================================
+
+// Each helper converts a prefix of pure ASCII and returns how many characters
+// it consumed; the caller handles everything from the first non-ASCII one.
+
+static size_t widen_ascii_scalar(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t i = 0;
+    while (i < len && src[i] < 0x80)
+    {
+        dst[2 * i] = src[i];
+        dst[2 * i + 1] = 0;
+        i++;
+    }
+    return i;
+}
+
+static size_t narrow_ascii_scalar(const uint8_t *src, size_t units, uint8_t *dst)
+{
+    size_t i = 0;
+    while (i < units && src[2 * i] < 0x80 && src[2 * i + 1] == 0)
+    {
+        dst[i] = src[2 * i];
+        i++;
+    }
+    return i;
+}
+
+#ifdef BOND_UNICODE_X86
+
+__attribute__((target("sse2")))
+static size_t widen_ascii_sse2(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    while (i + 16 <= len)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(bytes) != 0)
+        {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(bytes, zero));
+        i += 16;
+    }
+    return i + widen_ascii_scalar(src + i, len - i, dst + 2 * i);
+}
+
+__attribute__((target("sse2")))
+static size_t narrow_ascii_sse2(const uint8_t *src, size_t units, uint8_t *dst)
+{
+    const __m128i non_ascii = _mm_set1_epi16((short)0xFF80);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    while (i + 16 <= units)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+        __m128i hi = _mm_loadu_si128((const __m128i *)(src + 2 * i + 16));
+        __m128i high_bits = _mm_and_si128(_mm_or_si128(lo, hi), non_ascii);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, zero)) != 0xFFFF)
+        {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+        i += 16;
+    }
+    return i + narrow_ascii_scalar(src + 2 * i, units - i, dst + i);
+}
+
+#endif // BOND_UNICODE_X86
+
+static size_t widen_ascii(const uint8_t *src, size_t len, uint8_t *dst)
+{
+#ifdef BOND_UNICODE_X86
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return widen_ascii_sse2(src, len, dst);
+    }
+#endif
+    return widen_ascii_scalar(src, len, dst);
+}
+
+static size_t narrow_ascii(const uint8_t *src, size_t units, uint8_t *dst)
+{
+#ifdef BOND_UNICODE_X86
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return narrow_ascii_sse2(src, units, dst);
+    }
+#endif
+    return narrow_ascii_scalar(src, units, dst);
+}
+
+// ============================================================================
+// UTF-16 Transcoding
+// ============================================================================
+
+// Decode one UTF-8 sequence. Returns its length, or 0 if malformed.
+static size_t decode_utf8(const uint8_t *src, size_t avail, uint32_t *code_point)
+{
+    uint8_t lead = src[0];
+    if (lead < 0x80)
+    {
+        *code_point = lead;
+        return 1;
+    }
+
+    size_t need;
+    uint32_t cp;
+    uint8_t lo = 0x80, hi = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        need = 1;
+        cp = lead & 0x1F;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        need = 2;
+        cp = lead & 0x0F;
+        if (lead == 0xE0) lo = 0xA0;
+        if (lead == 0xED) hi = 0x9F;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        need = 3;
+        cp = lead & 0x07;
+        if (lead == 0xF0) lo = 0x90;
+        if (lead == 0xF4) hi = 0x8F;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (avail - 1 < need || src[1] < lo || src[1] > hi)
+    {
+        return 0;
+    }
+    for (size_t k = 1; k <= need; k++)
+    {
+        if ((src[k] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        cp = (cp << 6) | (src[k] & 0x3F);
+    }
+    *code_point = cp;
+    return need + 1;
+}
+
+size_t bond_utf8_utf16_length(const uint8_t *src, size_t len)
+{
+    // One unit per non-continuation byte, plus one for each 4-byte lead
+    size_t units = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        units += ((src[i] & 0xC0) != 0x80) + (src[i] >= 0xF0);
+    }
+    return units;
+}
+
+bool bond_utf8_to_utf16le(const uint8_t *src, size_t len,
+                          uint8_t *dst, size_t capacity, size_t *units)
+{
+    size_t i = 0;
+    size_t out = 0;  // Code units written
+    size_t max_units = capacity / 2;
+
+    while (i < len)
+    {
+        size_t run = len - i;
+        if (run > max_units - out)
+        {
+            run = max_units - out;
+        }
+        size_t ascii = widen_ascii(src + i, run, dst + 2 * out);
+        i += ascii;
+        out += ascii;
+        if (i == len)
+        {
+            break;
+        }
+
+        uint32_t cp;
+        size_t seq_len = decode_utf8(src + i, len - i, &cp);
+        if (seq_len == 0)
+        {
+            return false;
+        }
+        size_t needed = (cp >= 0x10000) ? 2 : 1;
+        if (max_units - out < needed)
+        {
+            return false;
+        }
+        if (cp >= 0x10000)
+        {
+            cp -= 0x10000;
+            uint16_t high = (uint16_t)(0xD800 | (cp >> 10));
+            uint16_t low = (uint16_t)(0xDC00 | (cp & 0x3FF));
+            dst[2 * out] = (uint8_t)high;
+            dst[2 * out + 1] = (uint8_t)(high >> 8);
+            dst[2 * out + 2] = (uint8_t)low;
+            dst[2 * out + 3] = (uint8_t)(low >> 8);
+        }
+        else
+        {
+            dst[2 * out] = (uint8_t)cp;
+            dst[2 * out + 1] = (uint8_t)(cp >> 8);
+        }
+        out += needed;
+        i += seq_len;
+    }
+
+    *units = out;
+    return true;
+}
+
+bool bond_utf16le_to_utf8(const uint8_t *src, size_t units,
+                          uint8_t *dst, size_t capacity, size_t *written)
+{
+    size_t i = 0;    // Code units consumed
+    size_t out = 0;  // Bytes written
+
+    while (i < units)
+    {
+        size_t run = units - i;
+        if (run > capacity - out)
+        {
+            run = capacity - out;
+        }
+        size_t ascii = narrow_ascii(src + 2 * i, run, dst + out);
+        i += ascii;
+        out += ascii;
+        if (i == units)
+        {
+            break;
+        }
+
+        uint32_t cp = (uint32_t)(src[2 * i] | (src[2 * i + 1] << 8));
+        i++;
+        if (cp >= 0xD800 && cp <= 0xDBFF)
+        {
+            if (i == units)
+            {
+                return false;
+            }
+            uint32_t low = (uint32_t)(src[2 * i] | (src[2 * i + 1] << 8));
+            if (low < 0xDC00 || low > 0xDFFF)
+            {
+                return false;
+            }
+            i++;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (cp >= 0xDC00 && cp <= 0xDFFF)
+        {
+            return false;  // Unpaired low surrogate
+        }
+
+        size_t needed = (cp < 0x80) ? 1 : (cp < 0x800) ? 2 : (cp < 0x10000) ? 3 : 4;
+        if (capacity - out < needed)
+        {
+            return false;
+        }
+        switch (needed)
+        {
+            case 1:
+                dst[out] = (uint8_t)cp;
+                break;
+            case 2:
+                dst[out] = (uint8_t)(0xC0 | (cp >> 6));
+                dst[out + 1] = (uint8_t)(0x80 | (cp & 0x3F));
+                break;
+            case 3:
+                dst[out] = (uint8_t)(0xE0 | (cp >> 12));
+                dst[out + 1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                dst[out + 2] = (uint8_t)(0x80 | (cp & 0x3F));
+                break;
+            default:
+                dst[out] = (uint8_t)(0xF0 | (cp >> 18));
+                dst[out + 1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+                dst[out + 2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                dst[out + 3] = (uint8_t)(0x80 | (cp & 0x3F));
+                break;
+        }
+        out += needed;
+    }
+
+    *written = out;
+    return true;
+}
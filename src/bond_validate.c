@@ -0,0 +1,515 @@
+/**
+ * @file bond_validate.c
+ * @brief Structural validator and unchecked reader implementation
+ */
+
+#include "bond_validate.h"
+#include "bond_encoding.h"
+#include "bond_unicode.h"
+#include <string.h>
+
+// ============================================================================
+// Validator Internals
+// ============================================================================
+
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+    uint32_t max_depth;
+    bool validate_utf8;
+} validate_ctx;
+
+// Value types that may appear in a field or container header
+static bool is_value_type(uint8_t type)
+{
+    return type >= BOND_TYPE_BOOL && type <= BOND_TYPE_WSTRING;
+}
+
+// Smallest possible encoding of a value, used to bound container counts
+static size_t min_value_size(uint8_t type)
+{
+    switch (type)
+    {
+        case BOND_TYPE_FLOAT:
+            return 4;
+        case BOND_TYPE_DOUBLE:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
+// Width of values that are a fixed number of bytes, 0 otherwise
+static size_t fixed_value_size(uint8_t type)
+{
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            return 1;
+        case BOND_TYPE_FLOAT:
+            return 4;
+        case BOND_TYPE_DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// Check a varint of at most `max_bytes` bytes and return its value
+static bool check_varint(validate_ctx *ctx, size_t max_bytes, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < max_bytes; i++)
+    {
+        if (ctx->pos == ctx->end)
+        {
+            return false;
+        }
+        uint8_t byte = *ctx->pos++;
+        result |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0)
+        {
+            *value = result;
+            return true;
+        }
+    }
+    return false;  // Too many continuation bytes
+}
+
+static bool check_bytes(validate_ctx *ctx, uint64_t len)
+{
+    if ((uint64_t)(ctx->end - ctx->pos) < len)
+    {
+        return false;
+    }
+    ctx->pos += len;
+    return true;
+}
+
+static bool check_value(validate_ctx *ctx, uint8_t type, uint32_t depth);
+
+static bool check_struct(validate_ctx *ctx, uint32_t depth)
+{
+    if (depth >= ctx->max_depth)
+    {
+        return false;
+    }
+    while (true)
+    {
+        if (ctx->pos == ctx->end)
+        {
+            return false;
+        }
+        uint8_t header = *ctx->pos++;
+        uint8_t type = header & 0x1F;
+        uint8_t id_hint = header >> 5;
+        if (id_hint == 6 && !check_bytes(ctx, 1))
+        {
+            return false;
+        }
+        if (id_hint == 7 && !check_bytes(ctx, 2))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            return true;
+        }
+        if (type == BOND_TYPE_STOP_BASE)
+        {
+            continue;       // End of a base section; derived fields follow
+        }
+        if (!check_value(ctx, type, depth + 1))
+        {
+            return false;
+        }
+    }
+}
+
+static bool check_elements(validate_ctx *ctx, uint8_t key_type, uint8_t value_type,
+                           bool is_map, uint32_t depth)
+{
+    if (depth >= ctx->max_depth)
+    {
+        return false;
+    }
+
+    uint64_t count;
+    if (!check_varint(ctx, 5, &count))
+    {
+        return false;
+    }
+
+    size_t min_size = min_value_size(value_type) + (is_map ? min_value_size(key_type) : 0);
+    if (count > (uint64_t)(ctx->end - ctx->pos) / min_size)
+    {
+        return false;
+    }
+
+    // Fixed-width lists are validated arithmetically, no per-element walk
+    size_t width = fixed_value_size(value_type);
+    if (!is_map && width != 0)
+    {
+        return check_bytes(ctx, count * width);
+    }
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        if (is_map && !check_value(ctx, key_type, depth + 1))
+        {
+            return false;
+        }
+        if (!check_value(ctx, value_type, depth + 1))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool check_value(validate_ctx *ctx, uint8_t type, uint32_t depth)
+{
+    uint64_t value;
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            return check_bytes(ctx, 1);
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_INT16:
+            return check_varint(ctx, 3, &value);
+
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_INT32:
+            return check_varint(ctx, 5, &value);
+
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT64:
+            return check_varint(ctx, 10, &value);
+
+        case BOND_TYPE_FLOAT:
+            return check_bytes(ctx, 4);
+
+        case BOND_TYPE_DOUBLE:
+            return check_bytes(ctx, 8);
+
+        case BOND_TYPE_STRING:
+        {
+            const uint8_t *start;
+            if (!check_varint(ctx, 5, &value))
+            {
+                return false;
+            }
+            start = ctx->pos;
+            if (!check_bytes(ctx, value))
+            {
+                return false;
+            }
+            return !ctx->validate_utf8 || bond_utf8_validate(start, (size_t)value);
+        }
+
+        case BOND_TYPE_WSTRING:
+            // Length counts UTF-16 code units
+            return check_varint(ctx, 5, &value) && check_bytes(ctx, value * 2);
+
+        case BOND_TYPE_STRUCT:
+            return check_struct(ctx, depth);
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            if (ctx->pos == ctx->end)
+            {
+                return false;
+            }
+            uint8_t element_type = *ctx->pos++;
+            if (!is_value_type(element_type))
+            {
+                return false;
+            }
+            return check_elements(ctx, 0, element_type, false, depth);
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            if (ctx->end - ctx->pos < 2)
+            {
+                return false;
+            }
+            uint8_t key_type = *ctx->pos++;
+            uint8_t value_type = *ctx->pos++;
+            if (!is_value_type(key_type) || !is_value_type(value_type))
+            {
+                return false;
+            }
+            return check_elements(ctx, key_type, value_type, true, depth);
+        }
+
+        default:
+            // Unknown type
+            return false;
+    }
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+bool bond_validate(const bond_buffer *buffer, const BondValidateLimits *limits,
+                   BondValidationToken *token)
+{
+    validate_ctx ctx;
+    ctx.pos = buffer->data + buffer->read_pos;
+    ctx.end = buffer->data + buffer->size;
+    ctx.max_depth = (limits != NULL && limits->max_depth != 0)
+                        ? limits->max_depth
+                        : BOND_VALIDATE_DEFAULT_MAX_DEPTH;
+    ctx.validate_utf8 = (limits != NULL) && limits->validate_utf8;
+
+    const uint8_t *start = ctx.pos;
+    token->valid = check_struct(&ctx, 0);
+    token->data = start;
+    token->size = token->valid ? (size_t)(ctx.pos - start) : 0;
+    return token->valid;
+}
+
+// ============================================================================
+// Unchecked Reader
+// ============================================================================
+
+bool bond_unchecked_reader_init(BondUncheckedReader *reader, const BondValidationToken *token)
+{
+    if (!token->valid)
+    {
+        return false;
+    }
+    reader->pos = token->data;
+    reader->end = token->data + token->size;
+    return true;
+}
+
+// Varints are known to terminate within their type's max length
+static uint32_t read_varint32(BondUncheckedReader *reader)
+{
+    uint32_t result = 0;
+    int shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = *reader->pos++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return result;
+}
+
+static uint64_t read_varint64(BondUncheckedReader *reader)
+{
+    uint64_t result = 0;
+    int shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = *reader->pos++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return result;
+}
+
+void bond_unchecked_read_field_header(BondUncheckedReader *reader, uint16_t *field_id, uint8_t *type)
+{
+    uint8_t header = *reader->pos++;
+    uint8_t id_hint = header >> 5;
+    *type = header & 0x1F;
+
+    if (id_hint < 6)
+    {
+        *field_id = id_hint;
+    }
+    else if (id_hint == 6)
+    {
+        *field_id = *reader->pos++;
+    }
+    else
+    {
+        *field_id = (uint16_t)(reader->pos[0] | (reader->pos[1] << 8));
+        reader->pos += 2;
+    }
+}
+
+bool bond_unchecked_read_bool_value(BondUncheckedReader *reader)
+{
+    return *reader->pos++ != 0;
+}
+
+uint8_t bond_unchecked_read_uint8_value(BondUncheckedReader *reader)
+{
+    return *reader->pos++;
+}
+
+uint16_t bond_unchecked_read_uint16_value(BondUncheckedReader *reader)
+{
+    return (uint16_t)read_varint32(reader);
+}
+
+uint32_t bond_unchecked_read_uint32_value(BondUncheckedReader *reader)
+{
+    return read_varint32(reader);
+}
+
+uint64_t bond_unchecked_read_uint64_value(BondUncheckedReader *reader)
+{
+    return read_varint64(reader);
+}
+
+int8_t bond_unchecked_read_int8_value(BondUncheckedReader *reader)
+{
+    return (int8_t)*reader->pos++;
+}
+
+int16_t bond_unchecked_read_int16_value(BondUncheckedReader *reader)
+{
+    return bond_zigzag_decode16((uint16_t)read_varint32(reader));
+}
+
+int32_t bond_unchecked_read_int32_value(BondUncheckedReader *reader)
+{
+    return bond_zigzag_decode32(read_varint32(reader));
+}
+
+int64_t bond_unchecked_read_int64_value(BondUncheckedReader *reader)
+{
+    return bond_zigzag_decode64(read_varint64(reader));
+}
+
+float bond_unchecked_read_float_value(BondUncheckedReader *reader)
+{
+    float value = bond_decode_float(reader->pos);
+    reader->pos += 4;
+    return value;
+}
+
+double bond_unchecked_read_double_value(BondUncheckedReader *reader)
+{
+    double value = bond_decode_double(reader->pos);
+    reader->pos += 8;
+    return value;
+}
+
+void bond_unchecked_read_string_value(BondUncheckedReader *reader, const char **str, uint32_t *len)
+{
+    *len = read_varint32(reader);
+    *str = (const char *)reader->pos;
+    reader->pos += *len;
+}
+
+void bond_unchecked_read_list_begin(BondUncheckedReader *reader, uint8_t *element_type, uint32_t *count)
+{
+    *element_type = *reader->pos++;
+    *count = read_varint32(reader);
+}
+
+void bond_unchecked_read_map_begin(BondUncheckedReader *reader, uint8_t *key_type,
+                                   uint8_t *value_type, uint32_t *count)
+{
+    *key_type = *reader->pos++;
+    *value_type = *reader->pos++;
+    *count = read_varint32(reader);
+}
+
+void bond_unchecked_skip(BondUncheckedReader *reader, uint8_t type)
+{
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+            reader->pos += 1;
+            return;
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_UINT64:
+        case BOND_TYPE_INT16:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_INT64:
+            while (*reader->pos++ & 0x80)
+            {
+            }
+            return;
+
+        case BOND_TYPE_FLOAT:
+            reader->pos += 4;
+            return;
+
+        case BOND_TYPE_DOUBLE:
+            reader->pos += 8;
+            return;
+
+        case BOND_TYPE_STRING:
+            reader->pos += read_varint32(reader);
+            return;
+
+        case BOND_TYPE_WSTRING:
+            reader->pos += (size_t)read_varint32(reader) * 2;
+            return;
+
+        case BOND_TYPE_STRUCT:
+        {
+            uint16_t field_id;
+            uint8_t field_type;
+            while (true)
+            {
+                bond_unchecked_read_field_header(reader, &field_id, &field_type);
+                if (field_type == BOND_TYPE_STOP)
+                {
+                    return;
+                }
+                if (field_type != BOND_TYPE_STOP_BASE)
+                {
+                    bond_unchecked_skip(reader, field_type);
+                }
+            }
+        }
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            uint8_t element_type;
+            uint32_t count;
+            bond_unchecked_read_list_begin(reader, &element_type, &count);
+            size_t width = fixed_value_size(element_type);
+            if (width != 0)
+            {
+                reader->pos += (size_t)count * width;
+                return;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                bond_unchecked_skip(reader, element_type);
+            }
+            return;
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            uint8_t key_type, value_type;
+            uint32_t count;
+            bond_unchecked_read_map_begin(reader, &key_type, &value_type, &count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                bond_unchecked_skip(reader, key_type);
+                bond_unchecked_skip(reader, value_type);
+            }
+            return;
+        }
+
+        default:
+            return;
+    }
+}
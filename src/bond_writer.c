@@ -5,6 +5,9 @@
 
 #include "bond_writer.h"
 #include "bond_encoding.h"
+#include "bond_probes.h"
+#include "bond_stats.h"
+#include "bond_unicode.h"
 #include <string.h>
 
 // ============================================================================
@@ -22,12 +25,16 @@ void bond_writer_init(bond_writer *writer, bond_buffer *buffer)
 
 void bond_writer_struct_begin(bond_writer *writer) 
 {
-    // TODO: Implement (no-op in v1)
+    // v1 structs have no header on the wire; only the end writes a byte
+    BOND_STATS_ENTER();
+    BOND_PROBE1(writer_struct_begin, writer->buffer->size);
 }
 
 void bond_writer_struct_end(bond_writer *writer) 
 {
     bond_buffer_write_byte(writer->buffer, BOND_TYPE_STOP);
+    BOND_STATS_LEAVE();
+    BOND_PROBE1(writer_struct_end, writer->buffer->size);
 }
 
 // ============================================================================
@@ -51,30 +58,37 @@ void bond_writer_struct_end(bond_writer *writer)
  * read 1 byte, check top 3 bits, instantly know how many more to read.
  * Varint is only used for VALUES (uint16/32/64, int16/32/64, lengths, counts).
  */
-void bond_writer_write_field_header(bond_writer *writer, uint16_t field_id, BondDataType type) {
+static size_t encode_field_header(uint8_t *out, uint16_t field_id, BondDataType type)
+{
     if(field_id <= 5)
     {
         // Field ID fits in top 3 bits
-        uint8_t header = (uint8_t)(type | (field_id << 5));
-        bond_buffer_write_byte(writer->buffer, header);
+        out[0] = (uint8_t)(type | (field_id << 5));
+        return 1;
     }
     else if(field_id <= 0xFF)
     {
         // Escape code 6: 1-byte ID follows
-        uint8_t header = (uint8_t)(type | (6 << 5));  // 0xC0 | type
-        bond_buffer_write_byte(writer->buffer, header);
-        bond_buffer_write_byte(writer->buffer, (uint8_t)field_id);
+        out[0] = (uint8_t)(type | (6 << 5));  // 0xC0 | type
+        out[1] = (uint8_t)field_id;
+        return 2;
     }
     else
     {
         // Escape code 7: 2-byte ID follows (little-endian)
-        uint8_t header = (uint8_t)(type | (7 << 5));  // 0xE0 | type
-        bond_buffer_write_byte(writer->buffer, header);
-        bond_buffer_write_byte(writer->buffer, (uint8_t)(field_id & 0xFF));
-        bond_buffer_write_byte(writer->buffer, (uint8_t)(field_id >> 8));
+        out[0] = (uint8_t)(type | (7 << 5));  // 0xE0 | type
+        out[1] = (uint8_t)(field_id & 0xFF);
+        out[2] = (uint8_t)(field_id >> 8);
+        return 3;
     }
 }
 
+void bond_writer_write_field_header(bond_writer *writer, uint16_t field_id, BondDataType type) {
+    uint8_t header[3];
+    size_t len = encode_field_header(header, field_id, type);
+    bond_buffer_write(writer->buffer, header, len);
+}
+
 // ============================================================================
 // Primitive Writers (with field header)
 // ============================================================================
@@ -151,10 +165,39 @@ void bond_writer_write_string(bond_writer *writer, uint16_t field_id, const char
     bond_writer_write_string_value(writer, value);
 }
 
+void bond_writer_write_wstring(bond_writer *writer, uint16_t field_id,
+                               const uint16_t *value, uint32_t length)
+{
+    bond_writer_write_field_header(writer, field_id, BOND_TYPE_WSTRING);
+    bond_writer_write_wstring_value(writer, value, length);
+}
+
+bool bond_writer_write_wstring_utf8(bond_writer *writer, uint16_t field_id,
+                                    const char *value, size_t len)
+{
+    size_t start = writer->buffer->size;
+    bond_writer_write_field_header(writer, field_id, BOND_TYPE_WSTRING);
+    if (!bond_writer_write_wstring_utf8_value(writer, value, len))
+    {
+        writer->buffer->size = start;
+        return false;
+    }
+    return true;
+}
+
 // ============================================================================
 // Container Writers
 // ============================================================================
 
+// Write a string length or container count
+static void write_length(bond_writer *writer, uint32_t value)
+{
+    uint8_t buf[5];  // max 5 bytes for varint32
+    size_t len = bond_encode_varint32(buf, value);
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_LENGTH, len);
+    bond_buffer_write(writer->buffer, buf, len);
+}
+
 /**
  * Write list container header.
  * 
@@ -170,8 +213,86 @@ void bond_writer_write_list_begin(bond_writer *writer, uint16_t field_id,
                                   BondDataType element_type, uint32_t count)
 {
     bond_writer_write_field_header(writer, field_id, BOND_TYPE_LIST);
+    BOND_PROBE4(writer_container_begin, BOND_TYPE_LIST, element_type, count, writer->buffer->size);
     bond_buffer_write_byte(writer->buffer, (uint8_t)element_type);
-    bond_writer_write_uint32_value(writer, count);
+    write_length(writer, count);
+}
+
+// Encode [field_header][element_type][count] into `out` (at most 9 bytes)
+static size_t encode_list_header(uint8_t *out, uint16_t field_id,
+                                 BondDataType element_type, uint32_t count)
+{
+    size_t len = encode_field_header(out, field_id, BOND_TYPE_LIST);
+    out[len++] = (uint8_t)element_type;
+    size_t count_len = bond_encode_varint32(out + len, count);
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_LENGTH, count_len);
+    return len + count_len;
+}
+
+/**
+ * Write a list header and a payload that is already in wire order.
+ *
+ * One reserve, then the header and payload are copied straight into the
+ * buffer. `copy` converts the payload to wire order (NULL = plain memcpy).
+ */
+static void write_list_bulk(bond_writer *writer, uint16_t field_id,
+                            BondDataType element_type, uint32_t count,
+                            const void *data, size_t bytes,
+                            void (*copy)(void *dst, const void *src, size_t count))
+{
+    uint8_t header[9];  // field header (3) + element type (1) + count (5)
+    size_t header_len = encode_list_header(header, field_id, element_type, count);
+
+    BOND_PROBE4(writer_container_begin, BOND_TYPE_LIST, element_type, count, writer->buffer->size);
+    if (bond_buffer_reserve(writer->buffer, header_len + bytes) != 0)
+    {
+        return;
+    }
+    uint8_t *out = writer->buffer->data + writer->buffer->size;
+    memcpy(out, header, header_len);
+    if (copy != NULL)
+    {
+        copy(out + header_len, data, count);
+    }
+    else if (bytes > 0)
+    {
+        memcpy(out + header_len, data, bytes);
+    }
+    writer->buffer->size += header_len + bytes;
+    BOND_STATS_ADD(bytes_written, header_len + bytes);
+}
+
+/**
+ * Write a blob (list<int8>) in one shot.
+ *
+ * Same wire format as a list of int8, but the header and payload go out with
+ * a single reserve and memcpy instead of one call per byte:
+ *   [field_header][BOND_TYPE_INT8: 1][count: varint32][bytes...]
+ */
+void bond_writer_write_blob(bond_writer *writer, uint16_t field_id,
+                            const void *data, uint32_t len)
+{
+    write_list_bulk(writer, field_id, BOND_TYPE_INT8, len, data, len, NULL);
+}
+
+/**
+ * Write list<float> / list<double> from a contiguous array.
+ *
+ * Elements are fixed-width little-endian on the wire, so on little-endian
+ * hosts the whole array is one memcpy.
+ */
+void bond_writer_write_float_list(bond_writer *writer, uint16_t field_id,
+                                  const float *values, uint32_t count)
+{
+    write_list_bulk(writer, field_id, BOND_TYPE_FLOAT, count,
+                    values, (size_t)count * 4, bond_copy_le32);
+}
+
+void bond_writer_write_double_list(bond_writer *writer, uint16_t field_id,
+                                   const double *values, uint32_t count)
+{
+    write_list_bulk(writer, field_id, BOND_TYPE_DOUBLE, count,
+                    values, (size_t)count * 8, bond_copy_le64);
 }
 
 /**
@@ -186,8 +307,9 @@ void bond_writer_write_set_begin(bond_writer *writer, uint16_t field_id,
                                  BondDataType element_type, uint32_t count)
 {
     bond_writer_write_field_header(writer, field_id, BOND_TYPE_SET);
+    BOND_PROBE4(writer_container_begin, BOND_TYPE_SET, element_type, count, writer->buffer->size);
     bond_buffer_write_byte(writer->buffer, (uint8_t)element_type);
-    bond_writer_write_uint32_value(writer, count);
+    write_length(writer, count);
 }
 
 /**
@@ -207,9 +329,99 @@ void bond_writer_write_map_begin(bond_writer *writer, uint16_t field_id,
                                  uint32_t count)
 {
     bond_writer_write_field_header(writer, field_id, BOND_TYPE_MAP);
+    BOND_PROBE4(writer_container_begin, BOND_TYPE_MAP, key_type, count, writer->buffer->size);
     bond_buffer_write_byte(writer->buffer, (uint8_t)key_type);
     bond_buffer_write_byte(writer->buffer, (uint8_t)value_type);
-    bond_writer_write_uint32_value(writer, count);
+    write_length(writer, count);
+}
+
+// ============================================================================
+// Deferred-Count Containers
+// ============================================================================
+
+/**
+ * Reserve a max-width placeholder for a container count.
+ *
+ * Returns the offset of the placeholder, which is also the mark handed back
+ * to the caller.
+ */
+static size_t write_count_placeholder(bond_writer *writer)
+{
+    static const uint8_t placeholder[BOND_DEFERRED_COUNT_SIZE] = {0};
+    size_t mark = writer->buffer->size;
+    bond_buffer_write(writer->buffer, placeholder, sizeof(placeholder));
+    return mark;
+}
+
+/**
+ * Write the real count into a placeholder.
+ *
+ * The placeholder is 5 bytes, enough for any uint32 varint. A shorter count
+ * is written at the mark and the elements are slid down to follow it, which
+ * keeps the encoding canonical:
+ *
+ *   before: [hdr][.....][elements...]
+ *   after:  [hdr][cnt][elements...]
+ */
+static bool patch_count(bond_writer *writer, size_t mark, uint32_t count)
+{
+    bond_buffer *buffer = writer->buffer;
+    if (mark > buffer->size || buffer->size - mark < BOND_DEFERRED_COUNT_SIZE)
+    {
+        return false;
+    }
+
+    uint8_t encoded[BOND_DEFERRED_COUNT_SIZE];
+    size_t len = bond_encode_varint32(encoded, count);
+    size_t payload = mark + BOND_DEFERRED_COUNT_SIZE;
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_LENGTH, len);
+    if (len < BOND_DEFERRED_COUNT_SIZE)
+    {
+        memmove(buffer->data + mark + len, buffer->data + payload, buffer->size - payload);
+        buffer->size -= BOND_DEFERRED_COUNT_SIZE - len;
+        BOND_STATS_SUB(bytes_written, BOND_DEFERRED_COUNT_SIZE - len);
+    }
+    memcpy(buffer->data + mark, encoded, len);
+    return true;
+}
+
+size_t bond_writer_write_list_begin_deferred(bond_writer *writer, uint16_t field_id,
+                                             BondDataType element_type)
+{
+    bond_writer_write_field_header(writer, field_id, BOND_TYPE_LIST);
+    return bond_writer_write_list_value_begin_deferred(writer, element_type);
+}
+
+size_t bond_writer_write_list_value_begin_deferred(bond_writer *writer,
+                                                   BondDataType element_type)
+{
+    bond_buffer_write_byte(writer->buffer, (uint8_t)element_type);
+    return write_count_placeholder(writer);
+}
+
+bool bond_writer_write_list_end(bond_writer *writer, size_t mark, uint32_t count)
+{
+    return patch_count(writer, mark, count);
+}
+
+size_t bond_writer_write_map_begin_deferred(bond_writer *writer, uint16_t field_id,
+                                            BondDataType key_type, BondDataType value_type)
+{
+    bond_writer_write_field_header(writer, field_id, BOND_TYPE_MAP);
+    return bond_writer_write_map_value_begin_deferred(writer, key_type, value_type);
+}
+
+size_t bond_writer_write_map_value_begin_deferred(bond_writer *writer,
+                                                  BondDataType key_type, BondDataType value_type)
+{
+    bond_buffer_write_byte(writer->buffer, (uint8_t)key_type);
+    bond_buffer_write_byte(writer->buffer, (uint8_t)value_type);
+    return write_count_placeholder(writer);
+}
+
+bool bond_writer_write_map_end(bond_writer *writer, size_t mark, uint32_t count)
+{
+    return patch_count(writer, mark, count);
 }
 
 // ============================================================================
@@ -230,6 +442,7 @@ void bond_writer_write_uint16_value(bond_writer *writer, uint16_t value)
 {
     uint8_t buf[3];  // max 3 bytes for varint16
     size_t len = bond_encode_varint16(buf, value);
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_UINT16, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -237,6 +450,7 @@ void bond_writer_write_uint32_value(bond_writer *writer, uint32_t value)
 {
     uint8_t buf[5];  // max 5 bytes for varint32
     size_t len = bond_encode_varint32(buf, value);
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_UINT32, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -244,6 +458,7 @@ void bond_writer_write_uint64_value(bond_writer *writer, uint64_t value)
 {
     uint8_t buf[10];  // max 10 bytes for varint64
     size_t len = bond_encode_varint64(buf, value);
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_UINT64, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -256,6 +471,7 @@ void bond_writer_write_int16_value(bond_writer *writer, int16_t value)
 {
     uint8_t buf[3];  // max 3 bytes for varint16
     size_t len = bond_encode_varint16(buf, bond_zigzag_encode16(value));
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_INT16, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -263,6 +479,7 @@ void bond_writer_write_int32_value(bond_writer *writer, int32_t value)
 {
     uint8_t buf[5];  // max 5 bytes for varint32
     size_t len = bond_encode_varint32(buf, bond_zigzag_encode32(value));
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_INT32, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -270,6 +487,7 @@ void bond_writer_write_int64_value(bond_writer *writer, int64_t value)
 {
     uint8_t buf[10];  // max 10 bytes for varint64
     size_t len = bond_encode_varint64(buf, bond_zigzag_encode64(value));
+    BOND_STATS_VARINT(varint_written, BOND_STATS_VARINT_INT64, len);
     bond_buffer_write(writer->buffer, buf, len);
 }
 
@@ -290,8 +508,67 @@ void bond_writer_write_double_value(bond_writer *writer, double value)
 void bond_writer_write_string_value(bond_writer *writer, const char *value)
 {
     size_t len = strlen(value);
-    uint8_t len_buf[5];  // max 5 bytes for varint32
-    size_t len_len = bond_encode_varint32(len_buf, (uint32_t)len);
-    bond_buffer_write(writer->buffer, len_buf, len_len);
+    write_length(writer, (uint32_t)len);
     bond_buffer_write(writer->buffer, (const uint8_t *)value, len);
 }
+
+/**
+ * Write a wstring value.
+ *
+ * Unlike string, the length prefix counts UTF-16 code units, not bytes:
+ *   [length: varint32][code units: 2 bytes each, little-endian]
+ */
+void bond_writer_write_wstring_value(bond_writer *writer, const uint16_t *value, uint32_t length)
+{
+    write_length(writer, length);
+    size_t bytes = (size_t)length * 2;
+    if (bond_buffer_reserve(writer->buffer, bytes) != 0)
+    {
+        return;
+    }
+    uint8_t *out = writer->buffer->data + writer->buffer->size;
+#ifdef BOND_BIG_ENDIAN
+    for (uint32_t i = 0; i < length; i++)
+    {
+        out[2 * i] = (uint8_t)value[i];
+        out[2 * i + 1] = (uint8_t)(value[i] >> 8);
+    }
+#else
+    if (bytes > 0)
+    {
+        memcpy(out, value, bytes);
+    }
+#endif
+    writer->buffer->size += bytes;
+    BOND_STATS_ADD(bytes_written, bytes);
+}
+
+bool bond_writer_write_wstring_utf8_value(bond_writer *writer, const char *value, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)value;
+    size_t start = writer->buffer->size;
+
+    // Size the output exactly, then transcode in place after the length
+    size_t units = bond_utf8_utf16_length(src, len);
+    if (units > UINT32_MAX)
+    {
+        return false;
+    }
+    write_length(writer, (uint32_t)units);
+    if (bond_buffer_reserve(writer->buffer, units * 2) != 0)
+    {
+        writer->buffer->size = start;
+        return false;
+    }
+
+    size_t written;
+    if (!bond_utf8_to_utf16le(src, len, writer->buffer->data + writer->buffer->size,
+                              units * 2, &written) || written != units)
+    {
+        writer->buffer->size = start;
+        return false;
+    }
+    writer->buffer->size += units * 2;
+    BOND_STATS_ADD(bytes_written, units * 2);
+    return true;
+}
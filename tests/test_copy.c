@@ -0,0 +1,172 @@
+/**
+ * @file test_copy.c
+ * @brief Unit tests for raw passthrough copy
+ */
+
+#include "unity.h"
+#include "bond_copy.h"
+#include "bond_reader.h"
+#include "bond_writer.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Nested payload: { 0: "payload", 1: list<uint64>, 2: map<string, struct> }
+static void write_payload(bond_writer *writer)
+{
+    bond_writer_struct_begin(writer);
+    bond_writer_write_string(writer, 0, "payload");
+    bond_writer_write_list_begin(writer, 1, BOND_TYPE_UINT64, 3);
+    bond_writer_write_uint64_value(writer, 1);
+    bond_writer_write_uint64_value(writer, 1ULL << 40);
+    bond_writer_write_uint64_value(writer, UINT64_MAX);
+    bond_writer_write_map_begin(writer, 2, BOND_TYPE_STRING, BOND_TYPE_STRUCT, 1);
+    bond_writer_write_string_value(writer, "inner");
+    bond_writer_struct_begin(writer);
+    bond_writer_write_int32(writer, 7, -42);
+    bond_writer_struct_end(writer);
+    bond_writer_struct_end(writer);
+}
+
+// Envelope: { 1: uint32 sequence, 2: payload struct }
+static void write_envelope(bond_buffer *buffer, uint32_t sequence, uint16_t payload_id)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_uint32(&writer, 1, sequence);
+    bond_writer_write_field_header(&writer, payload_id, BOND_TYPE_STRUCT);
+    write_payload(&writer);
+    bond_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// Copy Tests
+// ============================================================================
+
+void test_copy_rewrites_envelope(void)
+{
+    bond_buffer in;
+    bond_buffer_init(&in, 128);
+    write_envelope(&in, 1, 2);
+
+    // Proxy: bump the sequence number, move the payload to field 300
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    BondReader reader;
+    bond_reader_init(&reader, &in);
+
+    uint16_t field_id;
+    uint8_t type;
+    bond_writer_struct_begin(&writer);
+    while (bond_reader_read_field_header(&reader, &field_id, &type) && type != BOND_TYPE_STOP)
+    {
+        if (field_id == 1)
+        {
+            uint32_t sequence;
+            TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &sequence));
+            bond_writer_write_uint32(&writer, 1, sequence + 1);
+        }
+        else
+        {
+            TEST_ASSERT_TRUE(bond_copy_field(&reader, &writer, 300, type));
+        }
+    }
+    bond_writer_struct_end(&writer);
+    TEST_ASSERT_EQUAL(in.size, in.read_pos);
+
+    bond_buffer expected;
+    bond_buffer_init(&expected, 128);
+    write_envelope(&expected, 2, 300);
+    TEST_ASSERT_EQUAL(expected.size, out.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, out.data, out.size);
+
+    bond_buffer_destroy(&expected);
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&in);
+}
+
+void test_copy_value_into_container(void)
+{
+    bond_buffer in;
+    bond_buffer_init(&in, 128);
+    bond_writer writer;
+    bond_writer_init(&writer, &in);
+    write_payload(&writer);
+
+    // Copy the same struct twice as list elements
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+    bond_writer_init(&writer, &out);
+    bond_writer_write_list_begin(&writer, 0, BOND_TYPE_STRUCT, 2);
+    BondReader reader;
+    bond_reader_init(&reader, &in);
+    TEST_ASSERT_TRUE(bond_copy_value(&reader, &writer, BOND_TYPE_STRUCT));
+    bond_buffer_rewind(&in);
+    TEST_ASSERT_TRUE(bond_copy_value(&reader, &writer, BOND_TYPE_STRUCT));
+
+    TEST_ASSERT_EQUAL(3 + 2 * in.size, out.size);
+    TEST_ASSERT_EQUAL_MEMORY(in.data, out.data + 3, in.size);
+    TEST_ASSERT_EQUAL_MEMORY(in.data, out.data + 3 + in.size, in.size);
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&in);
+}
+
+void test_copy_truncated_writes_nothing(void)
+{
+    bond_buffer in;
+    bond_buffer_init(&in, 128);
+    write_envelope(&in, 1, 2);
+
+    // Cut the payload short
+    bond_buffer truncated;
+    bond_buffer_init_from(&truncated, in.data, in.size - 4);
+    BondReader reader;
+    bond_reader_init(&reader, &truncated);
+
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+
+    uint16_t field_id;
+    uint8_t type;
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_copy_field(&reader, &writer, field_id, type));
+    size_t size = out.size;
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    size_t pos = truncated.read_pos;
+    TEST_ASSERT_FALSE(bond_copy_field(&reader, &writer, field_id, type));
+    TEST_ASSERT_FALSE(bond_copy_value(&reader, &writer, type));
+    TEST_ASSERT_EQUAL(size, out.size);
+    TEST_ASSERT_EQUAL(pos, truncated.read_pos);
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&in);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_copy_rewrites_envelope);
+    RUN_TEST(test_copy_value_into_container);
+    RUN_TEST(test_copy_truncated_writes_nothing);
+
+    return UNITY_END();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file test_fast.c
+ * @brief Unit tests for the FastBinary writer and reader
+ */
+
+#include "unity.h"
+#include "bond_fast.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void write_sample(bond_buffer *buffer)
+{
+    bond_fast_writer writer;
+    bond_fast_writer_init(&writer, buffer);
+    bond_fast_writer_struct_begin(&writer);
+    bond_fast_writer_write_bool(&writer, 0, true);
+    bond_fast_writer_write_uint8(&writer, 1, 200);
+    bond_fast_writer_write_uint16(&writer, 2, 60000);
+    bond_fast_writer_write_uint32(&writer, 3, 4000000000u);
+    bond_fast_writer_write_uint64(&writer, 4, UINT64_MAX - 1);
+    bond_fast_writer_write_int8(&writer, 5, -100);
+    bond_fast_writer_write_int16(&writer, 6, -30000);
+    bond_fast_writer_write_int32(&writer, 7, -2000000000);
+    bond_fast_writer_write_int64(&writer, 8, INT64_MIN);
+    bond_fast_writer_write_float(&writer, 9, 1.5f);
+    bond_fast_writer_write_double(&writer, 10, -2.25);
+    bond_fast_writer_write_string(&writer, 11, "fast");
+
+    // Derived struct with a base part
+    bond_fast_writer_write_field_header(&writer, 12, BOND_TYPE_STRUCT);
+    bond_fast_writer_write_int32(&writer, 0, 1);
+    bond_fast_writer_base_end(&writer);
+    bond_fast_writer_write_int32(&writer, 0, 2);
+    bond_fast_writer_struct_end(&writer);
+
+    bond_fast_writer_write_list_begin(&writer, 13, BOND_TYPE_UINT32, 3);
+    bond_fast_writer_write_uint32_value(&writer, 1);
+    bond_fast_writer_write_uint32_value(&writer, 2);
+    bond_fast_writer_write_uint32_value(&writer, 3);
+
+    bond_fast_writer_write_map_begin(&writer, 14, BOND_TYPE_STRING, BOND_TYPE_INT64, 1);
+    bond_fast_writer_write_string_value(&writer, "k");
+    bond_fast_writer_write_int64_value(&writer, -1);
+
+    bond_fast_writer_write_map_begin(&writer, 15, BOND_TYPE_INT16, BOND_TYPE_DOUBLE, 2);
+    bond_fast_writer_write_int16_value(&writer, 1);
+    bond_fast_writer_write_double_value(&writer, 1.0);
+    bond_fast_writer_write_int16_value(&writer, 2);
+    bond_fast_writer_write_double_value(&writer, 2.0);
+
+    const uint16_t units[] = { 0x0041, 0x20AC };
+    bond_fast_writer_write_field_header(&writer, 16, BOND_TYPE_WSTRING);
+    bond_fast_writer_write_wstring_value(&writer, units, 2);
+    bond_fast_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// Wire Format Tests
+// ============================================================================
+
+void test_fast_field_header_layout(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    bond_fast_writer writer;
+    bond_fast_writer_init(&writer, &buffer);
+
+    // [type][id_lo][id_hi][value LE], then STOP
+    bond_fast_writer_write_uint32(&writer, 0x1234, 0x01020304);
+    bond_fast_writer_struct_end(&writer);
+
+    const uint8_t expected[] = { BOND_TYPE_UINT32, 0x34, 0x12, 0x04, 0x03, 0x02, 0x01, 0x00 };
+    TEST_ASSERT_EQUAL(sizeof(expected), buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buffer.data, sizeof(expected));
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_fast_integers_are_fixed_width(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    bond_fast_writer writer;
+    bond_fast_writer_init(&writer, &buffer);
+
+    // Small values still take the full width, negatives are not zigzagged
+    bond_fast_writer_write_int64_value(&writer, -1);
+    bond_fast_writer_write_uint16_value(&writer, 1);
+    const uint8_t expected[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00 };
+    TEST_ASSERT_EQUAL(sizeof(expected), buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buffer.data, sizeof(expected));
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Roundtrip Tests
+// ============================================================================
+
+void test_fast_roundtrip(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_sample(&buffer);
+
+    BondFastReader reader;
+    bond_fast_reader_init(&reader, &buffer);
+    uint16_t field_id;
+    uint8_t type;
+
+    bool b;
+    uint8_t u8;
+    uint16_t u16;
+    uint32_t u32;
+    uint64_t u64;
+    int8_t i8;
+    int16_t i16;
+    int32_t i32;
+    int64_t i64;
+    float f;
+    double d;
+    const char *str;
+    uint32_t len;
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(0, field_id);
+    TEST_ASSERT_EQUAL(BOND_TYPE_BOOL, type);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_bool_value(&reader, &b));
+    TEST_ASSERT_TRUE(b);
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_uint8_value(&reader, &u8));
+    TEST_ASSERT_EQUAL(200, u8);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_uint16_value(&reader, &u16));
+    TEST_ASSERT_EQUAL(60000, u16);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_uint32_value(&reader, &u32));
+    TEST_ASSERT_EQUAL_UINT32(4000000000u, u32);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_uint64_value(&reader, &u64));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX - 1, u64);
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_int8_value(&reader, &i8));
+    TEST_ASSERT_EQUAL(-100, i8);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_int16_value(&reader, &i16));
+    TEST_ASSERT_EQUAL(-30000, i16);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_int32_value(&reader, &i32));
+    TEST_ASSERT_EQUAL(-2000000000, i32);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_int64_value(&reader, &i64));
+    TEST_ASSERT_EQUAL_INT64(INT64_MIN, i64);
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_float_value(&reader, &f));
+    TEST_ASSERT_TRUE(f == 1.5f);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_fast_reader_read_double_value(&reader, &d));
+    TEST_ASSERT_TRUE(d == -2.25);
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(11, field_id);
+    TEST_ASSERT_TRUE(bond_fast_reader_read_string_value(&reader, &str, &len));
+    TEST_ASSERT_EQUAL(4, len);
+    TEST_ASSERT_EQUAL_MEMORY("fast", str, 4);
+
+    // Skip the derived struct, the list and both maps
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+        TEST_ASSERT_EQUAL(12 + i, field_id);
+        TEST_ASSERT_TRUE(bond_fast_reader_skip(&reader, type));
+    }
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(BOND_TYPE_WSTRING, type);
+    const uint8_t *units;
+    TEST_ASSERT_TRUE(bond_fast_reader_read_wstring_value(&reader, &units, &len));
+    TEST_ASSERT_EQUAL(2, len);
+    TEST_ASSERT_EQUAL_HEX8(0xAC, units[2]);
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(BOND_TYPE_STOP, type);
+    TEST_ASSERT_EQUAL(buffer.size, buffer.read_pos);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_fast_containers(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_sample(&buffer);
+
+    BondFastReader reader;
+    bond_fast_reader_init(&reader, &buffer);
+    uint16_t field_id;
+    uint8_t type;
+    do
+    {
+        TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+        if (field_id != 13)
+        {
+            TEST_ASSERT_TRUE(bond_fast_reader_skip(&reader, type));
+        }
+    } while (field_id != 13);
+
+    uint8_t element_type;
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_fast_reader_read_list_begin(&reader, &element_type, &count));
+    TEST_ASSERT_EQUAL(BOND_TYPE_UINT32, element_type);
+    TEST_ASSERT_EQUAL(3, count);
+    for (uint32_t i = 1; i <= count; i++)
+    {
+        uint32_t value;
+        TEST_ASSERT_TRUE(bond_fast_reader_read_uint32_value(&reader, &value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+
+    TEST_ASSERT_TRUE(bond_fast_reader_read_field_header(&reader, &field_id, &type));
+    uint8_t key_type;
+    uint8_t value_type;
+    TEST_ASSERT_TRUE(bond_fast_reader_read_map_begin(&reader, &key_type, &value_type, &count));
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRING, key_type);
+    TEST_ASSERT_EQUAL(BOND_TYPE_INT64, value_type);
+    TEST_ASSERT_EQUAL(1, count);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_fast_truncation(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_sample(&buffer);
+
+    BondFastReader reader;
+    for (size_t len = 0; len < buffer.size; len++)
+    {
+        bond_buffer truncated;
+        bond_buffer_init_from(&truncated, buffer.data, len);
+        bond_fast_reader_init(&reader, &truncated);
+        TEST_ASSERT_FALSE(bond_fast_reader_skip(&reader, BOND_TYPE_STRUCT));
+    }
+    bond_fast_reader_init(&reader, &buffer);
+    TEST_ASSERT_TRUE(bond_fast_reader_skip(&reader, BOND_TYPE_STRUCT));
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Wire format
+    RUN_TEST(test_fast_field_header_layout);
+    RUN_TEST(test_fast_integers_are_fixed_width);
+
+    // Roundtrip
+    RUN_TEST(test_fast_roundtrip);
+    RUN_TEST(test_fast_containers);
+    RUN_TEST(test_fast_truncation);
+
+    return UNITY_END();
+}
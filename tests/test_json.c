@@ -0,0 +1,535 @@
+/**
+ * @file test_json.c
+ * @brief Unit tests for CompactBinary <-> SimpleJSON transcoding
+ */
+
+#include "unity.h"
+#include "bond_json.h"
+#include "bond_schema.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Transcode `buffer` and compare with `expected`
+static void assert_json(bond_buffer *buffer, const BondJsonOptions *options, const char *expected)
+{
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+    BondReader reader;
+    bond_buffer_rewind(buffer);
+    bond_reader_init(&reader, buffer);
+    TEST_ASSERT_TRUE(bond_json_from_compact(&reader, options, &out));
+    TEST_ASSERT_EQUAL(buffer->size, buffer->read_pos);
+    TEST_ASSERT_EQUAL(strlen(expected), out.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected, out.data, out.size);
+    bond_buffer_destroy(&out);
+}
+
+static void write_sample(bond_buffer *buffer)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_write_bool(&writer, 0, true);
+    bond_writer_write_uint64(&writer, 1, UINT64_MAX);
+    bond_writer_write_int64(&writer, 2, INT64_MIN);
+    bond_writer_write_int8(&writer, 3, -7);
+    bond_writer_write_string(&writer, 4, "a\"b\\c\n\x01");
+    bond_writer_write_double(&writer, 5, 0.1);
+    bond_writer_write_float(&writer, 6, 0.1f);
+
+    bond_writer_write_list_begin(&writer, 7, BOND_TYPE_UINT16, 3);
+    bond_writer_write_uint16_value(&writer, 0);
+    bond_writer_write_uint16_value(&writer, 99);
+    bond_writer_write_uint16_value(&writer, 65535);
+
+    bond_writer_write_map_begin(&writer, 8, BOND_TYPE_STRING, BOND_TYPE_STRUCT, 1);
+    bond_writer_write_string_value(&writer, "k");
+    bond_writer_write_int32(&writer, 0, -1);
+    bond_writer_struct_end(&writer);
+
+    const uint16_t units[] = { 0x00E9, 0xD83D, 0xDE00 };
+    bond_writer_write_wstring(&writer, 300, units, 3);
+    bond_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// CompactBinary -> JSON Tests
+// ============================================================================
+
+void test_json_field_ids(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_sample(&buffer);
+
+    assert_json(&buffer, NULL,
+        "{\"0\":true,\"1\":18446744073709551615,\"2\":-9223372036854775808,\"3\":-7,"
+        "\"4\":\"a\\\"b\\\\c\\n\\u0001\",\"5\":0.1,\"6\":0.1,\"7\":[0,99,65535],"
+        "\"8\":[\"k\",{\"0\":-1}],\"300\":\"\xC3\xA9\xF0\x9F\x98\x80\"}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_field_names_from_schema(void)
+{
+    static const BondSchemaField inner_fields[] = {
+        { 0, "delta", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+    };
+    static const BondSchemaStruct inner = { "Inner", NULL, inner_fields, 1 };
+    static const BondSchemaType key_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_STRING);
+    static const BondSchemaType value_type = BOND_SCHEMA_STRUCT(&inner);
+    static const BondSchemaField base_fields[] = {
+        { 0, "flag", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_BOOL) },
+    };
+    static const BondSchemaStruct base = { "Base", NULL, base_fields, 1 };
+    static const BondSchemaField fields[] = {
+        { 0, "id", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT32) },
+        { 8, "items", BOND_SCHEMA_MAP(&key_type, &value_type) },
+    };
+    static const BondSchemaStruct derived = { "Derived", &base, fields, 2 };
+
+    // Base section, then derived fields; field 9 is not in the schema
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_bool(&writer, 0, false);
+    bond_buffer_write_byte(&buffer, BOND_TYPE_STOP_BASE);
+    bond_writer_write_uint32(&writer, 0, 42);
+    bond_writer_write_map_begin(&writer, 8, BOND_TYPE_STRING, BOND_TYPE_STRUCT, 1);
+    bond_writer_write_string_value(&writer, "k");
+    bond_writer_write_int32(&writer, 0, 5);
+    bond_writer_struct_end(&writer);
+    bond_writer_write_uint32(&writer, 9, 1);
+    bond_writer_struct_end(&writer);
+
+    BondJsonOptions options = { &derived, NULL, NULL, 0 };
+    assert_json(&buffer, &options,
+        "{\"flag\":false,\"id\":42,\"items\":[\"k\",{\"delta\":5}],\"9\":1}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_double_round_trip(void)
+{
+    static const double values[] = {
+        0.1, 1.0 / 3.0, 2.5, 1e300, 5e-324, 123456789.125, -0.0, 3.0, 1e22,
+        9007199254740993.0, 0.30000000000000004
+    };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+    {
+        bond_buffer buffer;
+        bond_buffer_init(&buffer, 32);
+        bond_writer writer;
+        bond_writer_init(&writer, &buffer);
+        bond_writer_write_double(&writer, 0, values[i]);
+        bond_writer_struct_end(&writer);
+
+        bond_buffer out;
+        bond_buffer_init(&out, 16);
+        BondReader reader;
+        bond_reader_init(&reader, &buffer);
+        TEST_ASSERT_TRUE(bond_json_from_compact(&reader, NULL, &out));
+        bond_buffer_write_byte(&out, 0);
+
+        // Whatever the digits, the number must parse back exactly
+        const char *number = (const char *)out.data + 5;
+        TEST_ASSERT_TRUE(strtod(number, NULL) == values[i]);
+        TEST_ASSERT_EQUAL(signbit(values[i]) != 0, number[0] == '-');
+
+        bond_buffer_destroy(&out);
+        bond_buffer_destroy(&buffer);
+    }
+}
+
+void test_json_shortest_number_text(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 128);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_list_begin(&writer, 0, BOND_TYPE_DOUBLE, 10);
+    bond_writer_write_double_value(&writer, 5e-324);
+    bond_writer_write_double_value(&writer, 1.7976931348623157e308);
+    bond_writer_write_double_value(&writer, 0.30000000000000004);
+    bond_writer_write_double_value(&writer, 1.0 / 3.0);
+    bond_writer_write_double_value(&writer, 1e21);
+    bond_writer_write_double_value(&writer, 1e20);
+    bond_writer_write_double_value(&writer, 1.5e-7);
+    bond_writer_write_double_value(&writer, 0.000001);
+    bond_writer_write_double_value(&writer, -0.0);
+    bond_writer_write_double_value(&writer, 9007199254740993.0);
+    bond_writer_write_list_begin(&writer, 1, BOND_TYPE_FLOAT, 4);
+    bond_writer_write_float_value(&writer, 1e-45f);
+    bond_writer_write_float_value(&writer, 3.4028235e38f);
+    bond_writer_write_float_value(&writer, 1.1f);
+    bond_writer_write_float_value(&writer, 16777216.0f);
+    bond_writer_struct_end(&writer);
+
+    // Fewest digits that read back exactly; exponent form below 1e-6 and from 1e21
+    assert_json(&buffer, NULL,
+        "{\"0\":[5e-324,1.7976931348623157e+308,0.30000000000000004,0.3333333333333333,"
+        "1e+21,100000000000000000000,1.5e-7,0.000001,-0,9007199254740992],"
+        "\"1\":[1e-45,3.4028235e+38,1.1,16777216]}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_non_finite(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 32);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_double(&writer, 0, NAN);
+    bond_writer_write_double(&writer, 1, INFINITY);
+    bond_writer_write_float(&writer, 2, -INFINITY);
+    bond_writer_struct_end(&writer);
+
+    assert_json(&buffer, NULL, "{\"0\":\"NaN\",\"1\":\"Infinity\",\"2\":\"-Infinity\"}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_rejects_invalid_utf8(void)
+{
+    // Truncated sequence, overlong '/', and an encoded surrogate
+    static const char *strings[] = { "ok\xC3", "\xC0\xAF", "\xED\xA0\x80" };
+
+    bond_buffer out;
+    bond_buffer_init(&out, 64);
+    for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); i++)
+    {
+        bond_buffer buffer;
+        bond_buffer_init(&buffer, 32);
+        bond_writer writer;
+        bond_writer_init(&writer, &buffer);
+        bond_writer_write_string(&writer, 0, strings[i]);
+        bond_writer_struct_end(&writer);
+
+        BondReader reader;
+        bond_reader_init(&reader, &buffer);
+        out.size = 0;
+        TEST_ASSERT_FALSE(bond_json_from_compact(&reader, NULL, &out));
+        bond_buffer_destroy(&buffer);
+    }
+
+    // Valid multi-byte text passes through unescaped
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 32);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_string(&writer, 0, "caf\xC3\xA9 \xF0\x9F\x98\x80");
+    bond_writer_struct_end(&writer);
+    assert_json(&buffer, NULL, "{\"0\":\"caf\xC3\xA9 \xF0\x9F\x98\x80\"}");
+
+    bond_buffer_destroy(&buffer);
+    bond_buffer_destroy(&out);
+}
+
+typedef struct {
+    bond_buffer collected;
+    uint32_t calls;
+} sink;
+
+static bool collect(void *ctx, const uint8_t *data, size_t len)
+{
+    sink *s = (sink *)ctx;
+    s->calls++;
+    return bond_buffer_write(&s->collected, data, len) == 0;
+}
+
+void test_json_streaming_sink(void)
+{
+    // A long list so the threshold is crossed many times
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_list_begin(&writer, 0, BOND_TYPE_INT32, 1000);
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        bond_writer_write_int32_value(&writer, i * 1000);
+    }
+    bond_writer_struct_end(&writer);
+
+    bond_buffer whole;
+    bond_buffer_init(&whole, 64);
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    TEST_ASSERT_TRUE(bond_json_from_compact(&reader, NULL, &whole));
+
+    sink s;
+    bond_buffer_init(&s.collected, 64);
+    s.calls = 0;
+    bond_buffer out;
+    bond_buffer_init(&out, 64);
+    BondJsonOptions options = { NULL, collect, &s, 256 };
+    bond_buffer_rewind(&buffer);
+    TEST_ASSERT_TRUE(bond_json_from_compact(&reader, &options, &out));
+
+    TEST_ASSERT_EQUAL(0, out.size);
+    TEST_ASSERT_TRUE(s.calls > 10);
+    TEST_ASSERT_TRUE(out.capacity < 1024);
+    TEST_ASSERT_EQUAL(whole.size, s.collected.size);
+    TEST_ASSERT_EQUAL_MEMORY(whole.data, s.collected.data, whole.size);
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&s.collected);
+    bond_buffer_destroy(&whole);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_rejects_malformed(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_sample(&buffer);
+
+    bond_buffer out;
+    bond_buffer_init(&out, 64);
+    for (size_t len = 0; len < buffer.size; len++)
+    {
+        bond_buffer truncated;
+        bond_buffer_init_from(&truncated, buffer.data, len);
+        BondReader reader;
+        bond_reader_init(&reader, &truncated);
+        out.size = 0;
+        TEST_ASSERT_FALSE(bond_json_from_compact(&reader, NULL, &out));
+    }
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// JSON -> CompactBinary Tests
+// ============================================================================
+
+static const BondSchemaField point_fields[] = {
+    { 0, "x", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+    { 1, "y", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+};
+static const BondSchemaStruct point = { "Point", NULL, point_fields, 2 };
+
+static const BondSchemaType string_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_STRING);
+static const BondSchemaType double_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_DOUBLE);
+static const BondSchemaType point_type = BOND_SCHEMA_STRUCT(&point);
+
+static const BondSchemaField record_base_fields[] = {
+    { 0, "id", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT64) },
+};
+static const BondSchemaStruct record_base = { "RecordBase", NULL, record_base_fields, 1 };
+
+static const BondSchemaField record_fields[] = {
+    { 0, "flag", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_BOOL) },
+    { 1, "small", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT8) },
+    { 2, "big", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT64) },
+    { 3, "name", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_STRING) },
+    { 4, "wide", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_WSTRING) },
+    { 5, "ratio", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_DOUBLE) },
+    { 6, "scale", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_FLOAT) },
+    { 7, "points", BOND_SCHEMA_LIST(&point_type) },
+    { 8, "weights", BOND_SCHEMA_MAP(&string_type, &double_type) },
+    { 300, "origin", BOND_SCHEMA_STRUCT(&point) },
+};
+static const BondSchemaStruct record = { "Record", &record_base, record_fields, 10 };
+
+static bool to_compact(const char *json, bond_buffer *out)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, out);
+    return bond_json_to_compact(json, strlen(json), &record, &writer);
+}
+
+void test_json_to_compact_round_trip(void)
+{
+    // Base field last, extra whitespace, escapes in strings and keys
+    const char *json =
+        " { \"flag\" : true, \"small\": -128, \"big\": -9223372036854775808,\n"
+        "   \"name\": \"tab\\there \\u00e9\\ud83d\\ude00\", \"wide\": \"caf\\u00e9\",\n"
+        "   \"ratio\": 0.1, \"scale\": \"-Infinity\", \"points\": [{\"x\": 1, \"y\": -2}, {}],\n"
+        "   \"weights\": [\"a\", 1.5, \"b\", -2e-3], \"origin\": {\"y\": 7},\n"
+        "   \"i\\u0064\": 18446744073709551615 } ";
+
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    TEST_ASSERT_TRUE(to_compact(json, &buffer));
+
+    BondJsonOptions options = { &record, NULL, NULL, 0 };
+    assert_json(&buffer, &options,
+        "{\"id\":18446744073709551615,\"flag\":true,\"small\":-128,"
+        "\"big\":-9223372036854775808,\"name\":\"tab\\there \xC3\xA9\xF0\x9F\x98\x80\","
+        "\"wide\":\"caf\xC3\xA9\",\"ratio\":0.1,\"scale\":\"-Infinity\","
+        "\"points\":[{\"x\":1,\"y\":-2},{}],\"weights\":[\"a\",1.5,\"b\",-0.002],"
+        "\"origin\":{\"y\":7}}");
+
+    // Our own output parses back to the same bytes
+    bond_buffer json_out;
+    bond_buffer_init(&json_out, 64);
+    BondReader reader;
+    bond_buffer_rewind(&buffer);
+    bond_reader_init(&reader, &buffer);
+    TEST_ASSERT_TRUE(bond_json_from_compact(&reader, &options, &json_out));
+    bond_buffer again;
+    bond_buffer_init(&again, 16);
+    bond_writer writer;
+    bond_writer_init(&writer, &again);
+    TEST_ASSERT_TRUE(bond_json_to_compact((const char *)json_out.data, json_out.size, &record, &writer));
+    TEST_ASSERT_EQUAL(buffer.size, again.size);
+    TEST_ASSERT_EQUAL_MEMORY(buffer.data, again.data, buffer.size);
+
+    bond_buffer_destroy(&again);
+    bond_buffer_destroy(&json_out);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_to_compact_exact_doubles(void)
+{
+    // 0.1 written out to 400 digits (no length cap)
+    char long_token[420] = "0.1";
+    memset(long_token + 3, '0', 400);
+    long_token[403] = '\0';
+
+    char json[1024];
+    int written = snprintf(json, sizeof(json),
+        "{\"weights\": [\"long\", %s"
+        ", \"even\", 9007199254740993"
+        ", \"half\", 1.00000000000000011102230246251565404236316680908203125"
+        ", \"above\", 1.00000000000000011102230246251565404236316680908203125000001"
+        ", \"tiny\", 2.4703282292062328e-324"
+        ", \"huge\", 1e400, \"under\", -1e-400]}",
+        long_token);
+    TEST_ASSERT_TRUE(written > 0 && (size_t)written < sizeof(json));
+
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    TEST_ASSERT_TRUE(to_compact(json, &buffer));
+
+    // Halfway cases round to even; out of range saturates
+    BondJsonOptions options = { &record, NULL, NULL, 0 };
+    assert_json(&buffer, &options,
+        "{\"weights\":[\"long\",0.1,\"even\",9007199254740992,\"half\",1,"
+        "\"above\",1.0000000000000002,\"tiny\",5e-324,\"huge\",\"Infinity\","
+        "\"under\",-0]}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_to_compact_float_rounds_once(void)
+{
+    // Just above 1 + 2^-24, the midpoint between 1 and the next float, but
+    // the nearest double is that midpoint, so rounding through it gives 1
+    static const struct {
+        const char *json;
+        const char *expected;
+    } cases[] = {
+        { "{\"scale\": 1.00000005960464477550}", "{\"scale\":1.0000001}" },
+        { "{\"scale\": 1.000000059604644775390625}", "{\"scale\":1}" },
+        { "{\"scale\": -1.00000017881393432617187500001}", "{\"scale\":-1.0000002}" },
+        { "{\"scale\": 7.0064923216240853546186479165e-46}", "{\"scale\":1e-45}" },
+        { "{\"scale\": 3.40282356779733661637539395458142568448e38}", "{\"scale\":\"Infinity\"}" },
+    };
+
+    BondJsonOptions options = { &record, NULL, NULL, 0 };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        bond_buffer buffer;
+        bond_buffer_init(&buffer, 16);
+        TEST_ASSERT_TRUE(to_compact(cases[i].json, &buffer));
+        assert_json(&buffer, &options, cases[i].expected);
+        bond_buffer_destroy(&buffer);
+    }
+}
+
+void test_json_to_compact_skips_unknown_and_null(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    TEST_ASSERT_TRUE(to_compact(
+        "{\"extra\": {\"deep\": [1, \"x\", null, {\"a\": false}]}, \"name\": null, \"1\": 5}",
+        &buffer));
+
+    BondJsonOptions options = { &record, NULL, NULL, 0 };
+    assert_json(&buffer, &options, "{\"small\":5}");
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_json_to_compact_rejects_bad_input(void)
+{
+    static const char *inputs[] = {
+        "",
+        "[]",
+        "{\"small\": 128}",
+        "{\"small\": -129}",
+        "{\"id\": -1}",
+        "{\"id\": 18446744073709551616}",
+        "{\"small\": 1.5}",
+        "{\"flag\": 1}",
+        "{\"name\": 5}",
+        "{\"name\": \"\\x\"}",
+        "{\"name\": \"\\ud83d\"}",
+        "{\"name\": \"\xC3\"}",
+        "{\"name\": \"a\nb\"}",
+        "{\"ratio\": .5}",
+        "{\"ratio\": 01}",
+        "{\"weights\": [\"a\"]}",
+        "{\"points\": [1]}",
+        "{\"flag\": true,}",
+        "{\"flag\": true} x",
+        "{\"flag\": true",
+    };
+
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        bond_buffer_write_byte(&buffer, 0xAA);
+        TEST_ASSERT_FALSE(to_compact(inputs[i], &buffer));
+        // Rolled back to what was there before
+        TEST_ASSERT_EQUAL(1, buffer.size);
+        buffer.size = 0;
+    }
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // CompactBinary -> JSON
+    RUN_TEST(test_json_field_ids);
+    RUN_TEST(test_json_field_names_from_schema);
+    RUN_TEST(test_json_double_round_trip);
+    RUN_TEST(test_json_shortest_number_text);
+    RUN_TEST(test_json_non_finite);
+    RUN_TEST(test_json_rejects_invalid_utf8);
+    RUN_TEST(test_json_streaming_sink);
+    RUN_TEST(test_json_rejects_malformed);
+
+    // JSON -> CompactBinary
+    RUN_TEST(test_json_to_compact_round_trip);
+    RUN_TEST(test_json_to_compact_exact_doubles);
+    RUN_TEST(test_json_to_compact_float_rounds_once);
+    RUN_TEST(test_json_to_compact_skips_unknown_and_null);
+    RUN_TEST(test_json_to_compact_rejects_bad_input);
+
+    return UNITY_END();
+}
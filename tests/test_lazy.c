@@ -0,0 +1,285 @@
+/**
+ * @file test_lazy.c
+ * @brief Unit tests for the lazy on-demand DOM
+ */
+
+#include "unity.h"
+#include "bond_lazy.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Company { 1: name, 2: Address { 1: street, 2: city, 3: zip },
+//           3: list<string> departments, 4: map<uint32, string> codes }
+static void write_company(bond_buffer *buffer)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_string(&writer, 1, "Contoso");
+
+    bond_writer_write_field_header(&writer, 2, BOND_TYPE_STRUCT);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_string(&writer, 1, "1 Main St");
+    bond_writer_write_string(&writer, 2, "Redmond");
+    bond_writer_write_uint32(&writer, 3, 98052);
+    bond_writer_struct_end(&writer);
+
+    bond_writer_write_list_begin(&writer, 3, BOND_TYPE_STRING, 3);
+    bond_writer_write_string_value(&writer, "Eng");
+    bond_writer_write_string_value(&writer, "Sales");
+    bond_writer_write_string_value(&writer, "Legal");
+
+    bond_writer_write_map_begin(&writer, 300, BOND_TYPE_UINT32, BOND_TYPE_STRING, 2);
+    bond_writer_write_uint32_value(&writer, 7);
+    bond_writer_write_string_value(&writer, "seven");
+    bond_writer_write_uint32_value(&writer, 8);
+    bond_writer_write_string_value(&writer, "eight");
+
+    bond_writer_struct_end(&writer);
+}
+
+static void assert_string_node(BondLazyDoc *doc, BondLazyNode *node, const char *expected)
+{
+    TEST_ASSERT_NOT_NULL(node);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRING, node->type);
+
+    bond_buffer view;
+    BondReader reader;
+    bond_lazy_reader(doc, node, &view, &reader);
+
+    const char *str;
+    uint32_t len;
+    TEST_ASSERT_TRUE(bond_reader_read_string_value(&reader, &str, &len));
+    TEST_ASSERT_EQUAL(strlen(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, str, len);
+}
+
+// ============================================================================
+// Navigation Tests
+// ============================================================================
+
+void test_lazy_nested_field_defers_siblings(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+    BondLazyNode *root = bond_lazy_root(&doc);
+
+    BondLazyNode *hq = bond_lazy_field(&doc, root, 2);
+    TEST_ASSERT_NOT_NULL(hq);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRUCT, hq->type);
+    TEST_ASSERT_FALSE(hq->expanded);
+
+    BondLazyNode *zip = bond_lazy_field(&doc, hq, 3);
+    TEST_ASSERT_NOT_NULL(zip);
+    TEST_ASSERT_TRUE(hq->expanded);
+
+    bond_buffer view;
+    BondReader reader;
+    bond_lazy_reader(&doc, zip, &view, &reader);
+    uint32_t value;
+    TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &value));
+    TEST_ASSERT_EQUAL(98052, value);
+
+    // Untouched containers stay unparsed
+    BondLazyNode *departments = bond_lazy_field(&doc, root, 3);
+    TEST_ASSERT_NOT_NULL(departments);
+    TEST_ASSERT_FALSE(departments->expanded);
+    TEST_ASSERT_NULL(departments->children);
+
+    // Second lookup is served from the cached field table
+    TEST_ASSERT_EQUAL_PTR(hq, bond_lazy_field(&doc, root, 2));
+    TEST_ASSERT_NULL(bond_lazy_field(&doc, root, 42));
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_lazy_cached_end_offsets(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+    BondLazyNode *root = bond_lazy_root(&doc);
+
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_lazy_count(&doc, root, &count));
+    TEST_ASSERT_EQUAL(4, count);
+    TEST_ASSERT_EQUAL(buffer.size, root->end);
+
+    // Siblings tile the struct: each field ends where the next header begins
+    BondLazyNode *hq = bond_lazy_field(&doc, root, 2);
+    BondLazyNode *departments = bond_lazy_field(&doc, root, 3);
+    size_t end;
+    TEST_ASSERT_TRUE(bond_lazy_end(&doc, hq, &end));
+    TEST_ASSERT_EQUAL(departments->offset - 1, end);
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_lazy_list_elements(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+
+    BondLazyNode *departments = bond_lazy_field(&doc, bond_lazy_root(&doc), 3);
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_lazy_count(&doc, departments, &count));
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRING, departments->element_type);
+
+    assert_string_node(&doc, bond_lazy_child(&doc, departments, 0), "Eng");
+    assert_string_node(&doc, bond_lazy_child(&doc, departments, 2), "Legal");
+    TEST_ASSERT_NULL(bond_lazy_child(&doc, departments, 3));
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_lazy_map_pairs(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+
+    BondLazyNode *codes = bond_lazy_field(&doc, bond_lazy_root(&doc), 300);
+    TEST_ASSERT_NOT_NULL(codes);
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_lazy_count(&doc, codes, &count));
+    TEST_ASSERT_EQUAL(2, count);
+
+    BondLazyNode *key = bond_lazy_map_key(&doc, codes, 1);
+    TEST_ASSERT_NOT_NULL(key);
+    bond_buffer view;
+    BondReader reader;
+    bond_lazy_reader(&doc, key, &view, &reader);
+    uint32_t value;
+    TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &value));
+    TEST_ASSERT_EQUAL(8, value);
+
+    assert_string_node(&doc, bond_lazy_map_value(&doc, codes, 1), "eight");
+    TEST_ASSERT_NULL(bond_lazy_child(&doc, codes, 0));
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_lazy_derived_struct_fields(void)
+{
+    // Outer { 1: Derived { base: 1: "Ada" | derived: 2: 36 }, 2: "next" }
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_field_header(&writer, 1, BOND_TYPE_STRUCT);
+    bond_writer_write_string(&writer, 1, "Ada");
+    bond_buffer_write_byte(&buffer, BOND_TYPE_STOP_BASE);
+    bond_writer_write_uint32(&writer, 2, 36);
+    bond_writer_struct_end(&writer);
+    bond_writer_write_string(&writer, 2, "next");
+    bond_writer_struct_end(&writer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+    BondLazyNode *root = bond_lazy_root(&doc);
+    BondLazyNode *derived = bond_lazy_field(&doc, root, 1);
+    TEST_ASSERT_NOT_NULL(derived);
+
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_lazy_count(&doc, derived, &count));
+    TEST_ASSERT_EQUAL_UINT32(2, count);
+    assert_string_node(&doc, bond_lazy_field(&doc, derived, 1), "Ada");
+    TEST_ASSERT_NOT_NULL(bond_lazy_field(&doc, derived, 2));
+
+    // The sibling after the derived struct is found past its final STOP
+    assert_string_node(&doc, bond_lazy_field(&doc, root, 2), "next");
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Error Tests
+// ============================================================================
+
+void test_lazy_truncated_payload(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    // Cut the payload in the middle of the department list
+    bond_buffer truncated;
+    bond_buffer_init_from(&truncated, buffer.data, buffer.size - 20);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &truncated);
+    TEST_ASSERT_NULL(bond_lazy_field(&doc, bond_lazy_root(&doc), 1));
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_lazy_scalar_has_no_children(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_company(&buffer);
+
+    BondLazyDoc doc;
+    bond_lazy_doc_init(&doc, &buffer);
+    BondLazyNode *name = bond_lazy_field(&doc, bond_lazy_root(&doc), 1);
+
+    uint32_t count;
+    TEST_ASSERT_FALSE(bond_lazy_count(&doc, name, &count));
+    TEST_ASSERT_NULL(bond_lazy_field(&doc, name, 1));
+
+    bond_lazy_doc_destroy(&doc);
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Navigation
+    RUN_TEST(test_lazy_nested_field_defers_siblings);
+    RUN_TEST(test_lazy_cached_end_offsets);
+    RUN_TEST(test_lazy_list_elements);
+    RUN_TEST(test_lazy_map_pairs);
+    RUN_TEST(test_lazy_derived_struct_fields);
+
+    // Errors
+    RUN_TEST(test_lazy_truncated_payload);
+    RUN_TEST(test_lazy_scalar_has_no_children);
+
+    return UNITY_END();
+}
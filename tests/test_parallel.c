@@ -0,0 +1,362 @@
+/**
+ * @file test_parallel.c
+ * @brief Unit tests for the thread pool and parallel list writing/decoding
+ */
+
+#include "unity.h"
+#include "bond_parallel.h"
+#include "bond_pool.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ITEM_COUNT 20000
+
+typedef struct {
+    uint32_t id;
+    uint32_t name_len;          // Uneven: 0 .. 999 bytes
+} test_item;
+
+static test_item items[ITEM_COUNT];
+static char name_bytes[1000];
+static bond_thread_pool *pool;
+
+static bool write_item(bond_writer *writer, const void *base, size_t index)
+{
+    const test_item *item = &((const test_item *)base)[index];
+    bond_writer_write_uint32(writer, 0, item->id);
+    bond_writer_write_field_header(writer, 1, BOND_TYPE_STRING);
+    bond_writer_write_uint32_value(writer, item->name_len);
+    bond_buffer_write(writer->buffer, name_bytes, item->name_len);
+    return true;
+}
+
+static size_t fail_at;
+
+static bool write_item_or_fail(bond_writer *writer, const void *base, size_t index)
+{
+    return index != fail_at && write_item(writer, base, index);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static void write_both(uint32_t count, bond_buffer *sequential, bond_buffer *parallel)
+{
+    bond_writer writer;
+    bond_buffer_init(sequential, 64);
+    bond_writer_init(&writer, sequential);
+    bond_writer_write_uint32(&writer, 0, 7);
+    TEST_ASSERT_TRUE(bond_writer_write_struct_list_parallel(&writer, 3, items, count,
+                                                            write_item, NULL));
+    bond_writer_struct_end(&writer);
+
+    bond_buffer_init(parallel, 64);
+    bond_writer_init(&writer, parallel);
+    bond_writer_write_uint32(&writer, 0, 7);
+    TEST_ASSERT_TRUE(bond_writer_write_struct_list_parallel(&writer, 3, items, count,
+                                                            write_item, pool));
+    bond_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// Thread Pool
+// ============================================================================
+
+static void count_worker(void *arg, unsigned worker)
+{
+    atomic_int *calls = (atomic_int *)arg;
+    atomic_fetch_add(&calls[worker], 1);
+}
+
+void test_pool_runs_every_worker_once(void)
+{
+    unsigned size = bond_thread_pool_size(pool);
+    TEST_ASSERT_EQUAL_UINT32(4, size);
+
+    atomic_int calls[4] = {0};
+    for (int run = 0; run < 100; run++)
+    {
+        bond_thread_pool_run(pool, count_worker, calls);
+    }
+    for (unsigned i = 0; i < size; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(100, atomic_load(&calls[i]));
+    }
+}
+
+void test_pool_default_size(void)
+{
+    bond_thread_pool *cpus = bond_thread_pool_create(0);
+    TEST_ASSERT_NOT_NULL(cpus);
+    TEST_ASSERT_TRUE(bond_thread_pool_size(cpus) >= 1);
+    bond_thread_pool_destroy(cpus);
+}
+
+// ============================================================================
+// Parallel Struct List
+// ============================================================================
+
+void test_parallel_matches_sequential(void)
+{
+    bond_buffer sequential;
+    bond_buffer parallel;
+    write_both(ITEM_COUNT, &sequential, &parallel);
+
+    TEST_ASSERT_EQUAL_UINT64(sequential.size, parallel.size);
+    TEST_ASSERT_EQUAL_MEMORY(sequential.data, parallel.data, sequential.size);
+
+    bond_buffer_destroy(&sequential);
+    bond_buffer_destroy(&parallel);
+}
+
+void test_parallel_output_reads_back(void)
+{
+    bond_buffer sequential;
+    bond_buffer parallel;
+    write_both(ITEM_COUNT, &sequential, &parallel);
+
+    BondReader reader;
+    bond_reader_init(&reader, &parallel);
+    uint16_t id;
+    uint8_t type;
+    uint32_t value;
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &value));
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_EQUAL_UINT16(3, id);
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_LIST, type);
+
+    uint8_t element_type;
+    uint32_t count;
+    TEST_ASSERT_TRUE(bond_reader_read_list_begin(&reader, &element_type, &count));
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STRUCT, element_type);
+    TEST_ASSERT_EQUAL_UINT32(ITEM_COUNT, count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+        TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &value));
+        TEST_ASSERT_EQUAL_UINT32(items[i].id, value);
+        TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+        TEST_ASSERT_TRUE(bond_reader_skip(&reader, type));
+        TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+        TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STOP, type);
+    }
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STOP, type);
+    TEST_ASSERT_EQUAL_UINT64(parallel.size, parallel.read_pos);
+
+    bond_buffer_destroy(&sequential);
+    bond_buffer_destroy(&parallel);
+}
+
+void test_short_list_written_in_place(void)
+{
+    bond_buffer sequential;
+    bond_buffer parallel;
+    write_both(10, &sequential, &parallel);
+    TEST_ASSERT_EQUAL_UINT64(sequential.size, parallel.size);
+    TEST_ASSERT_EQUAL_MEMORY(sequential.data, parallel.data, sequential.size);
+    bond_buffer_destroy(&sequential);
+    bond_buffer_destroy(&parallel);
+
+    write_both(0, &sequential, &parallel);
+    TEST_ASSERT_EQUAL_UINT64(sequential.size, parallel.size);
+    TEST_ASSERT_EQUAL_MEMORY(sequential.data, parallel.data, sequential.size);
+    bond_buffer_destroy(&sequential);
+    bond_buffer_destroy(&parallel);
+}
+
+void test_failure_rolls_back(void)
+{
+    bond_buffer buffer;
+    bond_writer writer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_uint32(&writer, 0, 7);
+    size_t size = buffer.size;
+
+    fail_at = ITEM_COUNT / 2;
+    TEST_ASSERT_FALSE(bond_writer_write_struct_list_parallel(&writer, 3, items, ITEM_COUNT,
+                                                             write_item_or_fail, pool));
+    TEST_ASSERT_EQUAL_UINT64(size, buffer.size);
+
+    fail_at = 3;
+    TEST_ASSERT_FALSE(bond_writer_write_struct_list_parallel(&writer, 3, items, 10,
+                                                             write_item_or_fail, pool));
+    TEST_ASSERT_EQUAL_UINT64(size, buffer.size);
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Parallel List Decode
+// ============================================================================
+
+typedef struct {
+    uint32_t ids[ITEM_COUNT];
+    uint32_t name_lens[ITEM_COUNT];
+    atomic_int calls;
+    uint32_t fail_at;               // UINT32_MAX: never
+} decode_ctx;
+
+static bool read_item(BondReader *reader, uint32_t index, void *ctx)
+{
+    decode_ctx *out = (decode_ctx *)ctx;
+    atomic_fetch_add(&out->calls, 1);
+    if (index == out->fail_at)
+    {
+        return false;
+    }
+    uint16_t id;
+    uint8_t type;
+    const char *name;
+    if (!bond_reader_read_field_header(reader, &id, &type) ||
+        !bond_reader_read_uint32_value(reader, &out->ids[index]) ||
+        !bond_reader_read_field_header(reader, &id, &type) ||
+        !bond_reader_read_string_value(reader, &name, &out->name_lens[index]) ||
+        !bond_reader_read_field_header(reader, &id, &type) ||
+        type != BOND_TYPE_STOP)
+    {
+        return false;
+    }
+    // The element reader ends exactly at the element's STOP
+    return bond_buffer_remaining(reader->buffer) == 0;
+}
+
+static void decode_list(bond_buffer *buffer, BondReader *reader, uint32_t *count)
+{
+    uint16_t id;
+    uint8_t type;
+    uint8_t element_type;
+    bond_reader_init(reader, buffer);
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(reader, &id, &type));
+    TEST_ASSERT_TRUE(bond_reader_skip(reader, type));
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(reader, &id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_list_begin(reader, &element_type, count));
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STRUCT, element_type);
+}
+
+void test_parallel_decode_all_elements(void)
+{
+    bond_buffer sequential;
+    bond_buffer parallel;
+    write_both(ITEM_COUNT, &sequential, &parallel);
+    bond_buffer_destroy(&sequential);
+
+    static decode_ctx out;
+    memset(&out, 0, sizeof(out));
+    out.fail_at = UINT32_MAX;
+    BondReader reader;
+    uint32_t count;
+    decode_list(&parallel, &reader, &count);
+    TEST_ASSERT_TRUE(bond_reader_read_list_parallel(&reader, BOND_TYPE_STRUCT, count,
+                                                    read_item, &out, pool));
+    TEST_ASSERT_EQUAL_INT(ITEM_COUNT, atomic_load(&out.calls));
+    for (uint32_t i = 0; i < ITEM_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(items[i].id, out.ids[i]);
+        TEST_ASSERT_EQUAL_UINT32(items[i].name_len, out.name_lens[i]);
+    }
+
+    // Reader is past the list, at the outer STOP
+    uint16_t id;
+    uint8_t type;
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STOP, type);
+
+    bond_buffer_destroy(&parallel);
+}
+
+void test_parallel_decode_failure_keeps_position(void)
+{
+    bond_buffer sequential;
+    bond_buffer parallel;
+    write_both(ITEM_COUNT, &sequential, &parallel);
+    bond_buffer_destroy(&sequential);
+
+    static decode_ctx out;
+    memset(&out, 0, sizeof(out));
+    out.fail_at = 1234;
+    BondReader reader;
+    uint32_t count;
+    decode_list(&parallel, &reader, &count);
+    size_t start = parallel.read_pos;
+    TEST_ASSERT_FALSE(bond_reader_read_list_parallel(&reader, BOND_TYPE_STRUCT, count,
+                                                     read_item, &out, pool));
+    TEST_ASSERT_EQUAL_UINT64(start, parallel.read_pos);
+
+    // Truncated list: the boundary scan fails before any callback
+    memset(&out, 0, sizeof(out));
+    out.fail_at = UINT32_MAX;
+    parallel.size -= 10;
+    TEST_ASSERT_FALSE(bond_reader_read_list_parallel(&reader, BOND_TYPE_STRUCT, count,
+                                                     read_item, &out, pool));
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&out.calls));
+    TEST_ASSERT_EQUAL_UINT64(start, parallel.read_pos);
+
+    bond_buffer_destroy(&parallel);
+}
+
+void test_parallel_decode_rejects_oversized_count(void)
+{
+    // A list header claiming far more elements than there are bytes
+    uint8_t data[] = {0x00, 0x00, 0x00};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    static decode_ctx out;
+    memset(&out, 0, sizeof(out));
+    out.fail_at = UINT32_MAX;
+    TEST_ASSERT_FALSE(bond_reader_read_list_parallel(&reader, BOND_TYPE_STRUCT, UINT32_MAX,
+                                                     read_item, &out, pool));
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&out.calls));
+    TEST_ASSERT_EQUAL_UINT64(0, buffer.read_pos);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    memset(name_bytes, 'n', sizeof(name_bytes));
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < ITEM_COUNT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        items[i].id = i * 7;
+        // Mostly short names with occasional long ones
+        items[i].name_len = (seed >> 16) % 16 == 0 ? (seed >> 8) % 1000 : (seed >> 8) % 16;
+    }
+    pool = bond_thread_pool_create(4);
+
+    UNITY_BEGIN();
+
+    // Thread pool
+    RUN_TEST(test_pool_runs_every_worker_once);
+    RUN_TEST(test_pool_default_size);
+
+    // Parallel struct list
+    RUN_TEST(test_parallel_matches_sequential);
+    RUN_TEST(test_parallel_output_reads_back);
+    RUN_TEST(test_short_list_written_in_place);
+    RUN_TEST(test_failure_rolls_back);
+
+    // Parallel list decode
+    RUN_TEST(test_parallel_decode_all_elements);
+    RUN_TEST(test_parallel_decode_failure_keeps_position);
+    RUN_TEST(test_parallel_decode_rejects_oversized_count);
+
+    int result = UNITY_END();
+    bond_thread_pool_destroy(pool);
+    bond_buffer_pool_trim();
+    return result;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file test_patch.c
+ * @brief Unit tests for in-place field patching
+ */
+
+#include "unity.h"
+#include "bond_patch.h"
+#include "bond_writer.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+typedef struct {
+    uint64_t hits;
+    int32_t delta;
+    double timestamp;
+    const char *name;
+} Session;
+
+static void write_session(bond_buffer *buffer, const Session *session)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_uint64(&writer, 1, session->hits);
+    bond_writer_write_string(&writer, 2, session->name);
+    bond_writer_write_int32(&writer, 3, session->delta);
+    bond_writer_write_list_begin(&writer, 4, BOND_TYPE_UINT8, 2);
+    bond_writer_write_uint8_value(&writer, 9);
+    bond_writer_write_uint8_value(&writer, 8);
+    bond_writer_write_double(&writer, 300, session->timestamp);
+    bond_writer_struct_end(&writer);
+}
+
+// The patched buffer must match a fresh encoding of the new values
+static void assert_encodes(const bond_buffer *buffer, const Session *session)
+{
+    bond_buffer expected;
+    bond_buffer_init(&expected, 64);
+    write_session(&expected, session);
+    TEST_ASSERT_EQUAL(expected.size, buffer->size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, buffer->data, buffer->size);
+    bond_buffer_destroy(&expected);
+}
+
+// ============================================================================
+// Index Tests
+// ============================================================================
+
+void test_index_records_fields(void)
+{
+    Session session = { 5, -1, 1.0, "abc" };
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_session(&buffer, &session);
+
+    BondPatchIndex index;
+    TEST_ASSERT_TRUE(bond_patch_index_build(&index, &buffer));
+    TEST_ASSERT_EQUAL(5, index.count);
+    const BondPatchField *field = bond_patch_index_find(&index, 300);
+    TEST_ASSERT_NOT_NULL(field);
+    TEST_ASSERT_EQUAL(BOND_TYPE_DOUBLE, field->type);
+    TEST_ASSERT_EQUAL(8, field->end - field->offset);
+    TEST_ASSERT_NULL(bond_patch_index_find(&index, 5));
+    bond_patch_index_destroy(&index);
+
+    // Truncated payload
+    bond_buffer truncated;
+    bond_buffer_init_from(&truncated, buffer.data, buffer.size - 1);
+    TEST_ASSERT_FALSE(bond_patch_index_build(&index, &truncated));
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Patch Tests
+// ============================================================================
+
+void test_patch_same_length_in_place(void)
+{
+    Session session = { 100, -5, 1.5, "user" };
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_session(&buffer, &session);
+    size_t size = buffer.size;
+
+    session.hits = 101;
+    session.delta = 7;
+    session.timestamp = 2.75;
+    session.name = "USER";
+    TEST_ASSERT_TRUE(bond_patch_uint(&buffer, NULL, 1, session.hits));
+    TEST_ASSERT_TRUE(bond_patch_int(&buffer, NULL, 3, session.delta));
+    TEST_ASSERT_TRUE(bond_patch_double(&buffer, NULL, 300, session.timestamp));
+    TEST_ASSERT_TRUE(bond_patch_string(&buffer, NULL, 2, session.name, 4));
+    TEST_ASSERT_EQUAL(size, buffer.size);
+    assert_encodes(&buffer, &session);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_patch_resizes_with_index(void)
+{
+    Session session = { 1, 0, 0.5, "a" };
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    write_session(&buffer, &session);
+
+    BondPatchIndex index;
+    TEST_ASSERT_TRUE(bond_patch_index_build(&index, &buffer));
+
+    // Grow the varint, then the string, then shrink both back
+    session.hits = 1ULL << 50;
+    TEST_ASSERT_TRUE(bond_patch_uint(&buffer, &index, 1, session.hits));
+    session.name = "a much longer session name that forces the buffer to grow";
+    TEST_ASSERT_TRUE(bond_patch_string(&buffer, &index, 2, session.name,
+                                       (uint32_t)strlen(session.name)));
+    session.delta = -100000;
+    TEST_ASSERT_TRUE(bond_patch_int(&buffer, &index, 3, session.delta));
+    session.timestamp = 42.0;
+    TEST_ASSERT_TRUE(bond_patch_double(&buffer, &index, 300, session.timestamp));
+    assert_encodes(&buffer, &session);
+
+    session.hits = 2;
+    session.name = "";
+    TEST_ASSERT_TRUE(bond_patch_uint(&buffer, &index, 1, session.hits));
+    TEST_ASSERT_TRUE(bond_patch_string(&buffer, &index, 2, session.name, 0));
+    assert_encodes(&buffer, &session);
+
+    // The index stays in sync with the patched bytes
+    BondPatchIndex fresh;
+    TEST_ASSERT_TRUE(bond_patch_index_build(&fresh, &buffer));
+    TEST_ASSERT_EQUAL(fresh.count, index.count);
+    for (uint32_t i = 0; i < fresh.count; i++)
+    {
+        TEST_ASSERT_EQUAL(fresh.fields[i].field_id, index.fields[i].field_id);
+        TEST_ASSERT_EQUAL(fresh.fields[i].offset, index.fields[i].offset);
+        TEST_ASSERT_EQUAL(fresh.fields[i].end, index.fields[i].end);
+    }
+    bond_patch_index_destroy(&fresh);
+
+    bond_patch_index_destroy(&index);
+    bond_buffer_destroy(&buffer);
+}
+
+static void write_pair(bond_buffer *buffer, const char *first, const char *second)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_write_string(&writer, 1, first);
+    bond_writer_write_string(&writer, 2, second);
+    bond_writer_write_uint32(&writer, 3, 7);
+    bond_writer_struct_end(&writer);
+}
+
+void test_patch_value_aliasing_buffer(void)
+{
+    static const char *first = "abcdefghijklmnopqrstuvwxyz";
+
+    // Exactly full, so growing must reallocate
+    bond_buffer encoded;
+    bond_buffer_init(&encoded, 64);
+    write_pair(&encoded, first, "x");
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, encoded.size);
+    bond_buffer_write(&buffer, encoded.data, encoded.size);
+    bond_buffer_destroy(&encoded);
+
+    BondPatchIndex index;
+    TEST_ASSERT_TRUE(bond_patch_index_build(&index, &buffer));
+    const BondPatchField *field = bond_patch_index_find(&index, 1);
+    TEST_ASSERT_NOT_NULL(field);
+    const char *text = (const char *)buffer.data + field->offset + 1;
+
+    // Copy field 1's zero-copy bytes into field 2: grows and reallocates
+    TEST_ASSERT_TRUE(bond_patch_string(&buffer, &index, 2, text, 26));
+    bond_buffer expected;
+    bond_buffer_init(&expected, 64);
+    write_pair(&expected, first, first);
+    TEST_ASSERT_EQUAL(expected.size, buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, buffer.data, buffer.size);
+
+    // Shrink field 1 to its own tail: the source overlaps the moved bytes
+    field = bond_patch_index_find(&index, 1);
+    text = (const char *)buffer.data + field->offset + 1;
+    TEST_ASSERT_TRUE(bond_patch_string(&buffer, &index, 1, text + 20, 6));
+    expected.size = 0;
+    write_pair(&expected, "uvwxyz", first);
+    TEST_ASSERT_EQUAL(expected.size, buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, buffer.data, buffer.size);
+
+    bond_buffer_destroy(&expected);
+    bond_patch_index_destroy(&index);
+    bond_buffer_destroy(&buffer);
+}
+
+void test_patch_rejects_mismatches(void)
+{
+    Session session = { 1, 0, 0.5, "a" };
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    write_session(&buffer, &session);
+    size_t size = buffer.size;
+
+    TEST_ASSERT_FALSE(bond_patch_uint(&buffer, NULL, 99, 1));     // Absent
+    TEST_ASSERT_FALSE(bond_patch_uint(&buffer, NULL, 3, 1));      // int32 field
+    TEST_ASSERT_FALSE(bond_patch_int(&buffer, NULL, 3, 1LL << 40)); // Out of range
+    TEST_ASSERT_FALSE(bond_patch_double(&buffer, NULL, 2, 1.0));  // string field
+    TEST_ASSERT_FALSE(bond_patch_string(&buffer, NULL, 1, "x", 1));
+    TEST_ASSERT_EQUAL(size, buffer.size);
+    assert_encodes(&buffer, &session);
+
+    // Wrapped memory can be patched in place but never grown
+    bond_buffer wrapped;
+    bond_buffer_init_from(&wrapped, buffer.data, buffer.size);
+    TEST_ASSERT_TRUE(bond_patch_uint(&wrapped, NULL, 1, 2));
+    TEST_ASSERT_FALSE(bond_patch_uint(&wrapped, NULL, 1, 1ULL << 40));
+    TEST_ASSERT_EQUAL(size, wrapped.size);
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Index
+    RUN_TEST(test_index_records_fields);
+
+    // Patching
+    RUN_TEST(test_patch_same_length_in_place);
+    RUN_TEST(test_patch_resizes_with_index);
+    RUN_TEST(test_patch_value_aliasing_buffer);
+    RUN_TEST(test_patch_rejects_mismatches);
+
+    return UNITY_END();
+}
@@ -0,0 +1,337 @@
+/**
+ * @file test_pool.c
+ * @brief Unit tests for the thread-local buffer pool
+ */
+
+#include "unity.h"
+#include "bond_pool.h"
+#include "bond_buffer.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRESS_THREADS 4
+#define STRESS_BUFFERS 256        // Per releasing thread
+#define STRESS_ROUNDS 20
+
+void setUp(void)
+{
+    bond_buffer_pool_set_limit(BOND_POOL_DEFAULT_LIMIT);
+}
+
+void tearDown(void)
+{
+    bond_buffer_pool_trim();
+}
+
+// ============================================================================
+// Acquire / Release
+// ============================================================================
+
+void test_acquire_rounds_to_class(void)
+{
+    bond_buffer buf;
+    TEST_ASSERT_EQUAL_INT(0, bond_buffer_acquire(&buf, 0));
+    TEST_ASSERT_EQUAL_UINT64(BOND_POOL_MIN_CAPACITY, buf.capacity);
+    TEST_ASSERT_EQUAL_UINT64(0, buf.size);
+    TEST_ASSERT_TRUE(buf.owns_memory);
+    bond_buffer_destroy(&buf);
+
+    TEST_ASSERT_EQUAL_INT(0, bond_buffer_acquire(&buf, 1000));
+    TEST_ASSERT_EQUAL_UINT64(1024, buf.capacity);
+    bond_buffer_destroy(&buf);
+}
+
+void test_release_then_acquire_reuses_memory(void)
+{
+    bond_buffer buf;
+    bond_buffer_acquire(&buf, 500);
+    bond_buffer_write(&buf, "abc", 3);
+    uint8_t *data = buf.data;
+
+    bond_buffer_release(&buf);
+    TEST_ASSERT_NULL(buf.data);
+    TEST_ASSERT_EQUAL_UINT64(512, bond_buffer_pool_retained());
+
+    bond_buffer_acquire(&buf, 300);
+    TEST_ASSERT_EQUAL_PTR(data, buf.data);
+    TEST_ASSERT_EQUAL_UINT64(512, buf.capacity);
+    TEST_ASSERT_EQUAL_UINT64(0, buf.size);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+    bond_buffer_release(&buf);
+}
+
+void test_grown_buffer_filed_under_floor_class(void)
+{
+    bond_buffer buf;
+    bond_buffer_init(&buf, 3000);                       // Not from the pool
+    uint8_t *data = buf.data;
+    bond_buffer_release(&buf);
+    TEST_ASSERT_EQUAL_UINT64(3000, bond_buffer_pool_retained());
+
+    // Class 4096 has nothing cached; class 2048 holds the 3000-byte block
+    bond_buffer_acquire(&buf, 2049);
+    TEST_ASSERT_TRUE(data != buf.data);
+    TEST_ASSERT_EQUAL_UINT64(4096, buf.capacity);
+    bond_buffer_destroy(&buf);
+
+    bond_buffer_acquire(&buf, 2048);
+    TEST_ASSERT_EQUAL_PTR(data, buf.data);
+    TEST_ASSERT_EQUAL_UINT64(3000, buf.capacity);
+    bond_buffer_release(&buf);
+}
+
+void test_unpooled_buffers_are_freed(void)
+{
+    uint8_t bytes[512] = {0};
+    bond_buffer buf;
+
+    bond_buffer_init_from(&buf, bytes, sizeof(bytes));  // Not owned
+    bond_buffer_release(&buf);
+    TEST_ASSERT_NULL(buf.data);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+
+    bond_buffer_init(&buf, 16);                         // Below smallest class
+    bond_buffer_release(&buf);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+
+    TEST_ASSERT_EQUAL_INT(0, bond_buffer_acquire(&buf, BOND_POOL_MAX_CAPACITY + 1));
+    TEST_ASSERT_EQUAL_UINT64(BOND_POOL_MAX_CAPACITY + 1, buf.capacity);
+    bond_buffer_release(&buf);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+}
+
+// ============================================================================
+// Retention Limit
+// ============================================================================
+
+void test_limit_caps_retained_bytes(void)
+{
+    bond_buffer_pool_set_limit(1024);
+    bond_buffer a;
+    bond_buffer b;
+    bond_buffer c;
+    bond_buffer_acquire(&a, 512);
+    bond_buffer_acquire(&b, 512);
+    bond_buffer_acquire(&c, 512);
+
+    bond_buffer_release(&a);
+    bond_buffer_release(&b);
+    bond_buffer_release(&c);                            // Over the limit: freed
+    TEST_ASSERT_EQUAL_UINT64(1024, bond_buffer_pool_retained());
+}
+
+void test_zero_limit_disables_pooling(void)
+{
+    bond_buffer_pool_set_limit(0);
+    bond_buffer buf;
+    bond_buffer_acquire(&buf, 256);
+    bond_buffer_release(&buf);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+}
+
+void test_trim_empties_pool(void)
+{
+    bond_buffer buf;
+    for (size_t hint = 256; hint <= 65536; hint *= 2)
+    {
+        bond_buffer_acquire(&buf, hint);
+        bond_buffer_release(&buf);
+    }
+    TEST_ASSERT_TRUE(bond_buffer_pool_retained() > 0);
+    bond_buffer_pool_trim();
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());
+}
+
+// ============================================================================
+// Call-Site Learning
+// ============================================================================
+
+void test_site_learns_growth(void)
+{
+    static bond_buffer_site site;
+    uint8_t payload[5000];
+    memset(payload, 0x5a, sizeof(payload));
+
+    bond_buffer buf;
+    bond_buffer_acquire_at(&buf, &site);
+    TEST_ASSERT_EQUAL_UINT64(BOND_POOL_MIN_CAPACITY, buf.capacity);
+    bond_buffer_write(&buf, payload, sizeof(payload));
+    bond_buffer_release_at(&buf, &site);
+    TEST_ASSERT_EQUAL_UINT64(5000, site.typical);
+
+    bond_buffer_acquire_at(&buf, &site);
+    TEST_ASSERT_TRUE(buf.capacity >= 5000);
+    bond_buffer_release_at(&buf, &site);                // Empty: decays
+    TEST_ASSERT_EQUAL_UINT64(5000 - 5000 / 8, site.typical);
+}
+
+void test_site_decay_stops_at_used_size(void)
+{
+    bond_buffer_site site = { 1000 };
+    uint8_t payload[950] = {0};
+
+    bond_buffer buf;
+    bond_buffer_acquire_at(&buf, &site);
+    bond_buffer_write(&buf, payload, sizeof(payload));
+    bond_buffer_release_at(&buf, &site);
+    TEST_ASSERT_EQUAL_UINT64(950, site.typical);
+}
+
+// ============================================================================
+// Cross-Thread Release
+// ============================================================================
+
+typedef struct {
+    bond_buffer *buffers;
+    size_t count;
+    bond_buffer_pool *owner;
+    atomic_int *start;
+} releaser_args;
+
+static void *releaser(void *arg)
+{
+    releaser_args *args = (releaser_args *)arg;
+    while (args->start != NULL && atomic_load(args->start) == 0)
+    {
+        sched_yield();          // Line up with the other releasers
+    }
+    for (size_t i = 0; i < args->count; i++)
+    {
+        bond_buffer_release_to(&args->buffers[i], args->owner);
+    }
+    return NULL;
+}
+
+void test_release_to_own_pool_is_local(void)
+{
+    bond_buffer buf;
+    bond_buffer_acquire(&buf, 256);
+    bond_buffer_release_to(&buf, bond_buffer_pool_current());
+    TEST_ASSERT_EQUAL_UINT64(256, bond_buffer_pool_retained());
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_collect());
+}
+
+void test_release_to_returns_to_owner(void)
+{
+    bond_buffer buf;
+    bond_buffer_acquire(&buf, 1000);
+    uint8_t *data = buf.data;
+
+    releaser_args args = { &buf, 1, bond_buffer_pool_current(), NULL };
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, releaser, &args));
+    pthread_join(thread, NULL);
+    TEST_ASSERT_NULL(buf.data);
+    TEST_ASSERT_EQUAL_UINT64(0, bond_buffer_pool_retained());      // Still in inbox
+
+    bond_buffer_acquire(&buf, 1000);                                // Miss collects
+    TEST_ASSERT_EQUAL_PTR(data, buf.data);
+    TEST_ASSERT_EQUAL_UINT64(1024, buf.capacity);
+    bond_buffer_release(&buf);
+}
+
+void test_release_to_limit_applied_on_collect(void)
+{
+    bond_buffer buffers[3];
+    for (int i = 0; i < 3; i++)
+    {
+        bond_buffer_acquire(&buffers[i], 512);
+    }
+
+    releaser_args args = { buffers, 3, bond_buffer_pool_current(), NULL };
+    pthread_t thread;
+    pthread_create(&thread, NULL, releaser, &args);
+    pthread_join(thread, NULL);
+
+    bond_buffer_pool_set_limit(1024);
+    TEST_ASSERT_EQUAL_UINT64(3, bond_buffer_pool_collect());
+    TEST_ASSERT_EQUAL_UINT64(1024, bond_buffer_pool_retained());
+}
+
+void test_release_to_stress(void)
+{
+    static bond_buffer buffers[STRESS_THREADS][STRESS_BUFFERS];
+    bond_buffer_pool_set_limit(64 * 1024 * 1024);
+
+    for (int round = 0; round < STRESS_ROUNDS; round++)
+    {
+        size_t expected_bytes = 0;
+        for (int t = 0; t < STRESS_THREADS; t++)
+        {
+            for (size_t i = 0; i < STRESS_BUFFERS; i++)
+            {
+                size_t hint = (size_t)256 << ((t + i) % 5);
+                TEST_ASSERT_EQUAL_INT(0, bond_buffer_acquire(&buffers[t][i], hint));
+                expected_bytes += buffers[t][i].capacity;
+            }
+        }
+        size_t before = bond_buffer_pool_retained();
+
+        atomic_int start = 0;
+        releaser_args args[STRESS_THREADS];
+        pthread_t threads[STRESS_THREADS];
+        for (int t = 0; t < STRESS_THREADS; t++)
+        {
+            args[t] = (releaser_args){ buffers[t], STRESS_BUFFERS,
+                                       bond_buffer_pool_current(), &start };
+            TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[t], NULL, releaser, &args[t]));
+        }
+        atomic_store(&start, 1);
+
+        // Drain and churn the pool while the releasers push
+        size_t collected = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            collected += bond_buffer_pool_collect();
+            bond_buffer buf;
+            bond_buffer_acquire(&buf, 256);
+            bond_buffer_release(&buf);
+        }
+        for (int t = 0; t < STRESS_THREADS; t++)
+        {
+            pthread_join(threads[t], NULL);
+        }
+        collected += bond_buffer_pool_collect();
+
+        // The churn buffer may have been a fresh 256-byte allocation
+        size_t after = bond_buffer_pool_retained();
+        TEST_ASSERT_EQUAL_UINT64(STRESS_THREADS * STRESS_BUFFERS, collected);
+        TEST_ASSERT_TRUE(after == before + expected_bytes ||
+                         after == before + expected_bytes + 256);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Acquire / release
+    RUN_TEST(test_acquire_rounds_to_class);
+    RUN_TEST(test_release_then_acquire_reuses_memory);
+    RUN_TEST(test_grown_buffer_filed_under_floor_class);
+    RUN_TEST(test_unpooled_buffers_are_freed);
+
+    // Retention limit
+    RUN_TEST(test_limit_caps_retained_bytes);
+    RUN_TEST(test_zero_limit_disables_pooling);
+    RUN_TEST(test_trim_empties_pool);
+
+    // Call-site learning
+    RUN_TEST(test_site_learns_growth);
+    RUN_TEST(test_site_decay_stops_at_used_size);
+
+    // Cross-thread release
+    RUN_TEST(test_release_to_own_pool_is_local);
+    RUN_TEST(test_release_to_returns_to_owner);
+    RUN_TEST(test_release_to_limit_applied_on_collect);
+    RUN_TEST(test_release_to_stress);
+
+    return UNITY_END();
+}
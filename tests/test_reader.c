@@ -667,6 +667,35 @@ void test_skip_string(void)
     TEST_ASSERT_EQUAL(0x42, bond_buffer_read_byte(reader.buffer));
 }
 
+void test_skip_wstring(void)
+{
+    // Length 2 code units, "hi" in UTF-16LE (4 bytes), then 0x42
+    uint8_t data[] = {0x02, 'h', 0x00, 'i', 0x00, 0x42};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    
+    TEST_ASSERT_TRUE(bond_reader_skip(&reader, BOND_TYPE_WSTRING));
+    TEST_ASSERT_EQUAL(0x42, bond_buffer_read_byte(reader.buffer));
+}
+
+void test_read_wstring_value_truncated(void)
+{
+    // Length 2 code units but only 3 bytes follow
+    uint8_t data[] = {0x02, 'h', 0x00, 'i'};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    
+    const uint8_t *units;
+    uint32_t length;
+    TEST_ASSERT_FALSE(bond_reader_read_wstring_value(&reader, &units, &length));
+}
+
 void test_skip_list(void)
 {
     // List of 3 uint8: element_type=UINT8(3), count=3, values 0x01,0x02,0x03, then 0x42
@@ -733,6 +762,20 @@ void test_skip_nested_struct(void)
     TEST_ASSERT_EQUAL(0x88, bond_buffer_read_byte(reader.buffer));
 }
 
+void test_skip_derived_struct(void)
+{
+    // Derived struct: base {1: bool true} STOP_BASE, {2: uint8 42} STOP, then 0x99
+    uint8_t data[] = {0x22, 0x01, BOND_TYPE_STOP_BASE, 0x43, 0x2A, 0x00, 0x99};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    TEST_ASSERT_TRUE(bond_reader_skip(&reader, BOND_TYPE_STRUCT));
+    TEST_ASSERT_EQUAL(0x99, bond_buffer_read_byte(reader.buffer));
+}
+
 void test_skip_unknown_type(void)
 {
     uint8_t data[] = {0x01};
@@ -746,6 +789,115 @@ void test_skip_unknown_type(void)
     TEST_ASSERT_FALSE(bond_reader_skip(&reader, 127));
 }
 
+// ============================================================================
+// List Element Offsets Tests
+// ============================================================================
+
+void test_list_offsets_fixed_width(void)
+{
+    // 3 doubles, then 0x42
+    uint8_t data[25] = {0};
+    data[24] = 0x42;
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    size_t offsets[4];
+    TEST_ASSERT_TRUE(bond_reader_list_offsets(&reader, BOND_TYPE_DOUBLE, 3, offsets));
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(8, offsets[1]);
+    TEST_ASSERT_EQUAL(24, offsets[3]);
+    TEST_ASSERT_EQUAL(0x42, bond_buffer_read_byte(reader.buffer));
+
+    bond_buffer_rewind(&buffer);
+    size_t too_many[5];
+    TEST_ASSERT_FALSE(bond_reader_list_offsets(&reader, BOND_TYPE_DOUBLE, 4, too_many));
+    TEST_ASSERT_EQUAL(0, buffer.read_pos);
+}
+
+void test_list_offsets_strings(void)
+{
+    // "ab", "", 130-byte string (2-byte length), then 0x42
+    uint8_t data[3 + 1 + 2 + 130 + 1] = {0x02, 'a', 'b', 0x00, 0x82, 0x01};
+    data[sizeof(data) - 1] = 0x42;
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    size_t offsets[4];
+    TEST_ASSERT_TRUE(bond_reader_list_offsets(&reader, BOND_TYPE_STRING, 3, offsets));
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(3, offsets[1]);
+    TEST_ASSERT_EQUAL(4, offsets[2]);
+    TEST_ASSERT_EQUAL(136, offsets[3]);
+    TEST_ASSERT_EQUAL(0x42, bond_buffer_read_byte(reader.buffer));
+
+    // Last string truncated
+    bond_buffer_init_from(&buffer, data, 100);
+    TEST_ASSERT_FALSE(bond_reader_list_offsets(&reader, BOND_TYPE_STRING, 3, offsets));
+    TEST_ASSERT_EQUAL(0, buffer.read_pos);
+}
+
+void test_list_offsets_string_length_overflow(void)
+{
+    // Length varint whose 5th byte sets bits above 2^32
+    uint8_t data[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x10, 'x'};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    size_t offsets[2];
+    TEST_ASSERT_FALSE(bond_reader_list_offsets(&reader, BOND_TYPE_STRING, 1, offsets));
+    TEST_ASSERT_EQUAL(0, buffer.read_pos);
+}
+
+void test_list_offsets_structs(void)
+{
+    // {1: bool true}, {}, {2: uint8 42}, then 0x99
+    uint8_t data[] = {0x22, 0x01, 0x00, 0x00, 0x43, 0x2A, 0x00, 0x99};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    size_t offsets[4];
+    TEST_ASSERT_TRUE(bond_reader_list_offsets(&reader, BOND_TYPE_STRUCT, 3, offsets));
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(3, offsets[1]);
+    TEST_ASSERT_EQUAL(4, offsets[2]);
+    TEST_ASSERT_EQUAL(7, offsets[3]);
+    TEST_ASSERT_EQUAL(0x99, bond_buffer_read_byte(reader.buffer));
+
+    // Missing STOP in the last struct
+    bond_buffer_init_from(&buffer, data, 6);
+    TEST_ASSERT_FALSE(bond_reader_list_offsets(&reader, BOND_TYPE_STRUCT, 3, offsets));
+    TEST_ASSERT_EQUAL(0, buffer.read_pos);
+}
+
+void test_list_offsets_derived_structs(void)
+{
+    // Two derived elements {base 1: uint8 1 | 2: uint8 2}, then 0x99
+    uint8_t data[] = {
+        0x23, 0x01, BOND_TYPE_STOP_BASE, 0x43, 0x02, BOND_TYPE_STOP,
+        0x23, 0x03, BOND_TYPE_STOP_BASE, 0x43, 0x04, BOND_TYPE_STOP,
+        0x99
+    };
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+
+    size_t offsets[3];
+    TEST_ASSERT_TRUE(bond_reader_list_offsets(&reader, BOND_TYPE_STRUCT, 2, offsets));
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(6, offsets[1]);
+    TEST_ASSERT_EQUAL(12, offsets[2]);
+    TEST_ASSERT_EQUAL(0x99, bond_buffer_read_byte(reader.buffer));
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -814,11 +966,21 @@ int main(void)
     RUN_TEST(test_skip_float);
     RUN_TEST(test_skip_double);
     RUN_TEST(test_skip_string);
+    RUN_TEST(test_skip_wstring);
+    RUN_TEST(test_read_wstring_value_truncated);
     RUN_TEST(test_skip_list);
     RUN_TEST(test_skip_map);
     RUN_TEST(test_skip_struct);
     RUN_TEST(test_skip_nested_struct);
+    RUN_TEST(test_skip_derived_struct);
     RUN_TEST(test_skip_unknown_type);
+
+    // List element offsets
+    RUN_TEST(test_list_offsets_fixed_width);
+    RUN_TEST(test_list_offsets_strings);
+    RUN_TEST(test_list_offsets_string_length_overflow);
+    RUN_TEST(test_list_offsets_structs);
+    RUN_TEST(test_list_offsets_derived_structs);
     
     return UNITY_END();
 }
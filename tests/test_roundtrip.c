@@ -8,6 +8,7 @@
 #include "bond_reader.h"
 #include "bond_buffer.h"
 #include "bond_types.h"
+#include "bond_unicode.h"
 #include <string.h>
 #include <math.h>
 
@@ -261,6 +262,71 @@ void test_roundtrip_string(void)
     bond_reader_struct_end(&reader);
 }
 
+void test_roundtrip_wstring(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    
+    // Write: "Hi €" from UTF-16 units, and "caf\u00e9 \U0001F600" from UTF-8
+    const uint16_t units[] = {'H', 'i', ' ', 0x20AC};
+    const char *utf8 = "caf\xC3\xA9 \xF0\x9F\x98\x80";
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_wstring(&writer, 1, units, 4);
+    TEST_ASSERT_TRUE(bond_writer_write_wstring_utf8(&writer, 2, utf8, strlen(utf8)));
+    TEST_ASSERT_FALSE(bond_writer_write_wstring_utf8(&writer, 3, "bad\xC3", 4));
+    bond_writer_write_uint32(&writer, 4, 77);
+    bond_writer_struct_end(&writer);
+    
+    // Reset for reading
+    buffer.read_pos = 0;
+    
+    // Read
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    bond_reader_struct_begin(&reader);
+    
+    uint16_t field_id;
+    uint8_t type;
+    const uint8_t *data;
+    uint32_t length;
+    
+    // UTF-16 view
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(1, field_id);
+    TEST_ASSERT_EQUAL(BOND_TYPE_WSTRING, type);
+    TEST_ASSERT_TRUE(bond_reader_read_wstring_value(&reader, &data, &length));
+    TEST_ASSERT_EQUAL(4, length);
+    const uint8_t expected[] = {'H', 0, 'i', 0, ' ', 0, 0xAC, 0x20};
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, data, sizeof(expected));
+    
+    // Transcoded back to UTF-8 (surrogate pair for U+1F600)
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(2, field_id);
+    TEST_ASSERT_TRUE(bond_reader_read_wstring_value(&reader, &data, &length));
+    TEST_ASSERT_EQUAL(7, length);
+    uint8_t out[32];
+    size_t written;
+    TEST_ASSERT_TRUE(bond_utf16le_to_utf8(data, length, out, sizeof(out), &written));
+    TEST_ASSERT_EQUAL(strlen(utf8), written);
+    TEST_ASSERT_EQUAL_MEMORY(utf8, out, written);
+    
+    // Rejected field 3 left nothing behind
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(4, field_id);
+    uint32_t value;
+    TEST_ASSERT_TRUE(bond_reader_read_uint32_value(&reader, &value));
+    TEST_ASSERT_EQUAL(77, value);
+    
+    // STOP
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(BOND_TYPE_STOP, type);
+    
+    bond_reader_struct_end(&reader);
+    bond_buffer_destroy(&buffer);
+}
+
 // ============================================================================
 // Container Roundtrip Tests
 // ============================================================================
@@ -318,6 +384,212 @@ void test_roundtrip_list(void)
     bond_reader_struct_end(&reader);
 }
 
+void test_roundtrip_blob(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+
+    const uint8_t payload[] = {0x00, 0xFF, 0x7F, 0x80, 'b', 'o', 'n', 'd'};
+
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_blob(&writer, 1, payload, sizeof(payload));
+    // list<uint8> is read through the same path
+    bond_writer_write_list_begin(&writer, 2, BOND_TYPE_UINT8, 2);
+    bond_writer_write_uint8_value(&writer, 7);
+    bond_writer_write_uint8_value(&writer, 8);
+    // Anything else is not a blob
+    bond_writer_write_list_begin(&writer, 3, BOND_TYPE_UINT32, 1);
+    bond_writer_write_uint32_value(&writer, 1);
+    bond_writer_struct_end(&writer);
+
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    bond_reader_struct_begin(&reader);
+
+    uint16_t field_id;
+    uint8_t type;
+    const uint8_t *data;
+    uint32_t len;
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(BOND_TYPE_LIST, type);
+    TEST_ASSERT_TRUE(bond_reader_read_blob(&reader, &data, &len));
+    TEST_ASSERT_EQUAL(sizeof(payload), len);
+    TEST_ASSERT_EQUAL_MEMORY(payload, data, len);
+    // Zero-copy: points into the buffer
+    TEST_ASSERT_TRUE(data > buffer.data && data < buffer.data + buffer.size);
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_blob(&reader, &data, &len));
+    TEST_ASSERT_EQUAL(2, len);
+    TEST_ASSERT_EQUAL(7, data[0]);
+    TEST_ASSERT_EQUAL(8, data[1]);
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_FALSE(bond_reader_read_blob(&reader, &data, &len));
+
+    // Truncated payload
+    bond_buffer truncated;
+    bond_buffer_init_from(&truncated, buffer.data, 6);
+    bond_reader_init(&reader, &truncated);
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_FALSE(bond_reader_read_blob(&reader, &data, &len));
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_roundtrip_float_double_list(void)
+{
+    enum { DIM = 4096 };
+    static float floats[DIM];
+    static double doubles[DIM];
+    static float floats_out[DIM];
+    static double doubles_out[DIM];
+    for (int i = 0; i < DIM; i++)
+    {
+        floats[i] = (float)i * 0.5f - 1000.0f;
+        doubles[i] = (double)i / 3.0;
+    }
+
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_float_list(&writer, 1, floats, DIM);
+    bond_writer_write_double_list(&writer, 2, doubles, DIM);
+    bond_writer_write_float_list(&writer, 3, NULL, 0);
+    bond_writer_struct_end(&writer);
+
+    // Same bytes as the element-by-element writer
+    bond_buffer expected;
+    bond_buffer_init(&expected, 64);
+    bond_writer_init(&writer, &expected);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_list_begin(&writer, 1, BOND_TYPE_FLOAT, DIM);
+    for (int i = 0; i < DIM; i++)
+    {
+        bond_writer_write_float_value(&writer, floats[i]);
+    }
+    bond_writer_write_list_begin(&writer, 2, BOND_TYPE_DOUBLE, DIM);
+    for (int i = 0; i < DIM; i++)
+    {
+        bond_writer_write_double_value(&writer, doubles[i]);
+    }
+    bond_writer_write_list_begin(&writer, 3, BOND_TYPE_FLOAT, 0);
+    bond_writer_struct_end(&writer);
+    TEST_ASSERT_EQUAL(expected.size, buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, buffer.data, buffer.size);
+    bond_buffer_destroy(&expected);
+
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    bond_reader_struct_begin(&reader);
+    uint16_t field_id;
+    uint8_t type;
+    uint32_t count;
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    // Too small an output array: fails without consuming anything
+    size_t pos = buffer.read_pos;
+    TEST_ASSERT_FALSE(bond_reader_read_float_list(&reader, floats_out, DIM - 1, &count));
+    TEST_ASSERT_EQUAL(DIM, count);
+    TEST_ASSERT_EQUAL(pos, buffer.read_pos);
+    // Wrong element type
+    TEST_ASSERT_FALSE(bond_reader_read_double_list(&reader, doubles_out, DIM, &count));
+    TEST_ASSERT_EQUAL(pos, buffer.read_pos);
+
+    TEST_ASSERT_TRUE(bond_reader_read_float_list(&reader, floats_out, DIM, &count));
+    TEST_ASSERT_EQUAL(DIM, count);
+    TEST_ASSERT_EQUAL_MEMORY(floats, floats_out, sizeof(floats));
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_double_list(&reader, doubles_out, DIM, &count));
+    TEST_ASSERT_EQUAL(DIM, count);
+    TEST_ASSERT_EQUAL_MEMORY(doubles, doubles_out, sizeof(doubles));
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_float_list(&reader, floats_out, 0, &count));
+    TEST_ASSERT_EQUAL(0, count);
+
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_EQUAL(BOND_TYPE_STOP, type);
+
+    // Truncated payload
+    bond_buffer truncated;
+    bond_buffer_init_from(&truncated, buffer.data, 100);
+    bond_reader_init(&reader, &truncated);
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &field_id, &type));
+    TEST_ASSERT_FALSE(bond_reader_read_float_list(&reader, floats_out, DIM, &count));
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_roundtrip_deferred_containers(void)
+{
+    // Nested deferred list<list<uint32>> plus a deferred map, compared with
+    // the same data written with counts up front
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_struct_begin(&writer);
+
+    size_t outer = bond_writer_write_list_begin_deferred(&writer, 1, BOND_TYPE_LIST);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        size_t inner = bond_writer_write_list_value_begin_deferred(&writer, BOND_TYPE_UINT32);
+        for (uint32_t j = 0; j < i % 3; j++)
+        {
+            bond_writer_write_uint32_value(&writer, i * j);
+        }
+        TEST_ASSERT_TRUE(bond_writer_write_list_end(&writer, inner, i % 3));
+    }
+    TEST_ASSERT_TRUE(bond_writer_write_list_end(&writer, outer, 200));
+
+    size_t map = bond_writer_write_map_begin_deferred(&writer, 2, BOND_TYPE_STRING, BOND_TYPE_BOOL);
+    bond_writer_write_string_value(&writer, "a");
+    bond_writer_write_bool_value(&writer, true);
+    TEST_ASSERT_TRUE(bond_writer_write_map_end(&writer, map, 1));
+
+    // Empty list: nothing follows the placeholder
+    size_t empty = bond_writer_write_list_begin_deferred(&writer, 3, BOND_TYPE_DOUBLE);
+    TEST_ASSERT_TRUE(bond_writer_write_list_end(&writer, empty, 0));
+    bond_writer_struct_end(&writer);
+
+    bond_buffer expected;
+    bond_buffer_init(&expected, 64);
+    bond_writer_init(&writer, &expected);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_list_begin(&writer, 1, BOND_TYPE_LIST, 200);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        bond_buffer_write_byte(&expected, BOND_TYPE_UINT32);
+        bond_writer_write_uint32_value(&writer, i % 3);
+        for (uint32_t j = 0; j < i % 3; j++)
+        {
+            bond_writer_write_uint32_value(&writer, i * j);
+        }
+    }
+    bond_writer_write_map_begin(&writer, 2, BOND_TYPE_STRING, BOND_TYPE_BOOL, 1);
+    bond_writer_write_string_value(&writer, "a");
+    bond_writer_write_bool_value(&writer, true);
+    bond_writer_write_list_begin(&writer, 3, BOND_TYPE_DOUBLE, 0);
+    bond_writer_struct_end(&writer);
+
+    TEST_ASSERT_EQUAL(expected.size, buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, buffer.data, buffer.size);
+
+    // A mark past the end of the buffer is rejected
+    bond_writer_init(&writer, &buffer);
+    TEST_ASSERT_FALSE(bond_writer_write_list_end(&writer, buffer.size, 1));
+
+    bond_buffer_destroy(&expected);
+    bond_buffer_destroy(&buffer);
+}
+
 void test_roundtrip_map(void)
 {
     
@@ -514,10 +786,14 @@ int main(void)
     RUN_TEST(test_roundtrip_integers);
     RUN_TEST(test_roundtrip_float_double);
     RUN_TEST(test_roundtrip_string);
+    RUN_TEST(test_roundtrip_wstring);
     
     // Container roundtrips
     RUN_TEST(test_roundtrip_list);
     RUN_TEST(test_roundtrip_map);
+    RUN_TEST(test_roundtrip_blob);
+    RUN_TEST(test_roundtrip_float_double_list);
+    RUN_TEST(test_roundtrip_deferred_containers);
     
     // Skip roundtrips
     RUN_TEST(test_roundtrip_skip_unknown_field);
@@ -0,0 +1,360 @@
+/**
+ * @file test_simple.c
+ * @brief Unit tests for SimpleBinary and schema-driven transcoding
+ */
+
+#include "unity.h"
+#include "bond_simple.h"
+#include "bond_schema.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Test Schema
+// ============================================================================
+//
+// struct Base { 0: uint64 id; }
+// struct Point { 0: int32 x; 1: int32 y; }
+// struct Record : Base {
+//     0: string name; 1: list<int16> samples; 2: map<string, double> scores;
+//     3: Point origin; 5: bool active; 7: wstring label; 8: float ratio;
+// }
+
+static const BondSchemaField base_fields[] = {
+    { 0, "id", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT64) },
+};
+static const BondSchemaStruct base_schema = { "Base", NULL, base_fields, 1 };
+
+static const BondSchemaField point_fields[] = {
+    { 0, "x", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+    { 1, "y", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT32) },
+};
+static const BondSchemaStruct point_schema = { "Point", NULL, point_fields, 2 };
+
+static const BondSchemaType int16_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_INT16);
+static const BondSchemaType string_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_STRING);
+static const BondSchemaType double_type = BOND_SCHEMA_PRIMITIVE(BOND_TYPE_DOUBLE);
+
+static const BondSchemaField record_fields[] = {
+    { 0, "name", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_STRING) },
+    { 1, "samples", BOND_SCHEMA_LIST(&int16_type) },
+    { 2, "scores", BOND_SCHEMA_MAP(&string_type, &double_type) },
+    { 3, "origin", BOND_SCHEMA_STRUCT(&point_schema) },
+    { 5, "active", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_BOOL) },
+    { 7, "label", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_WSTRING) },
+    { 8, "ratio", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_FLOAT) },
+};
+static const BondSchemaStruct record_schema = { "Record", &base_schema, record_fields, 7 };
+
+static const uint16_t label[] = { 'o', 'k' };
+
+// struct Inner { 0: uint32 a; }
+// struct Derived : Inner { 0: uint32 b; }
+// struct Outer { 0: Derived d; 1: uint32 c; }
+
+static const BondSchemaField inner_fields[] = {
+    { 0, "a", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT32) },
+};
+static const BondSchemaStruct inner_schema = { "Inner", NULL, inner_fields, 1 };
+
+static const BondSchemaField derived_fields[] = {
+    { 0, "b", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT32) },
+};
+static const BondSchemaStruct derived_schema = { "Derived", &inner_schema, derived_fields, 1 };
+
+static const BondSchemaField outer_fields[] = {
+    { 0, "d", BOND_SCHEMA_STRUCT(&derived_schema) },
+    { 1, "c", BOND_SCHEMA_PRIMITIVE(BOND_TYPE_UINT32) },
+};
+static const BondSchemaStruct outer_schema = { "Outer", NULL, outer_fields, 2 };
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// CompactBinary input: fields out of order, an unknown field (9), and
+// `ratio` missing
+static void write_compact_input(bond_buffer *buffer)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_write_uint64(&writer, 0, 77);
+    bond_buffer_write_byte(buffer, BOND_TYPE_STOP_BASE);
+
+    bond_writer_write_bool(&writer, 5, true);
+    bond_writer_write_string(&writer, 0, "rec");
+    bond_writer_write_uint32(&writer, 9, 12345);
+    bond_writer_write_field_header(&writer, 3, BOND_TYPE_STRUCT);
+    bond_writer_write_int32(&writer, 1, -2);
+    bond_writer_write_int32(&writer, 0, 1);
+    bond_writer_struct_end(&writer);
+    bond_writer_write_map_begin(&writer, 2, BOND_TYPE_STRING, BOND_TYPE_DOUBLE, 1);
+    bond_writer_write_string_value(&writer, "s");
+    bond_writer_write_double_value(&writer, 0.5);
+    bond_writer_write_list_begin(&writer, 1, BOND_TYPE_INT16, 2);
+    bond_writer_write_int16_value(&writer, -1);
+    bond_writer_write_int16_value(&writer, 300);
+    bond_writer_write_wstring(&writer, 7, label, 2);
+    bond_writer_struct_end(&writer);
+}
+
+// The same record written directly as SimpleBinary
+static void write_simple_expected(bond_buffer *buffer, uint16_t version)
+{
+    bond_simple_writer writer;
+    bond_simple_writer_init(&writer, buffer, version);
+    bond_simple_writer_write_uint64_value(&writer, 77);
+    bond_simple_writer_write_string_value(&writer, "rec", 3);
+    bond_simple_writer_write_container_begin(&writer, 2);
+    bond_simple_writer_write_int16_value(&writer, -1);
+    bond_simple_writer_write_int16_value(&writer, 300);
+    bond_simple_writer_write_container_begin(&writer, 1);
+    bond_simple_writer_write_string_value(&writer, "s", 1);
+    bond_simple_writer_write_double_value(&writer, 0.5);
+    bond_simple_writer_write_int32_value(&writer, 1);
+    bond_simple_writer_write_int32_value(&writer, -2);
+    bond_simple_writer_write_bool_value(&writer, true);
+    bond_simple_writer_write_wstring_value(&writer, label, 2);
+    bond_simple_writer_write_float_value(&writer, 0.0f);
+}
+
+// CompactBinary in canonical schema order, as produced from SimpleBinary
+static void write_compact_expected(bond_buffer *buffer)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_write_uint64(&writer, 0, 77);
+    bond_buffer_write_byte(buffer, BOND_TYPE_STOP_BASE);
+    bond_writer_write_string(&writer, 0, "rec");
+    bond_writer_write_list_begin(&writer, 1, BOND_TYPE_INT16, 2);
+    bond_writer_write_int16_value(&writer, -1);
+    bond_writer_write_int16_value(&writer, 300);
+    bond_writer_write_map_begin(&writer, 2, BOND_TYPE_STRING, BOND_TYPE_DOUBLE, 1);
+    bond_writer_write_string_value(&writer, "s");
+    bond_writer_write_double_value(&writer, 0.5);
+    bond_writer_write_field_header(&writer, 3, BOND_TYPE_STRUCT);
+    bond_writer_write_int32(&writer, 0, 1);
+    bond_writer_write_int32(&writer, 1, -2);
+    bond_writer_struct_end(&writer);
+    bond_writer_write_bool(&writer, 5, true);
+    bond_writer_write_wstring(&writer, 7, label, 2);
+    bond_writer_write_float(&writer, 8, 0.0f);
+    bond_writer_struct_end(&writer);
+}
+
+// ============================================================================
+// Wire Format Tests
+// ============================================================================
+
+void test_simple_length_encoding(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 16);
+    bond_simple_writer writer;
+
+    // v1: uint32 length
+    bond_simple_writer_init(&writer, &buffer, BOND_SIMPLE_VERSION_1);
+    bond_simple_writer_write_string_value(&writer, "ab", 2);
+    const uint8_t v1[] = { 0x02, 0x00, 0x00, 0x00, 'a', 'b' };
+    TEST_ASSERT_EQUAL(sizeof(v1), buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(v1, buffer.data, sizeof(v1));
+
+    // v2: varint length
+    buffer.size = 0;
+    bond_simple_writer_init(&writer, &buffer, BOND_SIMPLE_VERSION_2);
+    bond_simple_writer_write_container_begin(&writer, 300);
+    bond_simple_writer_write_int32_value(&writer, -1);
+    const uint8_t v2[] = { 0xAC, 0x02, 0xFF, 0xFF, 0xFF, 0xFF };
+    TEST_ASSERT_EQUAL(sizeof(v2), buffer.size);
+    TEST_ASSERT_EQUAL_MEMORY(v2, buffer.data, sizeof(v2));
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Transcoding Tests
+// ============================================================================
+
+static void check_transcode(uint16_t version)
+{
+    bond_buffer compact;
+    bond_buffer_init(&compact, 64);
+    write_compact_input(&compact);
+
+    // CompactBinary -> SimpleBinary
+    bond_buffer simple;
+    bond_buffer_init(&simple, 16);
+    bond_simple_writer simple_writer;
+    bond_simple_writer_init(&simple_writer, &simple, version);
+    BondReader reader;
+    bond_reader_init(&reader, &compact);
+    TEST_ASSERT_TRUE(bond_simple_from_compact(&reader, &record_schema, &simple_writer));
+    TEST_ASSERT_EQUAL(compact.size, compact.read_pos);
+
+    bond_buffer expected;
+    bond_buffer_init(&expected, 64);
+    write_simple_expected(&expected, version);
+    TEST_ASSERT_EQUAL(expected.size, simple.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, simple.data, simple.size);
+
+    // Skipping by schema consumes exactly the struct
+    BondSimpleReader simple_reader;
+    bond_simple_reader_init(&simple_reader, &simple, version);
+    BondSchemaType record_type = BOND_SCHEMA_STRUCT(&record_schema);
+    TEST_ASSERT_TRUE(bond_simple_reader_skip(&simple_reader, &record_type));
+    TEST_ASSERT_EQUAL(simple.size, simple.read_pos);
+
+    // SimpleBinary -> CompactBinary
+    bond_buffer_rewind(&simple);
+    bond_buffer roundtrip;
+    bond_buffer_init(&roundtrip, 16);
+    bond_writer writer;
+    bond_writer_init(&writer, &roundtrip);
+    TEST_ASSERT_TRUE(bond_simple_to_compact(&simple_reader, &record_schema, &writer));
+    TEST_ASSERT_EQUAL(simple.size, simple.read_pos);
+
+    expected.size = 0;
+    write_compact_expected(&expected);
+    TEST_ASSERT_EQUAL(expected.size, roundtrip.size);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data, roundtrip.data, roundtrip.size);
+
+    bond_buffer_destroy(&roundtrip);
+    bond_buffer_destroy(&expected);
+    bond_buffer_destroy(&simple);
+    bond_buffer_destroy(&compact);
+}
+
+void test_simple_transcode_v1(void)
+{
+    check_transcode(BOND_SIMPLE_VERSION_1);
+}
+
+void test_simple_transcode_v2(void)
+{
+    check_transcode(BOND_SIMPLE_VERSION_2);
+}
+
+void test_simple_nested_derived_roundtrip(void)
+{
+    // Outer { d: { a: 1 | b: 2 }, c: 3 }
+    static const uint8_t compact_bytes[] = {
+        0x0A, 0x05, 0x01, BOND_TYPE_STOP_BASE, 0x05, 0x02, BOND_TYPE_STOP,
+        0x25, 0x03, BOND_TYPE_STOP
+    };
+
+    bond_buffer simple;
+    bond_buffer_init(&simple, 16);
+    bond_simple_writer simple_writer;
+    bond_simple_writer_init(&simple_writer, &simple, BOND_SIMPLE_VERSION_1);
+    bond_simple_writer_write_uint32_value(&simple_writer, 1);
+    bond_simple_writer_write_uint32_value(&simple_writer, 2);
+    bond_simple_writer_write_uint32_value(&simple_writer, 3);
+
+    // SimpleBinary -> CompactBinary
+    bond_buffer compact;
+    bond_buffer_init(&compact, 16);
+    bond_writer writer;
+    bond_writer_init(&writer, &compact);
+    BondSimpleReader simple_reader;
+    bond_simple_reader_init(&simple_reader, &simple, BOND_SIMPLE_VERSION_1);
+    TEST_ASSERT_TRUE(bond_simple_to_compact(&simple_reader, &outer_schema, &writer));
+    TEST_ASSERT_EQUAL(sizeof(compact_bytes), compact.size);
+    TEST_ASSERT_EQUAL_MEMORY(compact_bytes, compact.data, compact.size);
+
+    // CompactBinary -> SimpleBinary, skipping the nested derived struct
+    bond_buffer back;
+    bond_buffer_init(&back, 16);
+    bond_simple_writer_init(&simple_writer, &back, BOND_SIMPLE_VERSION_1);
+    BondReader reader;
+    bond_reader_init(&reader, &compact);
+    TEST_ASSERT_TRUE(bond_simple_from_compact(&reader, &outer_schema, &simple_writer));
+    TEST_ASSERT_EQUAL(compact.size, compact.read_pos);
+    TEST_ASSERT_EQUAL(simple.size, back.size);
+    TEST_ASSERT_EQUAL_MEMORY(simple.data, back.data, back.size);
+
+    bond_buffer_destroy(&back);
+    bond_buffer_destroy(&compact);
+    bond_buffer_destroy(&simple);
+}
+
+void test_simple_rejects_type_mismatch(void)
+{
+    // `name` encoded as uint32 instead of string
+    bond_buffer compact;
+    bond_buffer_init(&compact, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &compact);
+    bond_buffer_write_byte(&compact, BOND_TYPE_STOP_BASE);
+    bond_writer_write_uint32(&writer, 0, 1);
+    bond_writer_struct_end(&writer);
+
+    bond_buffer simple;
+    bond_buffer_init(&simple, 16);
+    bond_simple_writer simple_writer;
+    bond_simple_writer_init(&simple_writer, &simple, BOND_SIMPLE_VERSION_1);
+    BondReader reader;
+    bond_reader_init(&reader, &compact);
+    TEST_ASSERT_FALSE(bond_simple_from_compact(&reader, &record_schema, &simple_writer));
+    TEST_ASSERT_EQUAL(0, simple.size);
+    TEST_ASSERT_EQUAL(0, compact.read_pos);
+
+    // Missing the STOP_BASE that separates base and derived fields
+    compact.size = 0;
+    bond_writer_write_string(&writer, 0, "x");
+    bond_writer_struct_end(&writer);
+    TEST_ASSERT_FALSE(bond_simple_from_compact(&reader, &record_schema, &simple_writer));
+
+    bond_buffer_destroy(&simple);
+    bond_buffer_destroy(&compact);
+}
+
+void test_simple_rejects_truncation(void)
+{
+    bond_buffer simple;
+    bond_buffer_init(&simple, 64);
+    write_simple_expected(&simple, BOND_SIMPLE_VERSION_2);
+
+    bond_buffer out;
+    bond_buffer_init(&out, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &out);
+    for (size_t len = 0; len < simple.size; len++)
+    {
+        bond_buffer truncated;
+        bond_buffer_init_from(&truncated, simple.data, len);
+        BondSimpleReader reader;
+        bond_simple_reader_init(&reader, &truncated, BOND_SIMPLE_VERSION_2);
+        TEST_ASSERT_FALSE(bond_simple_to_compact(&reader, &record_schema, &writer));
+        TEST_ASSERT_EQUAL(0, out.size);
+    }
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&simple);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Wire format
+    RUN_TEST(test_simple_length_encoding);
+
+    // Transcoding
+    RUN_TEST(test_simple_transcode_v1);
+    RUN_TEST(test_simple_transcode_v2);
+    RUN_TEST(test_simple_nested_derived_roundtrip);
+    RUN_TEST(test_simple_rejects_type_mismatch);
+    RUN_TEST(test_simple_rejects_truncation);
+
+    return UNITY_END();
+}
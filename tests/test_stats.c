@@ -0,0 +1,190 @@
+/**
+ * @file test_stats.c
+ * @brief Unit tests for per-thread statistics (built with BOND_LITE_STATS)
+ */
+
+#include "unity.h"
+#include "bond_stats.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void)
+{
+    bond_stats_reset();
+}
+
+void tearDown(void) {}
+
+// ============================================================================
+// Writer Side
+// ============================================================================
+
+void test_enabled(void)
+{
+    TEST_ASSERT_TRUE(bond_stats_enabled());
+}
+
+void test_bytes_written_and_varints(void)
+{
+    bond_buffer buffer;
+    bond_writer writer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer_init(&writer, &buffer);
+
+    bond_writer_write_uint32(&writer, 0, 5);            // 1-byte varint
+    bond_writer_write_uint32(&writer, 1, 300);          // 2-byte varint
+    bond_writer_write_int64(&writer, 2, -1);            // zigzag 1 -> 1 byte
+    bond_writer_write_string(&writer, 3, "hello");      // length 5
+    bond_writer_write_list_begin(&writer, 4, BOND_TYPE_UINT16, 2);
+    bond_writer_write_uint16_value(&writer, 1);
+    bond_writer_write_uint16_value(&writer, 60000);     // 3-byte varint
+    bond_writer_struct_end(&writer);
+
+    bond_stats stats;
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(buffer.size, stats.bytes_written);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_UINT32][0]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_UINT32][1]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_INT64][0]);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.varint_written[BOND_STATS_VARINT_LENGTH][0]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_UINT16][0]);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_UINT16][2]);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_deferred_count_shrink(void)
+{
+    bond_buffer buffer;
+    bond_writer writer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer_init(&writer, &buffer);
+
+    size_t mark = bond_writer_write_list_begin_deferred(&writer, 0, BOND_TYPE_BOOL);
+    bond_writer_write_bool_value(&writer, true);
+    TEST_ASSERT_TRUE(bond_writer_write_list_end(&writer, mark, 1));
+
+    bond_stats stats;
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(buffer.size, stats.bytes_written);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_written[BOND_STATS_VARINT_LENGTH][0]);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_reserve_reallocs(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 4);
+    uint8_t bytes[16] = {0};
+
+    bond_buffer_write(&buffer, bytes, 4);   // Fits
+    bond_buffer_write(&buffer, bytes, 1);   // 4 -> 8, moves 4
+    bond_buffer_write(&buffer, bytes, 8);   // 8 -> 13, moves 5
+
+    bond_stats stats;
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.reserve_reallocs);
+    TEST_ASSERT_EQUAL_UINT64(9, stats.reserve_bytes_copied);
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Reader Side
+// ============================================================================
+
+void test_read_skip_and_depth(void)
+{
+    bond_buffer buffer;
+    bond_writer writer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_uint64(&writer, 0, 1000);         // 2-byte varint
+    bond_writer_write_field_header(&writer, 1, BOND_TYPE_STRUCT);
+    bond_writer_write_field_header(&writer, 0, BOND_TYPE_STRUCT);
+    bond_writer_write_double(&writer, 0, 1.5);
+    bond_writer_struct_end(&writer);
+    bond_writer_struct_end(&writer);
+    bond_writer_struct_end(&writer);
+    bond_stats_reset();
+
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    uint16_t id;
+    uint8_t type;
+    uint64_t value;
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_TRUE(bond_reader_read_uint64_value(&reader, &value));
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    size_t nested_start = buffer.read_pos;
+    TEST_ASSERT_TRUE(bond_reader_skip(&reader, type));
+    size_t nested_size = buffer.read_pos - nested_start;
+    TEST_ASSERT_TRUE(bond_reader_read_field_header(&reader, &id, &type));
+    TEST_ASSERT_EQUAL_UINT8(BOND_TYPE_STOP, type);
+
+    bond_stats stats;
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(buffer.size, stats.bytes_read);
+    TEST_ASSERT_EQUAL_UINT64(nested_size, stats.bytes_skipped);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.varint_read[BOND_STATS_VARINT_UINT64][1]);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.max_depth);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.depth);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_reset_and_merge(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 8);
+    bond_buffer_write_byte(&buffer, 1);
+
+    bond_stats stats;
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(1, stats.bytes_written);
+    bond_stats_reset();
+    bond_stats_snapshot(&stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.bytes_written);
+
+    bond_stats a;
+    bond_stats b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    a.bytes_read = 10;
+    a.max_depth = 3;
+    a.varint_read[BOND_STATS_VARINT_INT32][4] = 2;
+    b.bytes_read = 5;
+    b.max_depth = 7;
+    b.varint_read[BOND_STATS_VARINT_INT32][4] = 1;
+    bond_stats_merge(&a, &b);
+    TEST_ASSERT_EQUAL_UINT64(15, a.bytes_read);
+    TEST_ASSERT_EQUAL_UINT32(7, a.max_depth);
+    TEST_ASSERT_EQUAL_UINT64(3, a.varint_read[BOND_STATS_VARINT_INT32][4]);
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Writer side
+    RUN_TEST(test_enabled);
+    RUN_TEST(test_bytes_written_and_varints);
+    RUN_TEST(test_deferred_count_shrink);
+    RUN_TEST(test_reserve_reallocs);
+
+    // Reader side
+    RUN_TEST(test_read_skip_and_depth);
+    RUN_TEST(test_reset_and_merge);
+
+    return UNITY_END();
+}
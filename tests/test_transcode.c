@@ -0,0 +1,334 @@
+/**
+ * @file test_transcode.c
+ * @brief Unit tests for CompactBinary v1 <-> v2 re-encoding
+ */
+
+#include "unity.h"
+#include "bond_transcode.h"
+#include "bond_writer.h"
+#include "bond_reader.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Base and derived sections, nested structs in fields and lists, long
+// and short lists, a map and a string long enough for 2-byte lengths
+static void write_sample_v1(bond_buffer *buffer, uint32_t seed)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_write_uint32(&writer, 0, seed);
+    bond_buffer_write_byte(buffer, BOND_TYPE_STOP_BASE);
+
+    bond_writer_write_field_header(&writer, 1, BOND_TYPE_STRUCT);
+    bond_writer_write_int64(&writer, 0, -(int64_t)seed);
+    bond_writer_struct_end(&writer);
+
+    bond_writer_write_list_begin(&writer, 2, BOND_TYPE_STRUCT, 2);
+    bond_writer_write_bool(&writer, 0, true);
+    bond_writer_struct_end(&writer);
+    bond_writer_struct_end(&writer);
+
+    bond_writer_write_list_begin(&writer, 3, BOND_TYPE_UINT16, 9);
+    for (uint16_t i = 0; i < 9; i++)
+    {
+        bond_writer_write_uint16_value(&writer, (uint16_t)(i * 1000));
+    }
+
+    bond_writer_write_set_begin(&writer, 4, BOND_TYPE_DOUBLE, 0);
+
+    bond_writer_write_map_begin(&writer, 5, BOND_TYPE_INT32, BOND_TYPE_LIST, 1);
+    bond_writer_write_int32_value(&writer, 7);
+    bond_buffer_write_byte(buffer, BOND_TYPE_STRING);
+    bond_writer_write_uint32_value(&writer, 1);
+    bond_writer_write_string_value(&writer, "x");
+
+    char text[200];
+    memset(text, 'a' + (char)(seed % 26), sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    bond_writer_write_string(&writer, 300, text);
+    bond_writer_struct_end(&writer);
+}
+
+static void transcode(bond_buffer *in, uint16_t from, uint16_t to, bond_buffer *out)
+{
+    BondReader reader;
+    bond_buffer_rewind(in);
+    bond_reader_init(&reader, in);
+    TEST_ASSERT_TRUE(bond_compact_transcode(&reader, from, to, out));
+    TEST_ASSERT_EQUAL(in->size, in->read_pos);
+}
+
+// ============================================================================
+// One-shot Tests
+// ============================================================================
+
+void test_v1_to_v2_layout(void)
+{
+    // { 0: uint8 5, 1: list<int32> [1, -1], 2: { } }
+    const uint8_t v1[] = {
+        0x03, 0x05,
+        0x2B, BOND_TYPE_INT32, 0x02, 0x02, 0x01,
+        0x4A, 0x00,
+        0x00
+    };
+    const uint8_t v2[] = {
+        0x0A,
+        0x03, 0x05,
+        0x2B, BOND_TYPE_INT32 | (3 << 5), 0x02, 0x01,
+        0x4A, 0x01, 0x00,
+        0x00
+    };
+
+    bond_buffer in;
+    bond_buffer_init_from(&in, v1, sizeof(v1));
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+
+    transcode(&in, BOND_COMPACT_VERSION_1, BOND_COMPACT_VERSION_2, &out);
+    TEST_ASSERT_EQUAL(sizeof(v2), out.size);
+    TEST_ASSERT_EQUAL_MEMORY(v2, out.data, sizeof(v2));
+
+    bond_buffer back;
+    bond_buffer_init(&back, 16);
+    transcode(&out, BOND_COMPACT_VERSION_2, BOND_COMPACT_VERSION_1, &back);
+    TEST_ASSERT_EQUAL(sizeof(v1), back.size);
+    TEST_ASSERT_EQUAL_MEMORY(v1, back.data, sizeof(v1));
+
+    bond_buffer_destroy(&back);
+    bond_buffer_destroy(&out);
+}
+
+void test_round_trip_nested(void)
+{
+    bond_buffer v1;
+    bond_buffer_init(&v1, 256);
+    write_sample_v1(&v1, 3);
+
+    bond_buffer v2;
+    bond_buffer_init(&v2, 16);
+    transcode(&v1, BOND_COMPACT_VERSION_1, BOND_COMPACT_VERSION_2, &v2);
+    // Outer length needs two varint bytes
+    TEST_ASSERT_TRUE(v2.data[0] & 0x80);
+
+    // v2 -> v2 is a canonical copy
+    bond_buffer same;
+    bond_buffer_init(&same, 16);
+    transcode(&v2, BOND_COMPACT_VERSION_2, BOND_COMPACT_VERSION_2, &same);
+    TEST_ASSERT_EQUAL(v2.size, same.size);
+    TEST_ASSERT_EQUAL_MEMORY(v2.data, same.data, v2.size);
+
+    bond_buffer back;
+    bond_buffer_init(&back, 16);
+    transcode(&v2, BOND_COMPACT_VERSION_2, BOND_COMPACT_VERSION_1, &back);
+    TEST_ASSERT_EQUAL(v1.size, back.size);
+    TEST_ASSERT_EQUAL_MEMORY(v1.data, back.data, v1.size);
+
+    bond_buffer_destroy(&back);
+    bond_buffer_destroy(&same);
+    bond_buffer_destroy(&v2);
+    bond_buffer_destroy(&v1);
+}
+
+void test_rejects_bad_input(void)
+{
+    bond_buffer v1;
+    bond_buffer_init(&v1, 256);
+    write_sample_v1(&v1, 1);
+    bond_buffer v2;
+    bond_buffer_init(&v2, 256);
+    transcode(&v1, BOND_COMPACT_VERSION_1, BOND_COMPACT_VERSION_2, &v2);
+
+    bond_buffer out;
+    bond_buffer_init(&out, 16);
+    bond_buffer_write_byte(&out, 0xAA);
+
+    // Every truncation, leaving output and read position alone
+    for (size_t len = 0; len < v2.size; len++)
+    {
+        bond_buffer truncated;
+        bond_buffer_init_from(&truncated, v2.data, len);
+        BondReader reader;
+        bond_reader_init(&reader, &truncated);
+        TEST_ASSERT_FALSE(bond_compact_transcode(&reader, BOND_COMPACT_VERSION_2,
+                                                 BOND_COMPACT_VERSION_1, &out));
+        TEST_ASSERT_EQUAL(0, truncated.read_pos);
+        TEST_ASSERT_EQUAL(1, out.size);
+    }
+
+    // Struct length that does not match its body
+    const uint8_t wrong_length[] = { 0x04, 0x03, 0x05, 0x00, 0x00 };
+    bond_buffer in;
+    bond_buffer_init_from(&in, wrong_length, sizeof(wrong_length));
+    BondReader reader;
+    bond_reader_init(&reader, &in);
+    TEST_ASSERT_FALSE(bond_compact_transcode(&reader, BOND_COMPACT_VERSION_2,
+                                             BOND_COMPACT_VERSION_1, &out));
+
+    // Unknown version
+    bond_reader_init(&reader, &v1);
+    TEST_ASSERT_FALSE(bond_compact_transcode(&reader, BOND_COMPACT_VERSION_1, 3, &out));
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&v2);
+    bond_buffer_destroy(&v1);
+}
+
+// ============================================================================
+// Streaming Tests
+// ============================================================================
+
+void test_stream_any_chunk_size(void)
+{
+    // Ten records back to back
+    bond_buffer stream;
+    bond_buffer_init(&stream, 1024);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        write_sample_v1(&stream, i);
+    }
+
+    // Reference: one-shot conversion of each record
+    bond_buffer expected;
+    bond_buffer_init(&expected, 1024);
+    BondReader reader;
+    bond_reader_init(&reader, &stream);
+    while (bond_buffer_remaining(&stream) > 0)
+    {
+        TEST_ASSERT_TRUE(bond_compact_transcode(&reader, BOND_COMPACT_VERSION_1,
+                                                BOND_COMPACT_VERSION_2, &expected));
+    }
+
+    static const size_t chunk_sizes[] = { 1, 3, 7, 64, 100000 };
+    for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++)
+    {
+        BondCompactTranscoder transcoder;
+        TEST_ASSERT_TRUE(bond_compact_transcoder_init(&transcoder, BOND_COMPACT_VERSION_1,
+                                                      BOND_COMPACT_VERSION_2));
+        bond_buffer out;
+        bond_buffer_init(&out, 64);
+        for (size_t offset = 0; offset < stream.size; offset += chunk_sizes[c])
+        {
+            size_t len = stream.size - offset < chunk_sizes[c] ? stream.size - offset : chunk_sizes[c];
+            TEST_ASSERT_TRUE(bond_compact_transcoder_feed(&transcoder, stream.data + offset,
+                                                          len, &out));
+            // Never holds more than one record
+            TEST_ASSERT_TRUE(transcoder.pending.size < stream.size / 5);
+        }
+        TEST_ASSERT_TRUE(bond_compact_transcoder_finish(&transcoder));
+        TEST_ASSERT_EQUAL(expected.size, out.size);
+        TEST_ASSERT_EQUAL_MEMORY(expected.data, out.data, out.size);
+
+        bond_buffer_destroy(&out);
+        bond_compact_transcoder_destroy(&transcoder);
+    }
+
+    bond_buffer_destroy(&expected);
+    bond_buffer_destroy(&stream);
+}
+
+void test_stream_resumes_scan(void)
+{
+    bond_buffer v1;
+    bond_buffer_init(&v1, 1024);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        write_sample_v1(&v1, i);
+    }
+    bond_buffer v2;
+    bond_buffer_init(&v2, 1024);
+    BondReader reader;
+    bond_reader_init(&reader, &v1);
+    while (bond_buffer_remaining(&v1) > 0)
+    {
+        TEST_ASSERT_TRUE(bond_compact_transcode(&reader, BOND_COMPACT_VERSION_1,
+                                                BOND_COMPACT_VERSION_2, &v2));
+    }
+
+    // Byte by byte in both directions; the scan never falls more than one
+    // header behind the bytes received, so nothing is walked twice
+    bond_buffer *inputs[] = { &v1, &v2 };
+    bond_buffer *outputs[] = { &v2, &v1 };
+    uint16_t versions[] = { BOND_COMPACT_VERSION_1, BOND_COMPACT_VERSION_2 };
+    for (int d = 0; d < 2; d++)
+    {
+        BondCompactTranscoder transcoder;
+        TEST_ASSERT_TRUE(bond_compact_transcoder_init(&transcoder, versions[d], versions[1 - d]));
+        bond_buffer out;
+        bond_buffer_init(&out, 64);
+        for (size_t offset = 0; offset < inputs[d]->size; offset++)
+        {
+            TEST_ASSERT_TRUE(bond_compact_transcoder_feed(&transcoder, inputs[d]->data + offset,
+                                                          1, &out));
+            TEST_ASSERT_TRUE(transcoder.pending.size - transcoder.scanned <= 16);
+        }
+        TEST_ASSERT_TRUE(bond_compact_transcoder_finish(&transcoder));
+        TEST_ASSERT_EQUAL(outputs[d]->size, out.size);
+        TEST_ASSERT_EQUAL_MEMORY(outputs[d]->data, out.data, out.size);
+
+        bond_buffer_destroy(&out);
+        bond_compact_transcoder_destroy(&transcoder);
+    }
+
+    bond_buffer_destroy(&v2);
+    bond_buffer_destroy(&v1);
+}
+
+void test_stream_errors(void)
+{
+    bond_buffer v1;
+    bond_buffer_init(&v1, 256);
+    write_sample_v1(&v1, 0);
+
+    BondCompactTranscoder transcoder;
+    bond_buffer out;
+    bond_buffer_init(&out, 64);
+
+    // Ends half-way through a record
+    TEST_ASSERT_TRUE(bond_compact_transcoder_init(&transcoder, BOND_COMPACT_VERSION_1,
+                                                  BOND_COMPACT_VERSION_2));
+    TEST_ASSERT_TRUE(bond_compact_transcoder_feed(&transcoder, v1.data, v1.size - 1, &out));
+    TEST_ASSERT_EQUAL(0, out.size);
+    TEST_ASSERT_FALSE(bond_compact_transcoder_finish(&transcoder));
+    bond_compact_transcoder_destroy(&transcoder);
+
+    // Malformed record
+    const uint8_t bad[] = { 0x13, 0x00 };
+    TEST_ASSERT_TRUE(bond_compact_transcoder_init(&transcoder, BOND_COMPACT_VERSION_1,
+                                                  BOND_COMPACT_VERSION_2));
+    TEST_ASSERT_FALSE(bond_compact_transcoder_feed(&transcoder, bad, sizeof(bad), &out));
+    bond_compact_transcoder_destroy(&transcoder);
+
+    TEST_ASSERT_FALSE(bond_compact_transcoder_init(&transcoder, 0, BOND_COMPACT_VERSION_2));
+
+    bond_buffer_destroy(&out);
+    bond_buffer_destroy(&v1);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // One-shot
+    RUN_TEST(test_v1_to_v2_layout);
+    RUN_TEST(test_round_trip_nested);
+    RUN_TEST(test_rejects_bad_input);
+
+    // Streaming
+    RUN_TEST(test_stream_any_chunk_size);
+    RUN_TEST(test_stream_resumes_scan);
+    RUN_TEST(test_stream_errors);
+
+    return UNITY_END();
+}
@@ -0,0 +1,254 @@
+/**
+ * @file test_unicode.c
+ * @brief Unit tests for UTF-8 validation, UTF-16 transcoding and the validating reader mode
+ */
+
+#include "unity.h"
+#include "bond_unicode.h"
+#include "bond_reader.h"
+#include "bond_writer.h"
+#include "bond_validate.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Check both the dispatched and scalar paths agree with `expected`
+static void assert_utf8(bool expected, const uint8_t *data, size_t len)
+{
+    TEST_ASSERT_EQUAL(expected, bond_utf8_validate_scalar(data, len));
+    TEST_ASSERT_EQUAL(expected, bond_utf8_validate(data, len));
+}
+
+// Place `seq` at every offset of an ASCII buffer long enough for SIMD paths
+static void assert_at_every_offset(bool expected, const char *seq)
+{
+    size_t seq_len = strlen(seq);
+    uint8_t data[96];
+    for (size_t offset = 0; offset + seq_len <= sizeof(data); offset++)
+    {
+        memset(data, 'a', sizeof(data));
+        memcpy(data + offset, seq, seq_len);
+        assert_utf8(expected, data, sizeof(data));
+        // Also with the sequence at the very end of the input
+        assert_utf8(expected, data, offset + seq_len);
+    }
+}
+
+static uint32_t next_random(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// ============================================================================
+// Validation Tests
+// ============================================================================
+
+void test_utf8_valid_sequences(void)
+{
+    assert_utf8(true, NULL, 0);
+    assert_at_every_offset(true, "hello");
+    assert_at_every_offset(true, "\xC3\xA9");              // U+00E9
+    assert_at_every_offset(true, "\xE2\x82\xAC");          // U+20AC
+    assert_at_every_offset(true, "\xED\x9F\xBF");          // U+D7FF
+    assert_at_every_offset(true, "\xEF\xBF\xBF");          // U+FFFF
+    assert_at_every_offset(true, "\xF0\x9F\x98\x80");      // U+1F600
+    assert_at_every_offset(true, "\xF4\x8F\xBF\xBF");      // U+10FFFF
+}
+
+void test_utf8_invalid_sequences(void)
+{
+    assert_at_every_offset(false, "\x80");                 // Lone continuation
+    assert_at_every_offset(false, "\xC3");                 // Truncated 2-byte
+    assert_at_every_offset(false, "\xE2\x82");             // Truncated 3-byte
+    assert_at_every_offset(false, "\xF0\x9F\x98");         // Truncated 4-byte
+    assert_at_every_offset(false, "\xC0\xAF");             // Overlong 2-byte
+    assert_at_every_offset(false, "\xE0\x80\xAF");         // Overlong 3-byte
+    assert_at_every_offset(false, "\xF0\x80\x80\xAF");     // Overlong 4-byte
+    assert_at_every_offset(false, "\xED\xA0\x80");         // Surrogate U+D800
+    assert_at_every_offset(false, "\xF4\x90\x80\x80");     // U+110000
+    assert_at_every_offset(false, "\xF5\x80\x80\x80");     // Invalid lead
+    assert_at_every_offset(false, "\xFF");
+    assert_at_every_offset(false, "\xC3\xA9\xA9");         // Extra continuation
+}
+
+void test_utf8_random_matches_scalar(void)
+{
+    // Mostly multi-byte sequences with occasional corruption
+    static const char *pieces[] = {
+        "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xD0\x96"
+    };
+    uint32_t state = 0x12345678u;
+    uint8_t data[512];
+
+    for (int round = 0; round < 2000; round++)
+    {
+        size_t len = 0;
+        while (len + 4 <= sizeof(data))
+        {
+            const char *piece = pieces[next_random(&state) % 5];
+            size_t piece_len = strlen(piece);
+            memcpy(data + len, piece, piece_len);
+            len += piece_len;
+        }
+        if (round % 2)
+        {
+            data[next_random(&state) % len] = (uint8_t)next_random(&state);
+        }
+        TEST_ASSERT_EQUAL(bond_utf8_validate_scalar(data, len), bond_utf8_validate(data, len));
+    }
+}
+
+// ============================================================================
+// UTF-16 Transcoding Tests
+// ============================================================================
+
+static void assert_transcode_roundtrip(const char *utf8, size_t expected_units)
+{
+    size_t len = strlen(utf8);
+    uint8_t utf16[1024];
+    uint8_t back[1024];
+    size_t units;
+    size_t written;
+
+    TEST_ASSERT_EQUAL(expected_units, bond_utf8_utf16_length((const uint8_t *)utf8, len));
+    TEST_ASSERT_TRUE(bond_utf8_to_utf16le((const uint8_t *)utf8, len, utf16, sizeof(utf16), &units));
+    TEST_ASSERT_EQUAL(expected_units, units);
+    TEST_ASSERT_TRUE(bond_utf16le_to_utf8(utf16, units, back, sizeof(back), &written));
+    TEST_ASSERT_EQUAL(len, written);
+    TEST_ASSERT_EQUAL_MEMORY(utf8, back, len);
+}
+
+void test_transcode_ascii_runs(void)
+{
+    // Longer than one SIMD block, with a non-ASCII char after the first run
+    assert_transcode_roundtrip("The quick brown fox jumps over the lazy dog", 43);
+    assert_transcode_roundtrip("0123456789abcdefghij\xC3\xA9klmnopqrstuvwxyz0123456789", 47);
+    assert_transcode_roundtrip("", 0);
+}
+
+void test_transcode_multibyte(void)
+{
+    assert_transcode_roundtrip("\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82", 6);
+    assert_transcode_roundtrip("\xE2\x82\xAC\xE6\x97\xA5\xE6\x9C\xAC", 3);
+    assert_transcode_roundtrip("\xF0\x9F\x98\x80 and \xF4\x8F\xBF\xBF", 9);
+}
+
+void test_transcode_rejects_invalid(void)
+{
+    uint8_t out[64];
+    size_t count;
+
+    // Invalid UTF-8
+    TEST_ASSERT_FALSE(bond_utf8_to_utf16le((const uint8_t *)"ab\xED\xA0\x80", 5, out, sizeof(out), &count));
+
+    // Unpaired high and low surrogates
+    const uint8_t lone_high[] = {0x3D, 0xD8, 'a', 0x00};
+    const uint8_t lone_low[] = {0x00, 0xDE};
+    TEST_ASSERT_FALSE(bond_utf16le_to_utf8(lone_high, 2, out, sizeof(out), &count));
+    TEST_ASSERT_FALSE(bond_utf16le_to_utf8(lone_high, 1, out, sizeof(out), &count));
+    TEST_ASSERT_FALSE(bond_utf16le_to_utf8(lone_low, 1, out, sizeof(out), &count));
+}
+
+void test_transcode_capacity(void)
+{
+    const char *text = "abcdefghijklmnopqrstuvwxyz\xE2\x82\xAC";
+    uint8_t utf16[64];
+    uint8_t utf8[64];
+    size_t units;
+    size_t written;
+
+    TEST_ASSERT_FALSE(bond_utf8_to_utf16le((const uint8_t *)text, strlen(text), utf16, 20, &units));
+    TEST_ASSERT_FALSE(bond_utf8_to_utf16le((const uint8_t *)text, strlen(text), utf16, 52, &units));
+    TEST_ASSERT_TRUE(bond_utf8_to_utf16le((const uint8_t *)text, strlen(text), utf16, 54, &units));
+
+    TEST_ASSERT_FALSE(bond_utf16le_to_utf8(utf16, units, utf8, 28, &written));
+    TEST_ASSERT_TRUE(bond_utf16le_to_utf8(utf16, units, utf8, 29, &written));
+    TEST_ASSERT_EQUAL(29, written);
+}
+
+// ============================================================================
+// Reader / Validator Integration Tests
+// ============================================================================
+
+void test_reader_validating_mode(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_write_string_value(&writer, "ok \xC3\xA9");
+    bond_writer_write_string_value(&writer, "bad \xC3");
+
+    BondReader reader;
+    bond_reader_init(&reader, &buffer);
+    const char *str;
+    uint32_t len;
+
+    // Off by default: raw bytes are handed back
+    TEST_ASSERT_TRUE(bond_reader_read_string_value(&reader, &str, &len));
+    TEST_ASSERT_TRUE(bond_reader_read_string_value(&reader, &str, &len));
+
+    bond_buffer_rewind(&buffer);
+    bond_reader_set_flags(&reader, BOND_READER_VALIDATE_UTF8);
+    TEST_ASSERT_TRUE(bond_reader_read_string_value(&reader, &str, &len));
+    TEST_ASSERT_FALSE(bond_reader_read_string_value(&reader, &str, &len));
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_validator_utf8_limit(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 64);
+    bond_writer writer;
+    bond_writer_init(&writer, &buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_map_begin(&writer, 1, BOND_TYPE_STRING, BOND_TYPE_UINT8, 1);
+    bond_writer_write_string_value(&writer, "\xED\xA0\x80");
+    bond_writer_write_uint8_value(&writer, 1);
+    bond_writer_struct_end(&writer);
+
+    BondValidationToken token;
+    BondValidateLimits limits = { 0, false };
+    TEST_ASSERT_TRUE(bond_validate(&buffer, &limits, &token));
+    limits.validate_utf8 = true;
+    TEST_ASSERT_FALSE(bond_validate(&buffer, &limits, &token));
+
+    bond_buffer_destroy(&buffer);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Validation
+    RUN_TEST(test_utf8_valid_sequences);
+    RUN_TEST(test_utf8_invalid_sequences);
+    RUN_TEST(test_utf8_random_matches_scalar);
+
+    // Transcoding
+    RUN_TEST(test_transcode_ascii_runs);
+    RUN_TEST(test_transcode_multibyte);
+    RUN_TEST(test_transcode_rejects_invalid);
+    RUN_TEST(test_transcode_capacity);
+
+    // Integration
+    RUN_TEST(test_reader_validating_mode);
+    RUN_TEST(test_validator_utf8_limit);
+
+    return UNITY_END();
+}
@@ -0,0 +1,281 @@
+/**
+ * @file test_validate.c
+ * @brief Unit tests for the structural validator and unchecked reader
+ */
+
+#include "unity.h"
+#include "bond_validate.h"
+#include "bond_writer.h"
+#include "bond_buffer.h"
+#include "bond_types.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static void write_sample(bond_buffer *buffer)
+{
+    bond_writer writer;
+    bond_writer_init(&writer, buffer);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_uint32(&writer, 1, 300);
+    bond_writer_write_int64(&writer, 100, -9999999999LL);
+    bond_writer_write_string(&writer, 2, "hello");
+    bond_writer_write_double(&writer, 300, 2.5);
+
+    bond_writer_write_field_header(&writer, 3, BOND_TYPE_STRUCT);
+    bond_writer_struct_begin(&writer);
+    bond_writer_write_bool(&writer, 0, true);
+    bond_writer_struct_end(&writer);
+
+    bond_writer_write_list_begin(&writer, 4, BOND_TYPE_FLOAT, 2);
+    bond_writer_write_float_value(&writer, 1.5f);
+    bond_writer_write_float_value(&writer, -0.25f);
+
+    bond_writer_write_map_begin(&writer, 5, BOND_TYPE_STRING, BOND_TYPE_INT32, 1);
+    bond_writer_write_string_value(&writer, "k");
+    bond_writer_write_int32_value(&writer, -7);
+    bond_writer_struct_end(&writer);
+}
+
+static bool validate_bytes(const uint8_t *data, size_t size, uint32_t max_depth)
+{
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, size);
+    BondValidateLimits limits = { max_depth, false };
+    BondValidationToken token;
+    return bond_validate(&buffer, &limits, &token);
+}
+
+// ============================================================================
+// Validation Tests
+// ============================================================================
+
+void test_validate_accepts_writer_output(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_sample(&buffer);
+
+    BondValidationToken token;
+    TEST_ASSERT_TRUE(bond_validate(&buffer, NULL, &token));
+    TEST_ASSERT_TRUE(token.valid);
+    TEST_ASSERT_EQUAL_PTR(buffer.data, token.data);
+    TEST_ASSERT_EQUAL(buffer.size, token.size);
+    TEST_ASSERT_EQUAL(0, buffer.read_pos);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_validate_rejects_every_truncation(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_sample(&buffer);
+
+    for (size_t len = 0; len < buffer.size; len++)
+    {
+        TEST_ASSERT_FALSE(validate_bytes(buffer.data, len, 0));
+    }
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_validate_rejects_unknown_type(void)
+{
+    // Field 0 with type 19 (undefined)
+    uint8_t data[] = {0x13, 0x00, 0x00};
+    TEST_ASSERT_FALSE(validate_bytes(data, sizeof(data), 0));
+}
+
+void test_validate_rejects_unknown_element_type(void)
+{
+    // list<STOP> with one element
+    uint8_t data[] = {0x0B, BOND_TYPE_STOP, 0x01, 0x00, 0x00};
+    TEST_ASSERT_FALSE(validate_bytes(data, sizeof(data), 0));
+}
+
+void test_validate_rejects_overlong_varint(void)
+{
+    // uint16 field with 4 varint bytes
+    uint8_t data[] = {0x04, 0x80, 0x80, 0x80, 0x01, 0x00};
+    TEST_ASSERT_FALSE(validate_bytes(data, sizeof(data), 0));
+}
+
+void test_validate_rejects_count_beyond_remaining(void)
+{
+    // list<double> claiming 2 elements with only 9 bytes left
+    uint8_t data[] = {0x0B, BOND_TYPE_DOUBLE, 0x02,
+                      0, 0, 0, 0, 0, 0, 0, 0, 0x00};
+    TEST_ASSERT_FALSE(validate_bytes(data, sizeof(data), 0));
+
+    // list<string> claiming 2^32-1 elements
+    uint8_t huge[] = {0x0B, BOND_TYPE_STRING, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00};
+    TEST_ASSERT_FALSE(validate_bytes(huge, sizeof(huge), 0));
+}
+
+void test_validate_enforces_max_depth(void)
+{
+    // Three levels of structs: root { 0: { 0: { } } }
+    uint8_t data[] = {0x0A, 0x0A, 0x00, 0x00, 0x00};
+    TEST_ASSERT_TRUE(validate_bytes(data, sizeof(data), 3));
+    TEST_ASSERT_FALSE(validate_bytes(data, sizeof(data), 2));
+}
+
+void test_validate_derived_struct_runs_to_final_stop(void)
+{
+    // Base {0: uint8 1} STOP_BASE, derived {1: uint8 2} STOP
+    uint8_t data[] = {0x03, 0x01, BOND_TYPE_STOP_BASE, 0x23, 0x02, BOND_TYPE_STOP};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondValidationToken token;
+    TEST_ASSERT_TRUE(bond_validate(&buffer, NULL, &token));
+    TEST_ASSERT_EQUAL(sizeof(data), token.size);
+
+    // Truncated right after the base section
+    TEST_ASSERT_FALSE(validate_bytes(data, 3, 0));
+    // Truncated inside the derived section
+    TEST_ASSERT_FALSE(validate_bytes(data, 5, 0));
+}
+
+void test_validate_nested_derived_struct(void)
+{
+    // Outer {0: Derived : Base {0: uint8 1 | 1: uint8 2}, 1: uint32 3}
+    uint8_t data[] = {0x0A, 0x03, 0x01, BOND_TYPE_STOP_BASE, 0x23, 0x02, BOND_TYPE_STOP,
+                      0x25, 0x03, BOND_TYPE_STOP};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondValidationToken token;
+    TEST_ASSERT_TRUE(bond_validate(&buffer, NULL, &token));
+    TEST_ASSERT_EQUAL(sizeof(data), token.size);
+
+    for (size_t len = 0; len < sizeof(data); len++)
+    {
+        TEST_ASSERT_FALSE(validate_bytes(data, len, 0));
+    }
+}
+
+// ============================================================================
+// Unchecked Reader Tests
+// ============================================================================
+
+void test_unchecked_reader_requires_valid_token(void)
+{
+    BondValidationToken token = { NULL, 0, false };
+    BondUncheckedReader reader;
+    TEST_ASSERT_FALSE(bond_unchecked_reader_init(&reader, &token));
+}
+
+void test_unchecked_reader_decodes_values(void)
+{
+    bond_buffer buffer;
+    bond_buffer_init(&buffer, 256);
+    write_sample(&buffer);
+
+    BondValidationToken token;
+    TEST_ASSERT_TRUE(bond_validate(&buffer, NULL, &token));
+    BondUncheckedReader reader;
+    TEST_ASSERT_TRUE(bond_unchecked_reader_init(&reader, &token));
+
+    uint16_t field_id;
+    uint8_t type;
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(1, field_id);
+    TEST_ASSERT_EQUAL(BOND_TYPE_UINT32, type);
+    TEST_ASSERT_EQUAL_UINT32(300, bond_unchecked_read_uint32_value(&reader));
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(100, field_id);
+    TEST_ASSERT_EQUAL_INT64(-9999999999LL, bond_unchecked_read_int64_value(&reader));
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    const char *str;
+    uint32_t len;
+    bond_unchecked_read_string_value(&reader, &str, &len);
+    TEST_ASSERT_EQUAL(5, len);
+    TEST_ASSERT_EQUAL_MEMORY("hello", str, 5);
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(300, field_id);
+    TEST_ASSERT_TRUE(bond_unchecked_read_double_value(&reader) == 2.5);
+
+    // Skip the nested struct
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRUCT, type);
+    bond_unchecked_skip(&reader, type);
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(4, field_id);
+    uint8_t element_type;
+    uint32_t count;
+    bond_unchecked_read_list_begin(&reader, &element_type, &count);
+    TEST_ASSERT_EQUAL(BOND_TYPE_FLOAT, element_type);
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_TRUE(bond_unchecked_read_float_value(&reader) == 1.5f);
+    TEST_ASSERT_TRUE(bond_unchecked_read_float_value(&reader) == -0.25f);
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(BOND_TYPE_MAP, type);
+    bond_unchecked_skip(&reader, type);
+
+    bond_unchecked_read_field_header(&reader, &field_id, &type);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STOP, type);
+    TEST_ASSERT_EQUAL_PTR(reader.end, reader.pos);
+
+    bond_buffer_destroy(&buffer);
+}
+
+void test_unchecked_skip_derived_struct(void)
+{
+    // Outer {0: Derived : Base {0: uint8 1 | 1: uint8 2}, 1: uint32 3}
+    uint8_t data[] = {0x0A, 0x03, 0x01, BOND_TYPE_STOP_BASE, 0x23, 0x02, BOND_TYPE_STOP,
+                      0x25, 0x03, BOND_TYPE_STOP};
+    bond_buffer buffer;
+    bond_buffer_init_from(&buffer, data, sizeof(data));
+    BondValidationToken token;
+    TEST_ASSERT_TRUE(bond_validate(&buffer, NULL, &token));
+
+    BondUncheckedReader reader;
+    TEST_ASSERT_TRUE(bond_unchecked_reader_init(&reader, &token));
+    uint16_t id;
+    uint8_t type;
+    bond_unchecked_read_field_header(&reader, &id, &type);
+    TEST_ASSERT_EQUAL(BOND_TYPE_STRUCT, type);
+    bond_unchecked_skip(&reader, type);
+    bond_unchecked_read_field_header(&reader, &id, &type);
+    TEST_ASSERT_EQUAL(1, id);
+    TEST_ASSERT_EQUAL(BOND_TYPE_UINT32, type);
+    TEST_ASSERT_EQUAL_UINT32(3, bond_unchecked_read_uint32_value(&reader));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    // Validation
+    RUN_TEST(test_validate_accepts_writer_output);
+    RUN_TEST(test_validate_rejects_every_truncation);
+    RUN_TEST(test_validate_rejects_unknown_type);
+    RUN_TEST(test_validate_rejects_unknown_element_type);
+    RUN_TEST(test_validate_rejects_overlong_varint);
+    RUN_TEST(test_validate_rejects_count_beyond_remaining);
+    RUN_TEST(test_validate_enforces_max_depth);
+    RUN_TEST(test_validate_derived_struct_runs_to_final_stop);
+    RUN_TEST(test_validate_nested_derived_struct);
+
+    // Unchecked reader
+    RUN_TEST(test_unchecked_reader_requires_valid_token);
+    RUN_TEST(test_unchecked_reader_decodes_values);
+    RUN_TEST(test_unchecked_skip_derived_struct);
+
+    return UNITY_END();
+}
@@ -448,6 +448,47 @@ void test_write_map_begin(void)
     CLEANUP();
 }
 
+void test_write_blob(void)
+{
+    INIT_WRITER(8);
+
+    // Blob of 300 bytes at field 300 (forces growth past the initial capacity)
+    uint8_t bytes[300];
+    for (int i = 0; i < 300; i++)
+    {
+        bytes[i] = (uint8_t)i;
+    }
+    bond_writer_write_blob(&writer, 300, bytes, sizeof(bytes));
+
+    // Field 300, type LIST: 0xEB 0x2C 0x01
+    // Element type: INT8 (14) = 0x0E
+    // Count: 300 (varint) = 0xAC 0x02
+    TEST_ASSERT_EQUAL(6 + 300, buffer.size);
+    TEST_ASSERT_EQUAL_HEX8(0xEB, buffer.data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x2C, buffer.data[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, buffer.data[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x0E, buffer.data[3]);
+    TEST_ASSERT_EQUAL_HEX8(0xAC, buffer.data[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x02, buffer.data[5]);
+    TEST_ASSERT_EQUAL_MEMORY(bytes, buffer.data + 6, 300);
+
+    CLEANUP();
+}
+
+void test_write_blob_empty(void)
+{
+    INIT_WRITER(8);
+
+    bond_writer_write_blob(&writer, 1, NULL, 0);
+
+    TEST_ASSERT_EQUAL(3, buffer.size);
+    TEST_ASSERT_EQUAL_HEX8(0x2B, buffer.data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x0E, buffer.data[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, buffer.data[2]);
+
+    CLEANUP();
+}
+
 // ============================================================================
 // Raw Value Writer Tests (no field header)
 // ============================================================================
@@ -652,6 +693,8 @@ int main(void)
     RUN_TEST(test_write_list_begin);
     RUN_TEST(test_write_set_begin);
     RUN_TEST(test_write_map_begin);
+    RUN_TEST(test_write_blob);
+    RUN_TEST(test_write_blob_empty);
     
     // Raw value writers
     RUN_TEST(test_write_bool_value);
@@ -0,0 +1,857 @@
+/**
+ * @file bond_anatomy.c
+ * @brief Report where the bytes go in a file of CompactBinary records
+ *
+ * Usage: bond_anatomy [--top=N] [--suggestions=N] FILE...
+ *
+ * Each FILE holds top-level CompactBinary v1 structs back to back (for
+ * example the output of bond_macro_bench --write-corpus). Every value is
+ * attributed to its field id path:
+ *
+ *   3          field 3 of the top-level struct
+ *   2.1        field 1 of the struct in field 2
+ *   4[]        elements of the list or set in field 4
+ *   5{key}     keys of the map in field 5 (5{value} for values)
+ *   1:7        field 7 after the first STOP_BASE (a derived level)
+ *
+ * For each path the report shows occurrences, total bytes (inclusive of
+ * nested paths), field header vs payload bytes, how often the value equals
+ * the implicit default (0, false, empty), and the distribution of varint
+ * lengths (values, or the length prefix of strings and containers). It then
+ * suggests changes ranked by bytes saved: renumbering hot fields into the
+ * 1-byte header range (ids 0-5), dropping default values, and narrower or
+ * cheaper types. Renumbering and type changes break wire compatibility;
+ * the numbers are what the same data would cost after the change.
+ */
+
+#include "bond_lite.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PATH 256
+#define MAX_DEPTH 64
+#define MAX_SUGGESTIONS 4096
+
+// ============================================================================
+// Path Statistics
+// ============================================================================
+
+typedef struct {
+    char path[MAX_PATH];
+    char scope[MAX_PATH];       // Path of the enclosing struct ("" at top level)
+    uint16_t id;
+    uint16_t level;             // Inheritance level within the scope
+    bool is_field;              // False for container elements, keys and values
+    uint8_t type;               // Wire type of the first occurrence
+    bool mixed_types;
+    uint64_t count;
+    uint64_t header_bytes;
+    uint64_t payload_bytes;
+    uint64_t default_count;
+    uint64_t default_bytes;     // Header + payload of default-valued occurrences
+    uint64_t varint_lengths[10];
+
+    // Evidence for type suggestions
+    uint64_t negative_count;    // Signed values below zero
+    uint64_t unsigned_bytes;    // Signed values re-encoded without zigzag
+    uint64_t max_unsigned;
+    int64_t min_signed;
+    int64_t max_signed;
+    uint64_t float_exact;       // Doubles that survive a round trip through float
+    uint64_t integral_count;    // Doubles holding an integer
+    uint64_t integral_bytes;    // ... and their size as int64 varints
+} path_stats;
+
+typedef struct {
+    path_stats *entries;
+    size_t count;
+    size_t capacity;
+    uint32_t *slots;            // Open-addressed index + 1, 0 = empty
+    size_t slot_count;
+} path_table;
+
+static uint64_t hash_path(const char *path)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (; *path; path++)
+    {
+        h = (h ^ (uint8_t)*path) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+static bool table_grow(path_table *t)
+{
+    size_t slot_count = t->slot_count ? t->slot_count * 2 : 256;
+    uint32_t *slots = (uint32_t *)calloc(slot_count, sizeof(uint32_t));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < t->count; i++)
+    {
+        size_t s = (size_t)hash_path(t->entries[i].path) & (slot_count - 1);
+        while (slots[s] != 0)
+        {
+            s = (s + 1) & (slot_count - 1);
+        }
+        slots[s] = (uint32_t)i + 1;
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->slot_count = slot_count;
+    return true;
+}
+
+/**
+ * Find or create the entry for `path`
+ *
+ * @return Entry index, or -1 on allocation failure
+ */
+static long table_lookup(path_table *t, const char *path, const char *scope,
+                         uint16_t id, uint16_t level, bool is_field)
+{
+    if ((t->count + 1) * 2 > t->slot_count && !table_grow(t))
+    {
+        return -1;
+    }
+    size_t s = (size_t)hash_path(path) & (t->slot_count - 1);
+    while (t->slots[s] != 0)
+    {
+        if (strcmp(t->entries[t->slots[s] - 1].path, path) == 0)
+        {
+            return (long)t->slots[s] - 1;
+        }
+        s = (s + 1) & (t->slot_count - 1);
+    }
+
+    if (t->count == t->capacity)
+    {
+        size_t capacity = t->capacity ? t->capacity * 2 : 64;
+        path_stats *grown = (path_stats *)realloc(t->entries, capacity * sizeof(path_stats));
+        if (grown == NULL)
+        {
+            return -1;
+        }
+        t->entries = grown;
+        t->capacity = capacity;
+    }
+    path_stats *e = &t->entries[t->count];
+    memset(e, 0, sizeof(*e));
+    snprintf(e->path, sizeof(e->path), "%s", path);
+    snprintf(e->scope, sizeof(e->scope), "%s", scope);
+    e->id = id;
+    e->level = level;
+    e->is_field = is_field;
+    e->type = BOND_TYPE_UNAVAILABLE;
+    e->min_signed = INT64_MAX;
+    e->max_signed = INT64_MIN;
+    t->slots[s] = (uint32_t)t->count + 1;
+    return (long)t->count++;
+}
+
+// ============================================================================
+// Walking
+// ============================================================================
+
+typedef struct {
+    BondReader reader;
+    path_table table;
+    uint64_t records;
+    uint64_t total_bytes;
+    uint64_t stop_bytes;        // STOP and STOP_BASE markers
+} walker;
+
+static size_t varint64_size(uint64_t value)
+{
+    uint8_t buf[10];
+    return bond_encode_varint64(buf, value);
+}
+
+static size_t pos(const walker *w)
+{
+    return w->reader.buffer->read_pos;
+}
+
+static bool walk_value(walker *w, long index, uint8_t type, size_t header_len, int depth);
+
+static bool walk_struct(walker *w, const char *path, int depth)
+{
+    if (depth > MAX_DEPTH)
+    {
+        return false;
+    }
+    uint16_t level = 0;
+    while (true)
+    {
+        size_t start = pos(w);
+        uint16_t id;
+        uint8_t type;
+        if (!bond_reader_read_field_header(&w->reader, &id, &type))
+        {
+            return false;
+        }
+        if (type == BOND_TYPE_STOP)
+        {
+            w->stop_bytes++;
+            return true;
+        }
+        if (type == BOND_TYPE_STOP_BASE)
+        {
+            w->stop_bytes++;
+            level++;
+            continue;
+        }
+
+        char child[MAX_PATH];
+        if (level > 0)
+        {
+            snprintf(child, sizeof(child), "%s%s%u:%u", path, *path ? "." : "", level, id);
+        }
+        else
+        {
+            snprintf(child, sizeof(child), "%s%s%u", path, *path ? "." : "", id);
+        }
+        long index = table_lookup(&w->table, child, path, id, level, true);
+        if (index < 0 || !walk_value(w, index, type, pos(w) - start, depth))
+        {
+            return false;
+        }
+    }
+}
+
+// Walk `count` elements (or key/value pairs) of a container at `path`
+static bool walk_elements(walker *w, const char *path, uint8_t element_type,
+                          uint8_t value_type, bool is_map, uint32_t count, int depth)
+{
+    char element_path[MAX_PATH];
+    char value_path[MAX_PATH];
+    snprintf(element_path, sizeof(element_path), "%s%s", path, is_map ? "{key}" : "[]");
+    snprintf(value_path, sizeof(value_path), "%s{value}", path);
+    long element = table_lookup(&w->table, element_path, "", 0, 0, false);
+    long value = is_map ? table_lookup(&w->table, value_path, "", 0, 0, false) : 0;
+    if (element < 0 || value < 0)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!walk_value(w, element, element_type, 0, depth + 1) ||
+            (is_map && !walk_value(w, value, value_type, 0, depth + 1)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Walk one value and charge it to entry `index`
+ *
+ * The entry is re-fetched after recursion since nested paths may grow the
+ * table.
+ */
+static bool walk_value(walker *w, long index, uint8_t type, size_t header_len, int depth)
+{
+    size_t start = pos(w);
+    bool is_default = false;
+    size_t varint_len = 0;
+    char path[MAX_PATH];
+    memcpy(path, w->table.entries[index].path, MAX_PATH);
+
+    switch (type)
+    {
+        case BOND_TYPE_BOOL:
+        case BOND_TYPE_UINT8:
+        case BOND_TYPE_INT8:
+        {
+            uint8_t byte;
+            if (!bond_reader_read_uint8_value(&w->reader, &byte))
+            {
+                return false;
+            }
+            is_default = byte == 0;
+            break;
+        }
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_UINT64:
+        {
+            uint64_t v;
+            if (!bond_reader_read_uint64_value(&w->reader, &v))
+            {
+                return false;
+            }
+            path_stats *e = &w->table.entries[index];
+            e->max_unsigned = v > e->max_unsigned ? v : e->max_unsigned;
+            varint_len = pos(w) - start;
+            is_default = v == 0;
+            break;
+        }
+
+        case BOND_TYPE_INT16:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_INT64:
+        {
+            int64_t v;
+            if (!bond_reader_read_int64_value(&w->reader, &v))
+            {
+                return false;
+            }
+            path_stats *e = &w->table.entries[index];
+            e->min_signed = v < e->min_signed ? v : e->min_signed;
+            e->max_signed = v > e->max_signed ? v : e->max_signed;
+            if (v < 0)
+            {
+                e->negative_count++;
+            }
+            else
+            {
+                e->unsigned_bytes += varint64_size((uint64_t)v);
+            }
+            varint_len = pos(w) - start;
+            is_default = v == 0;
+            break;
+        }
+
+        case BOND_TYPE_FLOAT:
+        {
+            float v;
+            if (!bond_reader_read_float_value(&w->reader, &v))
+            {
+                return false;
+            }
+            is_default = v == 0.0f;
+            break;
+        }
+
+        case BOND_TYPE_DOUBLE:
+        {
+            double v;
+            if (!bond_reader_read_double_value(&w->reader, &v))
+            {
+                return false;
+            }
+            path_stats *e = &w->table.entries[index];
+            if ((double)(float)v == v)
+            {
+                e->float_exact++;
+            }
+            if (v == floor(v) && fabs(v) < 9007199254740992.0)
+            {
+                e->integral_count++;
+                e->integral_bytes += varint64_size(bond_zigzag_encode64((int64_t)v));
+            }
+            is_default = v == 0.0;
+            break;
+        }
+
+        case BOND_TYPE_STRING:
+        {
+            const char *str;
+            uint32_t len;
+            if (!bond_reader_read_string_value(&w->reader, &str, &len))
+            {
+                return false;
+            }
+            varint_len = pos(w) - start - len;
+            is_default = len == 0;
+            break;
+        }
+
+        case BOND_TYPE_WSTRING:
+        {
+            const uint8_t *units;
+            uint32_t len;
+            if (!bond_reader_read_wstring_value(&w->reader, &units, &len))
+            {
+                return false;
+            }
+            varint_len = pos(w) - start - (size_t)len * 2;
+            is_default = len == 0;
+            break;
+        }
+
+        case BOND_TYPE_STRUCT:
+            if (!walk_struct(w, path, depth + 1))
+            {
+                return false;
+            }
+            break;
+
+        case BOND_TYPE_LIST:
+        case BOND_TYPE_SET:
+        {
+            uint8_t element_type;
+            uint32_t count;
+            if (!bond_reader_read_list_begin(&w->reader, &element_type, &count))
+            {
+                return false;
+            }
+            varint_len = pos(w) - start - 1;
+            is_default = count == 0;
+            if (!walk_elements(w, path, element_type, 0, false, count, depth))
+            {
+                return false;
+            }
+            break;
+        }
+
+        case BOND_TYPE_MAP:
+        {
+            uint8_t key_type;
+            uint8_t value_type;
+            uint32_t count;
+            if (!bond_reader_read_map_begin(&w->reader, &key_type, &value_type, &count))
+            {
+                return false;
+            }
+            varint_len = pos(w) - start - 2;
+            is_default = count == 0;
+            if (!walk_elements(w, path, key_type, value_type, true, count, depth))
+            {
+                return false;
+            }
+            break;
+        }
+
+        default:
+            return false;
+    }
+
+    path_stats *e = &w->table.entries[index];
+    size_t payload = pos(w) - start;
+    if (e->type == BOND_TYPE_UNAVAILABLE)
+    {
+        e->type = type;
+    }
+    else if (e->type != type)
+    {
+        e->mixed_types = true;
+    }
+    e->count++;
+    e->header_bytes += header_len;
+    e->payload_bytes += payload;
+    if (varint_len > 0 && varint_len <= 10)
+    {
+        e->varint_lengths[varint_len - 1]++;
+    }
+    if (is_default)
+    {
+        e->default_count++;
+        e->default_bytes += header_len + payload;
+    }
+    return true;
+}
+
+static bool walk_file(walker *w, const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "cannot open %s\n", filename);
+        return false;
+    }
+    bond_buffer data;
+    if (bond_buffer_init(&data, 1 << 20) != 0)
+    {
+        fclose(file);
+        return false;
+    }
+    uint8_t chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        if (bond_buffer_write(&data, chunk, n) != 0)
+        {
+            fclose(file);
+            bond_buffer_destroy(&data);
+            return false;
+        }
+    }
+    fclose(file);
+
+    bond_reader_init(&w->reader, &data);
+    bool ok = true;
+    while (bond_buffer_remaining(&data) > 0)
+    {
+        size_t start = data.read_pos;
+        if (!walk_struct(w, "", 0))
+        {
+            fprintf(stderr, "%s: malformed record at offset %zu\n", filename, start);
+            ok = false;
+            break;
+        }
+        w->records++;
+        w->total_bytes += data.read_pos - start;
+    }
+    bond_buffer_destroy(&data);
+    return ok;
+}
+
+// ============================================================================
+// Suggestions
+// ============================================================================
+
+typedef struct {
+    uint64_t savings;
+    char text[320];
+} suggestion;
+
+static suggestion suggestions[MAX_SUGGESTIONS];
+static size_t suggestion_count;
+
+static void suggest(uint64_t savings, const char *format, ...)
+{
+    if (savings == 0 || suggestion_count == MAX_SUGGESTIONS)
+    {
+        return;
+    }
+    suggestion *s = &suggestions[suggestion_count++];
+    s->savings = savings;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(s->text, sizeof(s->text), format, args);
+    va_end(args);
+}
+
+static unsigned header_size(uint16_t id)
+{
+    return id <= 5 ? 1 : (id <= 255 ? 2 : 3);
+}
+
+static int compare_by_count(const void *a, const void *b)
+{
+    const path_stats *x = *(const path_stats *const *)a;
+    const path_stats *y = *(const path_stats *const *)b;
+    return (x->count < y->count) - (x->count > y->count);
+}
+
+/**
+ * Renumbering within one struct level
+ *
+ * The six most frequent fields deserve the 1-byte ids. Each of them that
+ * sits higher is paired with the least frequent field holding a 1-byte id
+ * (or an unused one), and fields with 3-byte ids move below 256.
+ */
+static void suggest_renumbering(path_table *t)
+{
+    path_stats **group = (path_stats **)malloc(t->count * sizeof(path_stats *));
+    bool *done = (bool *)calloc(t->count, sizeof(bool));
+    if (group == NULL || done == NULL)
+    {
+        free(group);
+        free(done);
+        return;
+    }
+
+    for (size_t i = 0; i < t->count; i++)
+    {
+        const path_stats *first = &t->entries[i];
+        if (!first->is_field || done[i])
+        {
+            continue;
+        }
+        size_t n = 0;
+        bool used[6] = {false};
+        for (size_t j = i; j < t->count; j++)
+        {
+            path_stats *e = &t->entries[j];
+            if (e->is_field && !done[j] && e->level == first->level &&
+                strcmp(e->scope, first->scope) == 0)
+            {
+                done[j] = true;
+                group[n++] = e;
+                if (e->id <= 5)
+                {
+                    used[e->id] = true;
+                }
+            }
+        }
+        qsort(group, n, sizeof(path_stats *), compare_by_count);
+
+        size_t victim = n;     // Scans up from the least frequent field
+        for (size_t k = 0; k < n && k < 6; k++)
+        {
+            path_stats *hot = group[k];
+            if (hot->id <= 5)
+            {
+                continue;
+            }
+            uint64_t extra = header_size(hot->id) - 1;
+            unsigned free_id = 6;
+            for (unsigned id = 0; id < 6; id++)
+            {
+                if (!used[id])
+                {
+                    free_id = id;
+                    break;
+                }
+            }
+            if (free_id < 6)
+            {
+                used[free_id] = true;
+                suggest(hot->count * extra, "%s: renumber to unused id %u",
+                        hot->path, free_id);
+                continue;
+            }
+            while (victim > 6 && group[victim - 1]->id > 5)
+            {
+                victim--;
+            }
+            if (victim > 6)
+            {
+                path_stats *cold = group[--victim];
+                suggest((hot->count - cold->count) * extra, "%s: swap ids with %s",
+                        hot->path, cold->path);
+            }
+        }
+
+        // The most frequent 3-byte ids take whatever 2-byte ids are free
+        size_t free_ids = 250;
+        for (size_t k = 0; k < n; k++)
+        {
+            if (group[k]->id > 5 && group[k]->id <= 255)
+            {
+                free_ids--;
+            }
+        }
+        uint64_t savings = 0;
+        size_t moved = 0;
+        const char *hottest = NULL;
+        for (size_t k = 6; k < n && moved < free_ids; k++)
+        {
+            if (group[k]->id > 255)
+            {
+                savings += group[k]->count;
+                hottest = hottest != NULL ? hottest : group[k]->path;
+                moved++;
+            }
+        }
+        suggest(savings, "%s: renumber %zu field(s) with ids above 255 into free ids below 256, "
+                "starting with %s", *first->scope ? first->scope : "(top level)", moved, hottest);
+    }
+    free(group);
+    free(done);
+}
+
+static void suggest_types(const path_stats *e)
+{
+    if (e->mixed_types || e->count == 0)
+    {
+        return;
+    }
+    switch (e->type)
+    {
+        case BOND_TYPE_INT16:
+        case BOND_TYPE_INT32:
+        case BOND_TYPE_INT64:
+            if (e->min_signed >= -128 && e->max_signed <= 127 && e->payload_bytes > e->count)
+            {
+                suggest(e->payload_bytes - e->count, "%s: int8 holds every value (%lld..%lld)",
+                        e->path, (long long)e->min_signed, (long long)e->max_signed);
+            }
+            else if (e->negative_count == 0 && e->payload_bytes > e->unsigned_bytes)
+            {
+                suggest(e->payload_bytes - e->unsigned_bytes,
+                        "%s: never negative, an unsigned type avoids zigzag", e->path);
+            }
+            break;
+
+        case BOND_TYPE_UINT16:
+        case BOND_TYPE_UINT32:
+        case BOND_TYPE_UINT64:
+            if (e->max_unsigned <= 255 && e->payload_bytes > e->count)
+            {
+                suggest(e->payload_bytes - e->count, "%s: uint8 holds every value (max %llu)",
+                        e->path, (unsigned long long)e->max_unsigned);
+            }
+            break;
+
+        case BOND_TYPE_DOUBLE:
+            if (e->integral_count == e->count && e->payload_bytes > e->integral_bytes &&
+                e->payload_bytes - e->integral_bytes > e->count * 4)
+            {
+                suggest(e->payload_bytes - e->integral_bytes,
+                        "%s: every double is an integer, int64 is smaller", e->path);
+            }
+            else if (e->float_exact == e->count)
+            {
+                suggest(e->count * 4, "%s: every double is exact as float", e->path);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static int compare_suggestions(const void *a, const void *b)
+{
+    const suggestion *x = (const suggestion *)a;
+    const suggestion *y = (const suggestion *)b;
+    return (x->savings < y->savings) - (x->savings > y->savings);
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+static const char *type_name(uint8_t type)
+{
+    static const char *names[] = {
+        "stop", "stop_base", "bool", "uint8", "uint16", "uint32", "uint64", "float",
+        "double", "string", "struct", "list", "set", "map", "int8", "int16", "int32",
+        "int64", "wstring"
+    };
+    return type < sizeof(names) / sizeof(names[0]) ? names[type] : "?";
+}
+
+static int compare_by_bytes(const void *a, const void *b)
+{
+    const path_stats *x = *(const path_stats *const *)a;
+    const path_stats *y = *(const path_stats *const *)b;
+    uint64_t bx = x->header_bytes + x->payload_bytes;
+    uint64_t by = y->header_bytes + y->payload_bytes;
+    return (bx < by) - (bx > by);
+}
+
+static void print_report(walker *w, size_t top, size_t max_suggestions)
+{
+    path_table *t = &w->table;
+    uint64_t header_total = 0;
+    for (size_t i = 0; i < t->count; i++)
+    {
+        header_total += t->entries[i].header_bytes;
+    }
+    double total = w->total_bytes ? (double)w->total_bytes : 1;
+    printf("records: %llu  bytes: %llu  avg: %.1f bytes/record\n",
+           (unsigned long long)w->records, (unsigned long long)w->total_bytes,
+           w->records ? (double)w->total_bytes / (double)w->records : 0);
+    printf("field headers: %llu bytes (%.1f%%)  stop markers: %llu bytes (%.1f%%)\n\n",
+           (unsigned long long)header_total, 100.0 * (double)header_total / total,
+           (unsigned long long)w->stop_bytes, 100.0 * (double)w->stop_bytes / total);
+
+    path_stats **sorted = (path_stats **)malloc(t->count * sizeof(path_stats *));
+    if (sorted == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < t->count; i++)
+    {
+        sorted[i] = &t->entries[i];
+    }
+    qsort(sorted, t->count, sizeof(path_stats *), compare_by_bytes);
+
+    printf("%-24s %-8s %10s %12s %6s %10s %12s %8s  %s\n", "path", "type", "count", "bytes",
+           "%", "header", "payload", "default", "varint lengths");
+    for (size_t i = 0; i < t->count && i < top; i++)
+    {
+        const path_stats *e = sorted[i];
+        uint64_t bytes = e->header_bytes + e->payload_bytes;
+        printf("%-24s %-8s %10llu %12llu %5.1f%% %10llu %12llu %7.1f%% ",
+               e->path, e->mixed_types ? "mixed" : type_name(e->type),
+               (unsigned long long)e->count, (unsigned long long)bytes,
+               100.0 * (double)bytes / total, (unsigned long long)e->header_bytes,
+               (unsigned long long)e->payload_bytes,
+               e->count ? 100.0 * (double)e->default_count / (double)e->count : 0);
+        uint64_t varints = 0;
+        for (int len = 0; len < 10; len++)
+        {
+            varints += e->varint_lengths[len];
+        }
+        for (int len = 0; len < 10 && varints > 0; len++)
+        {
+            if (e->varint_lengths[len] > 0)
+            {
+                printf(" %d:%.0f%%", len + 1, 100.0 * (double)e->varint_lengths[len] / (double)varints);
+            }
+        }
+        printf("\n");
+    }
+    if (t->count > top)
+    {
+        printf("... %zu more paths (--top=N)\n", t->count - top);
+    }
+    free(sorted);
+
+    suggest_renumbering(t);
+    for (size_t i = 0; i < t->count; i++)
+    {
+        const path_stats *e = &t->entries[i];
+        suggest_types(e);
+        if (e->is_field && e->default_bytes > 0)
+        {
+            suggest(e->default_bytes, "%s: %llu%% of values are the default; omit them",
+                    e->path, (unsigned long long)(100 * e->default_count / e->count));
+        }
+    }
+    qsort(suggestions, suggestion_count, sizeof(suggestion), compare_suggestions);
+
+    printf("\nsuggestions (bytes saved over this input):\n");
+    if (suggestion_count == 0)
+    {
+        printf("  none\n");
+    }
+    for (size_t i = 0; i < suggestion_count && i < max_suggestions; i++)
+    {
+        printf("  %12llu (%5.1f%%)  %s\n", (unsigned long long)suggestions[i].savings,
+               100.0 * (double)suggestions[i].savings / total, suggestions[i].text);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char **argv)
+{
+    size_t top = 40;
+    size_t max_suggestions = 20;
+    walker w;
+    memset(&w, 0, sizeof(w));
+
+    int files = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--top=", 6) == 0)
+        {
+            top = (size_t)strtoul(argv[i] + 6, NULL, 10);
+        }
+        else if (strncmp(argv[i], "--suggestions=", 14) == 0)
+        {
+            max_suggestions = (size_t)strtoul(argv[i] + 14, NULL, 10);
+        }
+        else if (argv[i][0] == '-')
+        {
+            files = -1;
+            break;
+        }
+        else
+        {
+            files++;
+        }
+    }
+    if (files <= 0)
+    {
+        fprintf(stderr, "usage: %s [--top=N] [--suggestions=N] FILE...\n", argv[0]);
+        return 2;
+    }
+
+    bool ok = true;
+    for (int i = 1; i < argc; i++)
+    {
+        if (argv[i][0] != '-')
+        {
+            ok = walk_file(&w, argv[i]) && ok;
+        }
+    }
+    print_report(&w, top, max_suggestions);
+    free(w.table.entries);
+    free(w.table.slots);
+    return ok ? 0 : 1;
+}